@@ -0,0 +1,235 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/decode_ahead.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+#include "common/timer.h"
+
+namespace Audio {
+
+// How often the samples are decoded ahead, in microseconds
+static const int32 kDecodeAheadInterval = 10 * 1000;
+
+// How many samples are decoded at most per timer tick. This is a few MP3
+// frames, and still twice what a 44.1 kHz stereo stream plays in between.
+static const uint kDecodeAheadChunkSize = 2048;
+
+Common::Array<DecodeAheadAudioStream *> *DecodeAheadAudioStream::_activeStreams = 0;
+Common::Mutex *DecodeAheadAudioStream::_activeStreamsMutex = 0;
+Common::Mutex *DecodeAheadAudioStream::_timerMutex = 0;
+
+DecodeAheadAudioStream::DecodeAheadAudioStream(AudioStream *stream, uint bufferSize, DisposeAfterUse::Flag disposeAfterUse) :
+		_stream(stream), _disposeAfterUse(disposeAfterUse) {
+	assert(_stream);
+	assert(bufferSize >= 2);
+
+	_stereo = _stream->isStereo();
+	_rate = _stream->getRate();
+
+	// Stereo samples come in pairs, which must not be split by the wrap
+	// around of the ring buffer
+	_bufferSize = bufferSize & ~1;
+	_buffer = new int16[_bufferSize];
+	_readPos = 0;
+	_fillCount = 0;
+
+	_streamEndOfData = _stream->endOfData();
+	_streamEndOfStream = _stream->endOfStream();
+	_lateSamples = 0;
+
+	startDecodingAhead();
+}
+
+DecodeAheadAudioStream::~DecodeAheadAudioStream() {
+	stopDecodingAhead();
+
+	if (_lateSamples)
+		debug(2, "DecodeAheadAudioStream: %d samples late", _lateSamples);
+
+	delete[] _buffer;
+
+	if (_disposeAfterUse == DisposeAfterUse::YES)
+		delete _stream;
+}
+
+int DecodeAheadAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = takeSamples(buffer, numSamples);
+	if (samples == numSamples)
+		return samples;
+
+	// The ring buffer ran empty. Take what got decoded in the meantime,
+	// and decode the rest right away.
+	Common::StackLock lock(_streamMutex);
+
+	samples += takeSamples(buffer + samples, numSamples - samples);
+	if (samples < numSamples) {
+		int decoded = _stream->readBuffer(buffer + samples, numSamples - samples);
+		if (decoded > 0) {
+			samples += decoded;
+			_lateSamples += decoded;
+		}
+
+		Common::StackLock bufferLock(_bufferMutex);
+		_streamEndOfData = _stream->endOfData();
+		_streamEndOfStream = _stream->endOfStream();
+	}
+
+	return samples;
+}
+
+bool DecodeAheadAudioStream::endOfData() const {
+	Common::StackLock lock(_bufferMutex);
+	return _fillCount == 0 && _streamEndOfData;
+}
+
+bool DecodeAheadAudioStream::endOfStream() const {
+	Common::StackLock lock(_bufferMutex);
+	return _fillCount == 0 && _streamEndOfStream;
+}
+
+int DecodeAheadAudioStream::takeSamples(int16 *buffer, int numSamples) {
+	Common::StackLock lock(_bufferMutex);
+
+	int samples = 0;
+	while (samples < numSamples && _fillCount) {
+		uint count = MIN<uint>(MIN<uint>(numSamples - samples, _fillCount), _bufferSize - _readPos);
+		memcpy(buffer + samples, _buffer + _readPos, count * sizeof(int16));
+
+		samples += count;
+		_readPos = (_readPos + count) % _bufferSize;
+		_fillCount -= count;
+	}
+
+	return samples;
+}
+
+void DecodeAheadAudioStream::decodeSamples() {
+	uint writePos, count;
+
+	{
+		Common::StackLock lock(_bufferMutex);
+
+		if (_streamEndOfStream || _fillCount == _bufferSize)
+			return;
+
+		writePos = (_readPos + _fillCount) % _bufferSize;
+		count = MIN<uint>(_bufferSize - _fillCount, _bufferSize - writePos);
+		count = MIN<uint>(count, kDecodeAheadChunkSize);
+	}
+
+	// The free part of the ring buffer isn't read, so it can be filled
+	// without holding the buffer lock
+	int decoded = _stream->readBuffer(_buffer + writePos, count);
+
+	Common::StackLock lock(_bufferMutex);
+	if (decoded > 0)
+		_fillCount += decoded;
+	_streamEndOfData = _stream->endOfData();
+	_streamEndOfStream = _stream->endOfStream();
+}
+
+void DecodeAheadAudioStream::startDecodingAhead() {
+	// Streams are created on the main thread, and the first one is created
+	// before any can be deleted
+	if (!_timerMutex)
+		_timerMutex = new Common::Mutex();
+
+	Common::StackLock timerLock(*_timerMutex);
+
+	const bool first = !_activeStreams;
+	if (first) {
+		_activeStreams = new Common::Array<DecodeAheadAudioStream *>();
+		_activeStreamsMutex = new Common::Mutex();
+	}
+
+	{
+		Common::StackLock lock(*_activeStreamsMutex);
+		_activeStreams->push_back(this);
+	}
+
+	if (first)
+		g_system->getTimerManager()->installTimerProc(&timerProc, kDecodeAheadInterval, 0, "audioDecodeAhead");
+}
+
+void DecodeAheadAudioStream::stopDecodingAhead() {
+	// Streams are usually deleted by the mixer, on its own thread, while the
+	// main thread may be creating another one
+	Common::StackLock timerLock(*_timerMutex);
+
+	bool last = false;
+	{
+		// The callback holds the lock while decoding, so the stream isn't
+		// used anymore once it is removed from the list
+		Common::StackLock lock(*_activeStreamsMutex);
+
+		for (uint i = 0; i < _activeStreams->size(); i++) {
+			if ((*_activeStreams)[i] == this) {
+				_activeStreams->remove_at(i);
+				last = _activeStreams->empty();
+				break;
+			}
+		}
+	}
+
+	// Removing the timer proc waits for a running callback to finish, and
+	// must not happen with the list locked, as the callback locks it too
+	if (last) {
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+
+		delete _activeStreams;
+		_activeStreams = 0;
+		delete _activeStreamsMutex;
+		_activeStreamsMutex = 0;
+	}
+}
+
+void DecodeAheadAudioStream::timerProc(void *refCon) {
+	Common::StackLock lock(*_activeStreamsMutex);
+
+	// Decode a single chunk per tick, for the stream with the fewest
+	// samples ready, so that the time spent in the shared timer stays
+	// bounded however many streams are playing
+	DecodeAheadAudioStream *next = 0;
+	uint nextFillCount = 0;
+
+	for (uint i = 0; i < _activeStreams->size(); i++) {
+		DecodeAheadAudioStream *stream = (*_activeStreams)[i];
+		Common::StackLock bufferLock(stream->_bufferMutex);
+
+		if (stream->_streamEndOfStream || stream->_fillCount == stream->_bufferSize)
+			continue;
+
+		if (!next || stream->_fillCount < nextFillCount) {
+			next = stream;
+			nextFillCount = stream->_fillCount;
+		}
+	}
+
+	if (next) {
+		Common::StackLock streamLock(next->_streamMutex);
+		next->decodeSamples();
+	}
+}
+
+} // End of namespace Audio
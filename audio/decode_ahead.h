@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_DECODE_AHEAD_H
+#define AUDIO_DECODE_AHEAD_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/types.h"
+
+#include "audio/audiostream.h"
+
+namespace Audio {
+
+/**
+ * A wrapper around another AudioStream, which decodes samples ahead of
+ * time into a ring buffer.
+ *
+ * The samples are decoded from a timer callback, so expensive decoders
+ * like MP3 or Vorbis no longer run inside the mixer callback. When the
+ * ring buffer runs empty, the missing samples are decoded right away,
+ * which counts as late samples.
+ *
+ * Once handed to the wrapper, the wrapped stream must not be used
+ * directly anymore.
+ */
+class DecodeAheadAudioStream : public AudioStream {
+public:
+	/**
+	 * @param bufferSize  the size of the ring buffer, in samples
+	 */
+	DecodeAheadAudioStream(AudioStream *stream, uint bufferSize = 32768, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+	~DecodeAheadAudioStream();
+
+	// AudioStream API
+	int readBuffer(int16 *buffer, const int numSamples);
+	bool isStereo() const { return _stereo; }
+	int getRate() const { return _rate; }
+	bool endOfData() const;
+	bool endOfStream() const;
+
+	/** Return the number of samples which weren't decoded ahead in time. */
+	uint32 getLateSamples() const { return _lateSamples; }
+
+private:
+	AudioStream *_stream;
+	DisposeAfterUse::Flag _disposeAfterUse;
+	bool _stereo;
+	int _rate;
+
+	/** The ring buffer. _fillCount samples starting at _readPos are ready. */
+	int16 *_buffer;
+	uint _bufferSize;
+	uint _readPos;
+	uint _fillCount;
+
+	bool _streamEndOfData;   ///< Was the wrapped stream out of data, when it was read last?
+	bool _streamEndOfStream; ///< Has the wrapped stream ended?
+
+	uint32 _lateSamples;
+
+	// Lock _streamMutex before _bufferMutex when both are needed
+	Common::Mutex _streamMutex; ///< Guards _stream.
+	mutable Common::Mutex _bufferMutex; ///< Guards the ring buffer.
+
+	/** Take ready samples from the ring buffer. */
+	int takeSamples(int16 *buffer, int numSamples);
+
+	/** Decode samples into the ring buffer. Needs _streamMutex to be locked. */
+	void decodeSamples();
+
+	void startDecodingAhead();
+	void stopDecodingAhead();
+
+	/**
+	 * The streams being played, which all share one timer. The list and
+	 * its mutex only exist while the timer is installed.
+	 */
+	static Common::Array<DecodeAheadAudioStream *> *_activeStreams;
+	static Common::Mutex *_activeStreamsMutex;
+
+	/**
+	 * Guards installing and removing the timer. It is kept once created,
+	 * as streams are created and deleted on different threads.
+	 */
+	static Common::Mutex *_timerMutex;
+	static void timerProc(void *refCon);
+};
+
+} // End of namespace Audio
+
+#endif
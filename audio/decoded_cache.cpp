@@ -0,0 +1,172 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/decoded_cache.h"
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+
+#include "common/debug.h"
+#include "common/textconsole.h"
+
+namespace Audio {
+
+// How many samples are decoded at once when adding a sound
+static const int kDecodeChunkSize = 4096;
+
+DecodedSoundCache::DecodedSoundCache(uint32 maxSize, uint32 maxSoundSize) :
+		_size(0), _maxSize(maxSize), _maxSoundSize(MIN(maxSoundSize, maxSize)), _useCounter(0), _hits(0), _misses(0) {
+}
+
+DecodedSoundCache::~DecodedSoundCache() {
+	clear();
+}
+
+Common::String DecodedSoundCache::makeKey(const Common::String &archive, uint32 offset, uint32 length) {
+	return Common::String::format("%s:%u:%u", archive.c_str(), offset, length);
+}
+
+SeekableAudioStream *DecodedSoundCache::makeStream(const Sound &sound) {
+	byte *buffer = (byte *)malloc(sound.size);
+	if (!buffer)
+		return 0;
+
+	memcpy(buffer, sound.samples, sound.size);
+
+	byte flags = FLAG_16BITS;
+	if (sound.stereo)
+		flags |= FLAG_STEREO;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= FLAG_LITTLE_ENDIAN;
+#endif
+
+	return makeRawStream(buffer, sound.size, sound.rate, flags, DisposeAfterUse::YES);
+}
+
+SeekableAudioStream *DecodedSoundCache::getStream(const Common::String &archive, uint32 offset, uint32 length) {
+	Common::StackLock lock(_mutex);
+
+	SoundMap::iterator iter = _sounds.find(makeKey(archive, offset, length));
+	if (iter == _sounds.end()) {
+		_misses++;
+		return 0;
+	}
+
+	_hits++;
+	iter->_value.lastUse = ++_useCounter;
+	return makeStream(iter->_value);
+}
+
+SeekableAudioStream *DecodedSoundCache::addStream(const Common::String &archive, uint32 offset, uint32 length, SeekableAudioStream *stream) {
+	if (!stream)
+		return 0;
+
+	const uint32 maxSamples = _maxSoundSize / 4 * 2;
+
+	// Don't start decoding sounds which are known to be too long
+	const Timestamp duration = stream->getLength().convertToFramerate(stream->getRate());
+	if ((uint32)duration.totalNumberOfFrames() * (stream->isStereo() ? 2 : 1) > maxSamples) {
+		debug(5, "DecodedSoundCache: Not caching sound at %u in '%s'", offset, archive.c_str());
+		return stream;
+	}
+
+	// Decode the whole sound, unless it turns out to be too long anyway
+	int16 *samples = 0;
+	uint32 sampleCount = 0;
+	uint32 capacity = 0;
+
+	while (!stream->endOfData()) {
+		if (sampleCount + kDecodeChunkSize > capacity) {
+			if (capacity >= maxSamples)
+				break;
+
+			capacity = MIN<uint32>(MAX<uint32>(capacity * 2, kDecodeChunkSize), maxSamples);
+			int16 *newSamples = (int16 *)realloc(samples, capacity * 2);
+			if (!newSamples)
+				break;
+			samples = newSamples;
+		}
+
+		int count = stream->readBuffer(samples + sampleCount, MIN<uint32>(kDecodeChunkSize, capacity - sampleCount));
+		if (count <= 0)
+			break;
+		sampleCount += count;
+	}
+
+	if (!stream->endOfData() || !sampleCount) {
+		debug(5, "DecodedSoundCache: Not caching sound at %u in '%s'", offset, archive.c_str());
+		free(samples);
+		stream->rewind();
+		return stream;
+	}
+
+	Sound sound;
+	sound.samples = samples;
+	sound.size = sampleCount * 2;
+	sound.rate = stream->getRate();
+	sound.stereo = stream->isStereo();
+	delete stream;
+
+	Common::StackLock lock(_mutex);
+
+	const Common::String key = makeKey(archive, offset, length);
+	SoundMap::iterator iter = _sounds.find(key);
+	if (iter != _sounds.end()) {
+		// Someone else added the sound in the meantime
+		_size -= iter->_value.size;
+		free(iter->_value.samples);
+		_sounds.erase(iter);
+	}
+
+	makeRoom(sound.size);
+
+	sound.lastUse = ++_useCounter;
+	_sounds[key] = sound;
+	_size += sound.size;
+
+	return makeStream(sound);
+}
+
+void DecodedSoundCache::makeRoom(uint32 size) {
+	while (_size + size > _maxSize && !_sounds.empty()) {
+		SoundMap::iterator oldest = _sounds.begin();
+		for (SoundMap::iterator iter = _sounds.begin(); iter != _sounds.end(); ++iter) {
+			if ((int32)(iter->_value.lastUse - oldest->_value.lastUse) < 0)
+				oldest = iter;
+		}
+
+		_size -= oldest->_value.size;
+		free(oldest->_value.samples);
+		_sounds.erase(oldest);
+	}
+}
+
+void DecodedSoundCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (SoundMap::iterator iter = _sounds.begin(); iter != _sounds.end(); ++iter)
+		free(iter->_value.samples);
+
+	_sounds.clear();
+	_size = 0;
+}
+
+} // End of namespace Audio
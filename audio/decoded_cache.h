@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_DECODED_CACHE_H
+#define AUDIO_DECODED_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/str.h"
+#include "common/types.h"
+
+namespace Audio {
+
+class SeekableAudioStream;
+
+/**
+ * Keeps the decoded samples of compressed sounds, so that sounds played
+ * over and over, like footsteps or clicks, are only decoded once. The
+ * sounds are identified by the archive they are stored in, and their
+ * offset and length in it. The least recently played sounds are dropped
+ * when the cache is full.
+ *
+ * Sound players opt in by asking the cache first:
+ *
+ * @code
+ * Audio::SeekableAudioStream *stream = _soundCache->getStream(archive, offset, length);
+ * if (!stream)
+ *     stream = _soundCache->addStream(archive, offset, length, Audio::makeVorbisStream(...));
+ * @endcode
+ *
+ * Every stream returned plays from its own copy of the samples, so the
+ * streams are independent of the cache and may outlive it.
+ */
+class DecodedSoundCache {
+public:
+	/**
+	 * @param maxSize       the memory used for all samples, in bytes
+	 * @param maxSoundSize  the memory used for the samples of one sound,
+	 *                      longer sounds aren't cached
+	 */
+	DecodedSoundCache(uint32 maxSize = 8 * 1024 * 1024, uint32 maxSoundSize = 1024 * 1024);
+	~DecodedSoundCache();
+
+	/**
+	 * Return a stream playing the cached samples of a sound, or 0 when
+	 * the sound isn't cached.
+	 */
+	SeekableAudioStream *getStream(const Common::String &archive, uint32 offset, uint32 length);
+
+	/**
+	 * Decode a sound and store its samples. Returns a stream playing the
+	 * samples, the stream passed gets deleted then. When the sound is too
+	 * long to be cached, the stream passed is returned. It is only decoded
+	 * and rewound first when its length isn't known in advance.
+	 */
+	SeekableAudioStream *addStream(const Common::String &archive, uint32 offset, uint32 length, SeekableAudioStream *stream);
+
+	/** Drop all cached sounds. */
+	void clear();
+
+	uint32 getSize() const { return _size; }
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+
+private:
+	struct Sound {
+		int16 *samples;
+		uint32 size;        ///< The size of the samples, in bytes.
+		int rate;
+		bool stereo;
+		uint32 lastUse;     ///< The value of _useCounter when the sound was played last.
+	};
+
+	typedef Common::HashMap<Common::String, Sound> SoundMap;
+
+	static Common::String makeKey(const Common::String &archive, uint32 offset, uint32 length);
+	static SeekableAudioStream *makeStream(const Sound &sound);
+
+	/** Drop the least recently played sounds until there's room for the given size. */
+	void makeRoom(uint32 size);
+
+	SoundMap _sounds;
+	uint32 _size;
+	uint32 _maxSize;
+	uint32 _maxSoundSize;
+	uint32 _useCounter;
+
+	uint32 _hits;
+	uint32 _misses;
+
+	Common::Mutex _mutex;
+};
+
+} // End of namespace Audio
+
+#endif
@@ -107,6 +107,17 @@ public:
 		send(status | ((uint32)firstOp << 8) | ((uint32)secondOp << 16));
 	}
 
+	/**
+	 * Output a packed midi command, which is due the given number of
+	 * microseconds after the start of the current timer callback. This
+	 * allows placing commands between the timer callbacks. Commands sent
+	 * this way are played in the order they are sent, also when a later
+	 * one is due earlier.
+	 *
+	 * Drivers, which can't delay commands, send them right away.
+	 */
+	virtual void sendDelayed(uint32 b, uint32 delay) { send(b); }
+
 	/**
 	 * Transmit a sysEx to the midi device.
 	 *
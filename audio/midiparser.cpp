@@ -42,6 +42,8 @@ _autoLoop(false),
 _smartJump(false),
 _centerPitchWheelOnUnload(false),
 _sendSustainOffOnNotesOff(false),
+_delayEvents(false),
+_eventDelay(0),
 _num_tracks(0),
 _active_track(255),
 _abort_parse(0) {
@@ -66,11 +68,17 @@ void MidiParser::property(int prop, int value) {
 	case mpSendSustainOffOnNotesOff:
 		_sendSustainOffOnNotesOff = (value != 0);
 		break;
+	case mpDelayEvents:
+		_delayEvents = (value != 0);
+		break;
 	}
 }
 
 void MidiParser::sendToDriver(uint32 b) {
-	_driver->send(b);
+	if (_delayEvents)
+		_driver->sendDelayed(b, _eventDelay);
+	else
+		_driver->send(b);
 }
 
 void MidiParser::setTempo(uint32 tempo) {
@@ -168,6 +176,7 @@ void MidiParser::onTimer() {
 		return;
 
 	_abort_parse = false;
+	_eventDelay = 0;
 	end_time = _position._play_time + _timer_rate;
 
 	// Scan our hanging notes for any
@@ -195,6 +204,11 @@ void MidiParser::onTimer() {
 		if (event_time > end_time)
 			break;
 
+		// SysEx and meta events can't be delayed. Keep them in order with
+		// the events delayed before them.
+		if (_eventDelay && (info.event == 0xF0 || info.event == 0xFF))
+			break;
+
 		// Process the next info.
 		_position._last_event_tick += info.delta;
 		if (info.event < 0x80) {
@@ -238,6 +252,8 @@ void MidiParser::onTimer() {
 				else
 					activeNote(info.channel(), info.basic.param1, true);
 			}
+			if (_delayEvents)
+				_eventDelay = (event_time > _position._play_time) ? event_time - _position._play_time : 0;
 			sendToDriver(info.event, info.basic.param1, info.basic.param2);
 		}
 
@@ -248,6 +264,8 @@ void MidiParser::onTimer() {
 		}
 	}
 
+	_eventDelay = 0;
+
 	if (!_abort_parse) {
 		_position._play_time = end_time;
 		_position._play_tick = (_position._play_time - _position._last_event_time) / _psec_per_tick + _position._last_event_tick;
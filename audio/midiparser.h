@@ -215,6 +215,15 @@ struct NoteTimer {
  * the output MidiDriver used. This rate can be obtained
  * by calling MidiDriver::getBaseTempo.
  *
+ * All events due until the next call to onTimer are sent at
+ * once, so their timing is quantized to the onTimer call rate.
+ * With the mpDelayEvents property, channel events are sent
+ * along with their delay instead, so drivers supporting
+ * MidiDriver_BASE::sendDelayed can play them between two
+ * calls. SysEx and meta events are still quantized: they are
+ * sent on the onTimer call, or on the next one if channel
+ * events were delayed before them.
+ *
  * <b>STEP 5: Load the music.</b>
  * MidiParser requires that the music data already be loaded
  * into memory. The client code is responsible for memory
@@ -278,6 +287,8 @@ protected:
 	bool   _smartJump;      ///< Support smart expiration of hanging notes when jumping
 	bool   _centerPitchWheelOnUnload;  ///< Center the pitch wheels when unloading a song
 	bool   _sendSustainOffOnNotesOff;   ///< Send a sustain off on a notes off event, stopping hanging notes
+	bool   _delayEvents;    ///< Send the events with their delay relative to the timer callback
+	uint32 _eventDelay;     ///< The delay of the event being sent, in microseconds
 	byte  *_tracks[120];    ///< Multi-track MIDI formats are supported, up to 120 tracks.
 	byte   _num_tracks;     ///< Count of total tracks for multi-track MIDI formats. 1 for single-track formats.
 	byte   _active_track;   ///< Keeps track of the currently active track, in multi-track formats.
@@ -363,7 +374,17 @@ public:
 		 * Sends a sustain off event when a notes off event is triggered.
 		 * Stops hanging notes.
 		 */
-		 mpSendSustainOffOnNotesOff = 5
+		 mpSendSustainOffOnNotesOff = 5,
+
+		/**
+		 * Sends the events along with the time they are due, relative to
+		 * the timer callback, through MidiDriver_BASE::sendDelayed().
+		 * Without this, all events due until the next timer callback are
+		 * sent at once. SysEx and meta events are still sent right away,
+		 * so they are held back until the next timer callback when other
+		 * events were delayed before them.
+		 */
+		mpDelayEvents = 6
 	};
 
 public:
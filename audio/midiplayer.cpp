@@ -34,6 +34,8 @@ MidiPlayer::MidiPlayer() :
 	_isLooping(false),
 	_isPlaying(false),
 	_masterVolume(0),
+	_delayEvents(false),
+	_eventDelay(0),
 	_nativeMT32(false) {
 
 	memset(_channelsTable, 0, sizeof(_channelsTable));
@@ -111,6 +113,14 @@ void MidiPlayer::send(uint32 b) {
 	sendToChannel(ch, b);
 }
 
+void MidiPlayer::sendDelayed(uint32 b, uint32 delay) {
+	// Filtered by send() like any other command
+	_delayEvents = true;
+	_eventDelay = delay;
+	send(b);
+	_eventDelay = 0;
+}
+
 void MidiPlayer::sendToChannel(byte ch, uint32 b) {
 	if (!_channelsTable[ch]) {
 		_channelsTable[ch] = (ch == 9) ? _driver->getPercussionChannel() : _driver->allocateChannel();
@@ -119,7 +129,10 @@ void MidiPlayer::sendToChannel(byte ch, uint32 b) {
 		// Does this make sense, and should we maybe do it in general?
 	}
 	if (_channelsTable[ch]) {
-		_channelsTable[ch]->send(b);
+		if (_delayEvents)
+			_driver->sendDelayed((b & 0xFFFFFFF0) | _channelsTable[ch]->getNumber(), _eventDelay);
+		else
+			_channelsTable[ch]->send(b);
 	}
 }
 
@@ -116,12 +116,17 @@ public:
 
 	// MidiDriver_BASE implementation
 	virtual void send(uint32 b);
+	virtual void sendDelayed(uint32 b, uint32 delay);
 	virtual void metaEvent(byte type, byte *data, uint16 length);
 
 protected:
 	/**
 	 * This method is invoked by the default send() implementation,
 	 * after suitably filtering the message b.
+	 *
+	 * Once the parser sent a delayed command (see the mpDelayEvents
+	 * property of MidiParser), all commands go through the delay queue
+	 * of the driver, so that they are played in order.
 	 */
 	virtual void sendToChannel(byte ch, uint32 b);
 
@@ -179,6 +184,9 @@ protected:
 	 */
 	int _masterVolume;	// FIXME: byte or int ?
 
+	bool _delayEvents;    ///< Whether sendDelayed() was ever called
+	uint32 _eventDelay;   ///< The delay of the command being sent, in microseconds
+
 	bool _nativeMT32;
 };
 
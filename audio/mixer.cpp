@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -265,6 +266,8 @@ void MixerImpl::playStream(
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
+	PROFILE_ZONE("mixCallback");
+
 	assert(samples);
 
 	Common::StackLock lock(_mutex);
@@ -2,6 +2,8 @@ MODULE := audio
 
 MODULE_OBJS := \
 	audiostream.o \
+	decode_ahead.o \
+	decoded_cache.o \
 	fmopl.o \
 	mididrv.o \
 	midiparser_smf.o \
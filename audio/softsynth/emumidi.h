@@ -26,6 +26,9 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+#include "common/mutex.h"
+#include "common/util.h"
+
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -43,6 +46,28 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	/**
+	 * A command sent through sendDelayed(), along with the sample it is
+	 * due at. The samples are counted since the driver was created.
+	 */
+	struct DelayedEvent {
+		uint32 b;
+		uint32 sample;
+	};
+
+	enum {
+		kDelayedEventCount = 256
+	};
+
+	DelayedEvent _delayedEvents[kDelayedEventCount];
+	uint _delayedEventsFirst;
+	uint _delayedEventsCount;
+	bool _delayedEventsUsed;	///< Whether sendDelayed() was ever called, so readBuffer() needs to check the queue
+	Common::Mutex _delayedEventsMutex;
+
+	uint32 _sampleCount;	///< The samples generated so far
+	uint32 _tickStart;		///< The sample at which the current timer callback started
+
 protected:
 	int _baseFreq;
 
@@ -57,6 +82,11 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_delayedEventsFirst(0),
+		_delayedEventsCount(0),
+		_delayedEventsUsed(false),
+		_sampleCount(0),
+		_tickStart(0),
 		_baseFreq(250) {
 	}
 
@@ -86,6 +116,36 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
+	virtual void sendDelayed(uint32 b, uint32 delay) {
+		Common::StackLock lock(_delayedEventsMutex);
+		_delayedEventsUsed = true;
+
+		// When the queue is full, play everything right away, which at
+		// least keeps the order of the commands
+		if (_delayedEventsCount == kDelayedEventCount) {
+			while (_delayedEventsCount)
+				send(popDelayedEvent().b);
+			send(b);
+			return;
+		}
+
+		// The rate is divided first to avoid an overflow, which is only
+		// slightly inexact for rates not divisible by 100
+		uint32 sample = _tickStart + delay * (getRate() / 100) / 10000;
+
+		// Commands are never reordered
+		if (_delayedEventsCount) {
+			const DelayedEvent &last = _delayedEvents[(_delayedEventsFirst + _delayedEventsCount - 1) % kDelayedEventCount];
+			if ((int32)(sample - last.sample) < 0)
+				sample = last.sample;
+		}
+
+		DelayedEvent &event = _delayedEvents[(_delayedEventsFirst + _delayedEventsCount) % kDelayedEventCount];
+		event.b = b;
+		event.sample = sample;
+		_delayedEventsCount++;
+	}
+
 	// AudioStream API
 	virtual int readBuffer(int16 *data, const int numSamples) {
 		const int stereoFactor = isStereo() ? 2 : 1;
@@ -97,10 +157,21 @@ public:
 			if (step > (_nextTick >> FIXP_SHIFT))
 				step = (_nextTick >> FIXP_SHIFT);
 
+			// Drivers which never get delayed commands don't take the lock
+			if (_delayedEventsUsed)
+				step = playDelayedEvents(step);
+
 			generateSamples(data, step);
+			_sampleCount += step;
 
 			_nextTick -= step << FIXP_SHIFT;
 			if (!(_nextTick >> FIXP_SHIFT)) {
+				// Play the commands due before the timer callback adds
+				// new ones
+				if (_delayedEventsUsed)
+					playDelayedEvents(0);
+				_tickStart = _sampleCount;
+
 				if (_timerProc)
 					(*_timerProc)(_timerParam);
 
@@ -119,6 +190,32 @@ public:
 	virtual bool endOfData() const {
 		return false;
 	}
+
+private:
+	DelayedEvent popDelayedEvent() {
+		DelayedEvent event = _delayedEvents[_delayedEventsFirst];
+		_delayedEventsFirst = (_delayedEventsFirst + 1) % kDelayedEventCount;
+		_delayedEventsCount--;
+		return event;
+	}
+
+	/**
+	 * Sends the delayed commands which are due, and returns how many of
+	 * the given samples can be generated before the next one is due.
+	 */
+	int playDelayedEvents(int samples) {
+		Common::StackLock lock(_delayedEventsMutex);
+
+		while (_delayedEventsCount) {
+			int32 delay = (int32)(_delayedEvents[_delayedEventsFirst].sample - _sampleCount);
+			if (delay > 0)
+				return MIN<int>(samples, delay);
+
+			send(popDelayedEvent().b);
+		}
+
+		return samples;
+	}
 };
 
 #endif
@@ -22,6 +22,8 @@
 
 #include "backends/audiocd/default/default-audiocd.h"
 #include "audio/audiostream.h"
+#include "audio/decode_ahead.h"
+#include "common/config-manager.h"
 #include "common/system.h"
 
 DefaultAudioCDManager::DefaultAudioCDManager() {
@@ -68,8 +70,16 @@ void DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 			repetitions. Finally, -1 means infinitely many
 			*/
 			_emulating = true;
-			_mixer->playStream(Audio::Mixer::kMusicSoundType, &_handle,
-			                        Audio::makeLoopingAudioStream(stream, start, end, (numLoops < 1) ? numLoops + 1 : numLoops), -1, _cd.volume, _cd.balance);
+
+			Audio::AudioStream *input = Audio::makeLoopingAudioStream(stream, start, end, (numLoops < 1) ? numLoops + 1 : numLoops);
+
+			// The tracks are compressed. Decoding them ahead of the mixer
+			// moves the work to the timer thread, which is shared with the
+			// engines, so it has to be asked for.
+			if (ConfMan.getBool("cd_decode_ahead"))
+				input = new Audio::DecodeAheadAudioStream(input);
+
+			_mixer->playStream(Audio::Mixer::kMusicSoundType, &_handle, input, -1, _cd.volume, _cd.balance);
 		} else {
 			_emulating = false;
 			if (!only_emulate)
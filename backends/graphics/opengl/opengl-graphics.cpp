@@ -29,6 +29,7 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/mutex.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #ifdef USE_OSD
@@ -988,6 +989,8 @@ void OpenGLGraphicsManager::getGLPixelFormat(Graphics::PixelFormat pixelFormat,
 }
 
 void OpenGLGraphicsManager::internUpdateScreen() {
+	PROFILE_ZONE("internUpdateScreen");
+
 	// Clear the screen buffer
 	glClear(GL_COLOR_BUFFER_BIT); CHECK_GL_ERROR();
 
@@ -20,14 +20,36 @@
  *
  */
 
+// For the wall clock, the sleeps and the log messages
+#define FORBIDDEN_SYMBOL_EXCEPTION_FILE
+#define FORBIDDEN_SYMBOL_EXCEPTION_stdout
+#define FORBIDDEN_SYMBOL_EXCEPTION_stderr
+#define FORBIDDEN_SYMBOL_EXCEPTION_fputs
+#define FORBIDDEN_SYMBOL_EXCEPTION_exit		//Needed for IRIX's unistd.h
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
 #include "backends/modular-backend.h"
 #include "base/main.h"
 
 #if defined(USE_NULL_DRIVER)
+#include "backends/events/default/default-events.h"
+#include "backends/graphics/null/null-graphics.h"
+#include "backends/mutex/null/null-mutex.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "audio/mixer_intern.h"
+#include "common/algorithm.h"
+#include "common/array.h"
+#include "common/config-manager.h"
+#include "common/EventRecorder.h"
 #include "common/scummsys.h"
+#include "common/str.h"
+
+#if defined(POSIX)
+#include <sys/time.h>
+#include <unistd.h>
+#endif
 
 /*
  * Include header files needed for the getFilesystemFactory() method.
@@ -40,7 +62,7 @@
 	#include "backends/fs/windows/windows-fs-factory.h"
 #endif
 
-class OSystem_NULL : public ModularBackend {
+class OSystem_NULL : public ModularBackend, Common::EventSource {
 public:
 	OSystem_NULL();
 	virtual ~OSystem_NULL();
@@ -49,11 +71,66 @@ public:
 
 	virtual bool pollEvent(Common::Event &event);
 
+	virtual void updateScreen();
+
 	virtual uint32 getMillis();
+	virtual uint32 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &t) const {}
 
 	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+protected:
+	virtual Common::EventSource *getDefaultEventSource() { return this; }
+
+private:
+
+	/**
+	 * Run the timers and mix the audio up to the current time. There is
+	 * no timer or audio thread here, so this is called whenever the engine
+	 * polls events, waits or updates the screen.
+	 */
+	void runSubsystems();
+
+	/**
+	 * Returns the real time since the backend was created, for the timedemo
+	 * statistics and the clock outside of timedemos. Always 0 where there is
+	 * no wall clock.
+	 */
+	uint32 getWallMicros() const;
+
+	void printTimedemoStatistics();
+
+#if defined(POSIX)
+	timeval _startTime;
+#endif
+	uint32 _lastMillis;
+
+	/**
+	 * In timedemo mode, and where there is no wall clock, the time only
+	 * moves on when the engine waits, or as the event recorder plays it
+	 * back, so that a run doesn't depend on how fast the host is.
+	 */
+	bool _virtualClock;
+	uint32 _virtualMillis;
+
+	enum {
+		kMixRate = 22050,
+		kMixBufferSize = 4096
+	};
+	int16 _mixBuffer[kMixBufferSize * 2];
+	uint32 _lastMixMillis;
+	uint32 _mixRemainder;
+	bool _runningSubsystems;
+
+	// Timedemo statistics, in microseconds
+	bool _timedemo;
+	uint32 _timedemoStart;
+	uint32 _frameStart;
+	Common::Array<uint32> _frameTimes;
+	double _timerTime;
+	double _audioTime;
+	double _screenTime;
 };
 
 OSystem_NULL::OSystem_NULL() {
@@ -66,9 +143,30 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+#if defined(POSIX)
+	gettimeofday(&_startTime, 0);
+#endif
+	_lastMillis = 0;
+#if defined(POSIX)
+	_virtualClock = false;
+#else
+	_virtualClock = true;
+#endif
+	_virtualMillis = 0;
+	_lastMixMillis = 0;
+	_mixRemainder = 0;
+	_runningSubsystems = false;
+
+	_timedemo = false;
+	_timedemoStart = 0;
+	_frameStart = 0;
+	_timerTime = _audioTime = _screenTime = 0;
 }
 
 OSystem_NULL::~OSystem_NULL() {
+	if (_timedemo)
+		printTimedemoStatistics();
 }
 
 void OSystem_NULL::initBackend() {
@@ -77,26 +175,151 @@ void OSystem_NULL::initBackend() {
 	_eventManager = new DefaultEventManager(this);
 	_savefileManager = new DefaultSaveFileManager();
 	_graphicsManager = new NullGraphicsManager();
-	_mixer = new Audio::MixerImpl(this, 22050);
+	_mixer = new Audio::MixerImpl(this, kMixRate);
 
-	((Audio::MixerImpl *)_mixer)->setReady(false);
+	// The mixer and the timers are run from runSubsystems(), and the mixed
+	// audio is thrown away
+	((Audio::MixerImpl *)_mixer)->setReady(true);
 
-	// Note that both the mixer and the timer manager are useless
-	// this way; they need to be hooked into the system somehow to
-	// be functional. Of course, can't do that in a NULL backend :).
+	// In timedemo mode the event recorder plays back a recording on the
+	// virtual clock, and the real time spent is reported on exit
+	_timedemo = ConfMan.hasKey("timedemo");
+	if (_timedemo)
+		_virtualClock = true;
+	_timedemoStart = _frameStart = getWallMicros();
 
 	ModularBackend::initBackend();
 }
 
 bool OSystem_NULL::pollEvent(Common::Event &event) {
+	runSubsystems();
 	return false;
 }
 
+void OSystem_NULL::updateScreen() {
+	uint32 start = getWallMicros();
+	ModularBackend::updateScreen();
+	uint32 end = getWallMicros();
+
+	_screenTime += end - start;
+
+	if (_timedemo) {
+		_frameTimes.push_back(end - _frameStart);
+		_frameStart = end;
+	}
+
+	runSubsystems();
+}
+
 uint32 OSystem_NULL::getMillis() {
-	return 0;
+	uint32 millis = _virtualClock ? _virtualMillis : getWallMicros() / 1000;
+
+	// The recorded times, if any, replace the virtual ones too
+	g_eventRec.processMillis(millis);
+	if (_virtualClock)
+		_virtualMillis = millis;
+	_lastMillis = millis;
+	return millis;
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+	if (_virtualClock) {
+		_virtualMillis += msecs;
+	} else {
+#if defined(POSIX)
+		if (!g_eventRec.processDelayMillis(msecs))
+			usleep(msecs * 1000);
+#endif
+	}
+
+	runSubsystems();
+}
+
+uint32 OSystem_NULL::getMicros() {
+	if (_virtualClock)
+		return _virtualMillis * 1000;
+
+	return getWallMicros();
+}
+
+uint32 OSystem_NULL::getWallMicros() const {
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return (curTime.tv_sec - _startTime.tv_sec) * 1000000 + (curTime.tv_usec - _startTime.tv_usec);
+#else
+	return 0;
+#endif
+}
+
+void OSystem_NULL::runSubsystems() {
+	// Timer callbacks may poll events or wait themselves
+	if (_runningSubsystems)
+		return;
+	_runningSubsystems = true;
+
+	uint32 start = getWallMicros();
+	((DefaultTimerManager *)_timerManager)->handler();
+	uint32 timersDone = getWallMicros();
+
+	// The timer handler fetched the current time, which may have come from
+	// a recording or the virtual clock
+	uint32 elapsed = _lastMillis - _lastMixMillis;
+	_lastMixMillis = _lastMillis;
+
+	// Don't try to catch up with long pauses, or the clock going back
+	if (elapsed > 1000)
+		elapsed = 1000;
+
+	_mixRemainder += elapsed * kMixRate;
+	uint samples = _mixRemainder / 1000;
+	_mixRemainder %= 1000;
+
+	while (samples > 0) {
+		uint count = MIN<uint>(samples, kMixBufferSize);
+		((Audio::MixerImpl *)_mixer)->mixCallback((byte *)_mixBuffer, count * 4);
+		samples -= count;
+	}
+
+	uint32 end = getWallMicros();
+	_timerTime += timersDone - start;
+	_audioTime += end - timersDone;
+
+	_runningSubsystems = false;
+}
+
+void OSystem_NULL::printTimedemoStatistics() {
+#if !defined(POSIX)
+	logMessage(LogMessageType::kInfo, "Timedemo: There is no wall clock to time the frames with\n");
+#else
+	double totalTime = getWallMicros() - _timedemoStart;
+	uint frames = _frameTimes.size();
+
+	if (frames == 0 || totalTime <= 0) {
+		logMessage(LogMessageType::kInfo, "Timedemo: No frames were drawn\n");
+		return;
+	}
+
+	double frameTime = 0;
+	for (uint i = 0; i < frames; i++)
+		frameTime += _frameTimes[i];
+
+	Common::sort(_frameTimes.begin(), _frameTimes.end());
+
+	double median = _frameTimes[(frames - 1) / 2] / 1000.0;
+	double p90 = _frameTimes[(frames - 1) * 90 / 100] / 1000.0;
+	double p99 = _frameTimes[(frames - 1) * 99 / 100] / 1000.0;
+	double max = _frameTimes[frames - 1] / 1000.0;
+
+	double engineTime = totalTime - _timerTime - _audioTime - _screenTime;
+
+	logMessage(LogMessageType::kInfo, Common::String::format("Timedemo: %d frames in %.2f s, %.1f frames per second\n",
+		frames, frameTime / 1000000.0, frames * 1000000.0 / frameTime).c_str());
+	logMessage(LogMessageType::kInfo, Common::String::format("Frame times: median %.2f ms, 90%% %.2f ms, 99%% %.2f ms, max %.2f ms\n",
+		median, p90, p99, max).c_str());
+	logMessage(LogMessageType::kInfo, Common::String::format("Time spent: engine %.1f%%, timers %.1f%%, audio %.1f%%, screen updates %.1f%%\n",
+		engineTime * 100 / totalTime, _timerTime * 100 / totalTime, _audioTime * 100 / totalTime, _screenTime * 100 / totalTime).c_str());
+#endif
 }
 
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -159,6 +160,12 @@ Common::WriteStream *OSystem_POSIX::createLogFile() {
 	return stream;
 }
 
+uint32 OSystem_POSIX::getMicros() {
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return curTime.tv_sec * 1000000 + curTime.tv_usec;
+}
+
 bool OSystem_POSIX::displayLogFile() {
 	if (_logFilePath.empty())
 		return false;
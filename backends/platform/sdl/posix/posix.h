@@ -35,6 +35,8 @@ public:
 
 	virtual bool displayLogFile();
 
+	virtual uint32 getMicros();
+
 	virtual void init();
 	virtual void initBackend();
 
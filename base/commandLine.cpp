@@ -194,6 +194,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("gm_device", "null");
 
 	ConfMan.registerDefault("cdrom", 0);
+	ConfMan.registerDefault("cd_decode_ahead", false);
 
 	ConfMan.registerDefault("enable_unsupported_game_warning", true);
 
@@ -551,6 +552,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("record-time-file-name")
 			END_OPTION
 
+			DO_LONG_OPTION("timedemo")
+			END_OPTION
+
 #ifdef IPHONE
 			// This is automatically set when launched from the Springboard.
 			DO_LONG_OPTION_OPT("launchedFromSB", 0)
@@ -130,6 +130,7 @@ EventRecorder::EventRecorder() {
 	_lastEventMillis = 0;
 
 	_recordMode = kPassthrough;
+	_fastPlayback = false;
 }
 
 EventRecorder::~EventRecorder() {
@@ -141,6 +142,13 @@ EventRecorder::~EventRecorder() {
 
 void EventRecorder::init() {
 	String recordModeString = ConfMan.get("record_mode");
+
+	// A timedemo plays back a recording as fast as possible, to measure
+	// the performance of an engine
+	_fastPlayback = ConfMan.hasKey("timedemo");
+	if (_fastPlayback)
+		recordModeString = "playback";
+
 	if (recordModeString.compareToIgnoreCase("record") == 0) {
 		_recordMode = kRecorderRecord;
 
@@ -155,7 +163,7 @@ void EventRecorder::init() {
 		}
 	}
 
-	_recordFileName = ConfMan.get("record_file_name");
+	_recordFileName = ConfMan.get(_fastPlayback ? "timedemo" : "record_file_name");
 	if (_recordFileName.empty()) {
 		_recordFileName = "record.bin";
 	}
@@ -325,7 +333,7 @@ void EventRecorder::processMillis(uint32 &millis) {
 		if (_recordTimeCount > _playbackTimeCount) {
 			d = readTime(_playbackTimeFile);
 
-			while ((_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
+			while (!_fastPlayback && (_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
 				_recordMode = kPassthrough;
 				g_system->delayMillis(50);
 				millis = g_system->getMillis();
@@ -343,6 +351,9 @@ void EventRecorder::processMillis(uint32 &millis) {
 
 bool EventRecorder::processDelayMillis(uint &msecs) {
 	if (_recordMode == kRecorderPlayback) {
+		if (_fastPlayback)
+			return true;
+
 		_recordMode = kPassthrough;
 
 		uint32 millis = g_system->getMillis();
@@ -420,6 +431,10 @@ bool EventRecorder::pollEvent(Event &ev) {
 			_lastEventCount = _eventCount;
 			return true;
 		}
+	} else if (_fastPlayback && _playbackTimeCount >= _recordTimeCount) {
+		// The timedemo is over once the recording has been played back
+		ev.type = EVENT_QUIT;
+		return true;
 	}
 
 	return false;
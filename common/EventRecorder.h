@@ -100,6 +100,7 @@ private:
 		kRecorderPlayback = 2
 	};
 	volatile RecordMode _recordMode;
+	bool _fastPlayback; ///< Play back without waiting for the recorded times
 	String _recordFileName;
 	String _recordTempFileName;
 	String _recordTimeFileName;
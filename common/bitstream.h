@@ -26,8 +26,10 @@
 #define COMMON_BITSTREAM_H
 
 #include "common/scummsys.h"
+#include "common/endian.h"
 #include "common/textconsole.h"
 #include "common/stream.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -67,6 +69,9 @@ public:
 	/** Add a bit to the value x, making it an n+1-bit value. */
 	virtual void addBit(uint32 &x, uint32 n) = 0;
 
+	/** Are the bits handed out in the order of MSB to LSB? */
+	virtual bool isMSBFirst() const = 0;
+
 protected:
 	BitStream() {
 	}
@@ -191,6 +196,13 @@ public:
 		if (n > 32)
 			error("BitStreamImpl::getBits(): Too many bits requested to be read");
 
+		// Fast path: all bits are still in the current value
+		if (_inValue != 0 && n <= valueBits - _inValue) {
+			uint32 v = peekBits(n);
+			skip(n);
+			return v;
+		}
+
 		// Read the number of bits
 		uint32 v = 0;
 
@@ -228,6 +240,14 @@ public:
 	 * The bit order is the same as in getBits().
 	 */
 	uint32 peekBits(uint8 n) {
+		// Fast path: all bits are still in the current value
+		if (_inValue != 0 && n != 0 && n <= valueBits - _inValue) {
+			if (isMSB2LSB)
+				return _value >> (32 - n);
+			else
+				return _value & (0xFFFFFFFF >> (32 - n));
+		}
+
 		uint32 value   = _value;
 		uint8  inValue = _inValue;
 		uint32 curPos  = _stream->pos();
@@ -272,6 +292,17 @@ public:
 
 	/** Skip the specified amount of bits. */
 	void skip(uint32 n) {
+		// Fast path: skipping within the current value
+		if (_inValue != 0 && n <= (uint32)(valueBits - _inValue)) {
+			if (isMSB2LSB)
+				_value <<= n;
+			else
+				_value >>= n;
+
+			_inValue = (_inValue + n) % valueBits;
+			return;
+		}
+
 		while (n-- > 0)
 			getBit();
 	}
@@ -293,6 +324,10 @@ public:
 	bool eos() const {
 		return _stream->eos() || (pos() >= size());
 	}
+
+	bool isMSBFirst() const {
+		return isMSB2LSB;
+	}
 };
 
 // typedefs for various memory layouts.
@@ -320,6 +355,268 @@ typedef BitStreamImpl<32, false, true > BitStream32BEMSB;
 /** 32-bit big-endian data, LSB to MSB. */
 typedef BitStreamImpl<32, false, false> BitStream32BELSB;
 
+/**
+ * A template implementing a bit stream reading directly from memory.
+ *
+ * It offers the same methods as BitStreamImpl and the layout parameters have
+ * the same meaning, but it does not implement the BitStream interface. That
+ * way, decoders using it directly don't pay for a virtual call per bit.
+ *
+ * Whole values are read into a 32-bit cache at once, so reading, peeking and
+ * skipping bits usually only takes a few shifts. Peeking past the end of the
+ * data yields zero bits, everything else past the end is an error.
+ *
+ * The data is not copied and has to stay valid while the bit stream is used.
+ */
+template<int valueBits, bool isLE, bool isMSB2LSB>
+class BitStreamMemoryImpl {
+private:
+	const byte *_data; ///< The start of the data.
+	const byte *_ptr;  ///< The next value to be read into the cache.
+	const byte *_end;  ///< The end of the last complete value.
+
+	/**
+	 * The cached bits. If reading MSB first, they are aligned to the MSB,
+	 * otherwise to the LSB. All other bits are 0.
+	 */
+	uint32 _cache;
+	uint8  _cacheBits; ///< Number of bits in the cache.
+
+	/** Read the data value at p. */
+	static inline uint32 readData(const byte *p) {
+		if (valueBits == 8)
+			return *p;
+		if (valueBits == 16)
+			return isLE ? READ_LE_UINT16(p) : READ_BE_UINT16(p);
+
+		return isLE ? READ_LE_UINT32(p) : READ_BE_UINT32(p);
+	}
+
+	/** Read as many whole values into the cache as fit. */
+	inline void refill() {
+		while (_cacheBits <= 32 - valueBits && _ptr < _end) {
+			const uint32 v = readData(_ptr);
+			_ptr += valueBits / 8;
+
+			if (isMSB2LSB)
+				_cache |= v << (32 - valueBits - _cacheBits);
+			else
+				_cache |= v << _cacheBits;
+
+			_cacheBits += valueBits;
+		}
+	}
+
+	/** Return the next n bits in the cache, n being at most _cacheBits. */
+	inline uint32 cachedBits(uint8 n) const {
+		if (n == 0)
+			return 0;
+
+		if (isMSB2LSB)
+			return _cache >> (32 - n);
+
+		return _cache & (0xFFFFFFFF >> (32 - n));
+	}
+
+	/** Remove n bits from the cache, n being at most _cacheBits. */
+	inline void dropBits(uint8 n) {
+		if (n == 32)
+			_cache = 0;
+		else if (isMSB2LSB)
+			_cache <<= n;
+		else
+			_cache >>= n;
+
+		_cacheBits -= n;
+	}
+
+	/** Read n bits which are not all in the cache, even after a refill. */
+	uint32 getBitsSplit(uint8 n) {
+		const uint8 first = _cacheBits;
+		const uint32 v = cachedBits(first);
+		dropBits(first);
+
+		refill();
+
+		const uint8 rest = n - first;
+		if (rest > _cacheBits)
+			error("BitStreamMemoryImpl::getBits(): End of bit stream reached");
+
+		const uint32 w = cachedBits(rest);
+		dropBits(rest);
+
+		if (first == 0)
+			return w;
+
+		return isMSB2LSB ? ((v << rest) | w) : (v | (w << first));
+	}
+
+	/** Peek at n bits which are not all in the cache, even after a refill. */
+	uint32 peekBitsSplit(uint8 n) const {
+		const uint8 first = _cacheBits;
+		const uint32 v = cachedBits(first);
+
+		// After a refill, there's less than one value missing, unless the
+		// end of the data was reached.
+		const uint8 rest = n - first;
+		uint32 w = 0;
+		if (_ptr < _end) {
+			const uint32 next = readData(_ptr);
+			w = isMSB2LSB ? (next >> (valueBits - rest)) : (next & (0xFFFFFFFF >> (32 - rest)));
+		}
+
+		if (first == 0)
+			return w;
+
+		return isMSB2LSB ? ((v << rest) | w) : (v | (w << first));
+	}
+
+public:
+	/** Create a bit stream reading size bytes of data. */
+	BitStreamMemoryImpl(const byte *data, uint32 size) :
+		_data(data), _ptr(data), _end(data + (size & ~((uint32) ((valueBits >> 3) - 1)))),
+		_cache(0), _cacheBits(0) {
+
+		if ((valueBits != 8) && (valueBits != 16) && (valueBits != 32))
+			error("BitStreamMemoryImpl: Invalid memory layout %d, %d, %d", valueBits, isLE, isMSB2LSB);
+	}
+
+	/** Read a bit from the bit stream. */
+	uint32 getBit() {
+		return getBits(1);
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream.
+	 *
+	 * The bit order is the same as in BitStreamImpl::getBits().
+	 */
+	uint32 getBits(uint8 n) {
+		if (n > 32)
+			error("BitStreamMemoryImpl::getBits(): Too many bits requested to be read");
+
+		if (n > _cacheBits) {
+			refill();
+
+			if (n > _cacheBits)
+				return getBitsSplit(n);
+		}
+
+		const uint32 v = cachedBits(n);
+		dropBits(n);
+		return v;
+	}
+
+	/** Read a bit from the bit stream, without changing the stream's position. */
+	uint32 peekBit() {
+		return peekBits(1);
+	}
+
+	/**
+	 * Read a multi-bit value from the bit stream, without changing the stream's position.
+	 *
+	 * The bit order is the same as in getBits().
+	 */
+	uint32 peekBits(uint8 n) {
+		if (n > 32)
+			error("BitStreamMemoryImpl::peekBits(): Too many bits requested to be read");
+
+		if (n > _cacheBits) {
+			refill();
+
+			if (n > _cacheBits)
+				return peekBitsSplit(n);
+		}
+
+		return cachedBits(n);
+	}
+
+	/**
+	 * Add a bit to the value x, making it an n+1-bit value.
+	 *
+	 * See BitStreamImpl::addBit().
+	 */
+	void addBit(uint32 &x, uint32 n) {
+		if (n >= 32)
+			error("BitStreamMemoryImpl::addBit(): Too many bits requested to be read");
+
+		if (isMSB2LSB)
+			x = (x << 1) | getBit();
+		else
+			x = (x & ~(1 << n)) | (getBit() << n);
+	}
+
+	/** Rewind the bit stream back to the start. */
+	void rewind() {
+		_ptr       = _data;
+		_cache     = 0;
+		_cacheBits = 0;
+	}
+
+	/** Skip the specified amount of bits. */
+	void skip(uint32 n) {
+		if (n <= _cacheBits) {
+			dropBits(n);
+			return;
+		}
+
+		n -= _cacheBits;
+		dropBits(_cacheBits);
+
+		// Skip whole values without reading them
+		const uint32 values = MIN<uint32>(n / valueBits, (_end - _ptr) / (valueBits / 8));
+		_ptr += values * (valueBits / 8);
+		n    -= values * valueBits;
+
+		refill();
+		if (n > _cacheBits)
+			error("BitStreamMemoryImpl::skip(): End of bit stream reached");
+
+		dropBits(n);
+	}
+
+	/** Return the stream position in bits. */
+	uint32 pos() const {
+		return (_ptr - _data) * 8 - _cacheBits;
+	}
+
+	/** Return the stream size in bits. */
+	uint32 size() const {
+		return (_end - _data) * 8;
+	}
+
+	bool eos() const {
+		return pos() >= size();
+	}
+
+	bool isMSBFirst() const {
+		return isMSB2LSB;
+	}
+};
+
+/** 8-bit data in memory, MSB to LSB. */
+typedef BitStreamMemoryImpl<8, false, true > BitStreamMemory8MSB;
+/** 8-bit data in memory, LSB to MSB. */
+typedef BitStreamMemoryImpl<8, false, false> BitStreamMemory8LSB;
+
+/** 16-bit little-endian data in memory, MSB to LSB. */
+typedef BitStreamMemoryImpl<16, true , true > BitStreamMemory16LEMSB;
+/** 16-bit little-endian data in memory, LSB to MSB. */
+typedef BitStreamMemoryImpl<16, true , false> BitStreamMemory16LELSB;
+/** 16-bit big-endian data in memory, MSB to LSB. */
+typedef BitStreamMemoryImpl<16, false, true > BitStreamMemory16BEMSB;
+/** 16-bit big-endian data in memory, LSB to MSB. */
+typedef BitStreamMemoryImpl<16, false, false> BitStreamMemory16BELSB;
+
+/** 32-bit little-endian data in memory, MSB to LSB. */
+typedef BitStreamMemoryImpl<32, true , true > BitStreamMemory32LEMSB;
+/** 32-bit little-endian data in memory, LSB to MSB. */
+typedef BitStreamMemoryImpl<32, true , false> BitStreamMemory32LELSB;
+/** 32-bit big-endian data in memory, MSB to LSB. */
+typedef BitStreamMemoryImpl<32, false, true > BitStreamMemory32BEMSB;
+/** 32-bit big-endian data in memory, LSB to MSB. */
+typedef BitStreamMemoryImpl<32, false, false> BitStreamMemory32BELSB;
+
 } // End of namespace Common
 
 #endif // COMMON_BITSTREAM_H
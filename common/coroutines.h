@@ -20,39 +20,34 @@
  *
  */
 
-#ifndef TINSEL_COROUTINE_H
-#define TINSEL_COROUTINE_H
+#ifndef COMMON_COROUTINES_H
+#define COMMON_COROUTINES_H
 
 #include "common/scummsys.h"
 #include "common/util.h"	// for SCUMMVM_CURRENT_FUNCTION
 
-namespace Tinsel {
+namespace Common {
+
+class MemoryPool;
 
 /**
- * @defgroup TinselCoroutines	Coroutine support for Tinsel
+ * @defgroup Coroutine	support for simulating multi-threading.
  *
  * The following is loosely based on an article by Simon Tatham:
  *   <http://www.chiark.greenend.org.uk/~sgtatham/coroutines.html>.
  * However, many improvements and tweaks have been made, in particular
  * by taking advantage of C++ features not available in C.
  *
- * Why is this code here? Well, the Tinsel engine apparently used
- * setjmp/longjmp based coroutines as a core tool from the start, and
- * so they are deeply ingrained into the whole code base. When we
- * started to get Tinsel ready for ScummVM, we had to deal with that.
- * It soon got clear that we could not simply rewrite the code to work
- * without some form of coroutines. While possible in principle, it
- * would have meant a major restructuring of the entire code base, a
- * rather daunting task. Also, it would have very likely introduced
- * tons of regressons.
+ * This code was originally written for the Tinsel engine, which used
+ * setjmp/longjmp based coroutines as a core tool from the start. Rather
+ * than restructuring that code base, the coroutines were reimplemented
+ * using Simon Tatham's trick as described above. While the trick is
+ * dirty, the result seems to be clear enough, and it allows engines to
+ * stay relatively close to the structure of the original code.
  *
- * So instead of getting rid of the coroutines, we chose to implement
- * them in an alternate way, using Simon Tatham's trick as described
- * above. While the trick is dirty, the result seems to be clear enough,
- * we hope; plus, it allowed us to stay relatively close to the
- * original structure of the code, which made it easier to avoid
- * regressions, and will be helpful in the future when comparing things
- * against the original code base.
+ * Coroutine contexts are allocated from a shared set of memory pools
+ * (one per size class), as they are created and destroyed constantly
+ * while coroutines run.
  */
 //@{
 
@@ -72,7 +67,15 @@ struct CoroBaseContext {
 	const char *_funcName;
 #endif
 	CoroBaseContext(const char *func);
-	~CoroBaseContext();
+	virtual ~CoroBaseContext();
+
+	/**
+	 * Contexts created by a process are taken from the memory pools of
+	 * the CoroutineScheduler running it. All others, including those of
+	 * coroutines called outside of a scheduler, come from the heap.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
 };
 
 typedef CoroBaseContext *CoroContext;
@@ -106,7 +109,7 @@ public:
 };
 
 
-#define CORO_PARAM    CoroContext &coroParam
+#define CORO_PARAM    Common::CoroContext &coroParam
 
 
 /**
@@ -131,7 +134,7 @@ public:
  * context, and so compilers won't complain about ";" following the macro.
  */
 #define CORO_BEGIN_CONTEXT  \
-	struct CoroContextTag : CoroBaseContext { \
+	struct CoroContextTag : Common::CoroBaseContext { \
 		CoroContextTag() : CoroBaseContext(SCUMMVM_CURRENT_FUNCTION) {} \
 		int DUMMY
 
@@ -148,9 +151,9 @@ public:
  * @see CORO_BEGIN_CODE
  */
 #define CORO_BEGIN_CODE(x) \
-		if (&coroParam == &nullContext) assert(!nullContext);\
+		if (&coroParam == &Common::nullContext) assert(!Common::nullContext);\
 		if (!x) {coroParam = x = new CoroContextTag();}\
-		CoroContextHolder tmpHolder(coroParam);\
+		Common::CoroContextHolder tmpHolder(coroParam);\
 		switch (coroParam->_line) { case 0:;
 
 /**
@@ -158,9 +161,9 @@ public:
  * @see CORO_END_CODE
  */
 #define CORO_END_CODE \
-			if (&coroParam == &nullContext) { \
-				delete nullContext; \
-				nullContext = NULL; \
+			if (&coroParam == &Common::nullContext) { \
+				delete Common::nullContext; \
+				Common::nullContext = NULL; \
 			} \
 		}
 
@@ -170,13 +173,10 @@ public:
 #define CORO_SLEEP(delay) do {\
 			coroParam->_line = __LINE__;\
 			coroParam->_sleep = delay;\
-			assert(&coroParam != &nullContext);\
+			assert(&coroParam != &Common::nullContext);\
 			return; case __LINE__:;\
 		} while (0)
 
-#define CORO_GIVE_WAY do { g_scheduler->giveWay(); CORO_SLEEP(1); } while (0)
-#define CORO_RESCHEDULE do { g_scheduler->reschedule(); CORO_SLEEP(1); } while (0)
-
 /**
  * Stop the currently running coroutine and all calling coroutines.
  *
@@ -186,7 +186,7 @@ public:
  * then delete the entire coroutine's state, including all subcontexts).
  */
 #define CORO_KILL_SELF() \
-		do { if (&coroParam != &nullContext) { coroParam->_sleep = -1; } return; } while (0)
+		do { if (&coroParam != &Common::nullContext) { coroParam->_sleep = -1; } return; } while (0)
 
 
 /**
@@ -223,7 +223,7 @@ public:
 				subCoro ARGS;\
 				if (!coroParam->_subctx) break;\
 				coroParam->_sleep = coroParam->_subctx->_sleep;\
-				assert(&coroParam != &nullContext);\
+				assert(&coroParam != &Common::nullContext);\
 				return; case __LINE__:;\
 			} while (1);\
 		} while (0)
@@ -242,7 +242,7 @@ public:
 				subCoro ARGS;\
 				if (!coroParam->_subctx) break;\
 				coroParam->_sleep = coroParam->_subctx->_sleep;\
-				assert(&coroParam != &nullContext);\
+				assert(&coroParam != &Common::nullContext);\
 				return RESULT; case __LINE__:;\
 			} while (1);\
 		} while (0)
@@ -275,8 +275,146 @@ public:
 #define CORO_INVOKE_3(subCoroutine, a0,a1,a2) \
 			CORO_INVOKE_ARGS(subCoroutine,(CORO_SUBCTX,a0,a1,a2))
 
+
+// the size of process specific info
+#define	CORO_PARAM_SIZE	32
+
+typedef void (*CORO_ADDR)(CoroContext &, const void *);
+
+/** process structure */
+struct PROCESS {
+	PROCESS *pNext;		///< pointer to next process in active or free list
+	PROCESS *pPrevious;	///< pointer to previous process in active or free list
+
+	CoroContext state;		///< the state of the coroutine
+	CORO_ADDR  coroAddr;	///< the entry point of the coroutine
+
+	int sleepTime;		///< number of scheduler cycles to sleep
+	int pid;		///< process ID
+	char param[CORO_PARAM_SIZE];	///< process specific info
+
+	uint32 runCount;	///< number of times the process has been dispatched
+	uint32 runTime;		///< total time in microseconds spent running the process
+};
+typedef PROCESS *PPROCESS;
+
+/**
+ * Create and manage "processes" (really coroutines).
+ *
+ * Processes are kept in an ordered active list which is walked once per
+ * call to schedule(). Engines depend on the exact dispatch order (e.g.
+ * newly created processes run right after their creator on the same
+ * tick), which is why this is not a priority queue.
+ */
+class CoroutineScheduler {
+public:
+	/** Pointer to a function of the form "void function(PPROCESS)" */
+	typedef void (*VFPTRPP)(PROCESS *);
+
+private:
+
+	/** number of entries allocated for the process table */
+	const int processTableSize;
+
+	/** number of process table entries in use since the last reset() */
+	int numProcessSlots;
+
+	/** list of all processes */
+	PROCESS *processList;
+
+	/** active process list - also saves scheduler state */
+	PROCESS *active;
+
+	/** pointer to free process list */
+	PROCESS *pFreeProcesses;
+
+	/** the currently active process */
+	PROCESS *pCurrent;
+
+	// diagnostic process counters
+	int numProcs;
+	int maxProcs;
+
+	/** whether per-process run times are being measured */
+	bool timingEnabled;
+
+	enum {
+		// Contexts are grouped into pools in steps of this many bytes...
+		kContextPoolGranularity = 16,
+		// ...up to this size. Larger contexts are rare and use the heap directly.
+		kContextPoolMaxSize = 512,
+		kContextPoolCount = kContextPoolMaxSize / kContextPoolGranularity
+	};
+
+	/** memory for the coroutine contexts, freed with the scheduler */
+	MemoryPool *contextPools[kContextPoolCount];
+
+#ifdef DEBUG
+	void CheckStack();
+#endif
+
+	/**
+	 * Called from killProcess() to enable other resources
+	 * a process may be allocated to be released.
+	 */
+	VFPTRPP pRCfunction;
+
+	void freeProcessState(PROCESS *pProc);
+
+public:
+
+	CoroutineScheduler(int tableSize);
+	~CoroutineScheduler();
+
+	/**
+	 * Kills all processes and places the first numSlots entries of the
+	 * process table on the free list.
+	 */
+	void reset(int numSlots);
+
+	void printStats();
+
+	void schedule();
+	void rescheduleAll();
+	void reschedule(PPROCESS pReSchedProc = NULL);
+	void giveWay(PPROCESS pReSchedProc = NULL);
+
+	PROCESS *createProcess(int pid, CORO_ADDR coroAddr, const void *pParam, int sizeParam);
+	void killProcess(PROCESS *pKillProc);
+
+	PROCESS *getCurrentProcess();
+	int getCurrentPID() const;
+	int killMatchingProcess(int pidKill, int pidMask = -1);
+
+	void setResourceCallback(VFPTRPP pFunc);
+
+	/**
+	 * Returns the pool for coroutine contexts of the given size, or NULL if
+	 * they are too large to be pooled.
+	 */
+	MemoryPool *getContextPool(size_t size);
+
+	/**
+	 * Enables or disables measuring the time spent in each process.
+	 * Dispatch counts are always kept.
+	 */
+	void setTimingEnabled(bool enabled) { timingEnabled = enabled; }
+	bool isTimingEnabled() const { return timingEnabled; }
+
+	/**
+	 * Returns the first process on the active list, or NULL if there are
+	 * no active processes. Use PROCESS::pNext to walk the remaining ones.
+	 */
+	const PROCESS *getFirstActiveProcess() const { return active->pNext; }
+
+	/** Returns the number of processes currently in use. */
+	int getNumProcesses() const { return numProcs; }
+	/** Returns the highest number of processes in use at the same time. */
+	int getMaxProcesses() const { return maxProcs; }
+};
+
 //@}
 
-} // End of namespace Tinsel
+} // End of namespace Common
 
-#endif		// TINSEL_COROUTINE_H
+#endif		// COMMON_COROUTINES_H
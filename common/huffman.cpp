@@ -25,7 +25,6 @@
 #include "common/huffman.h"
 #include "common/util.h"
 #include "common/textconsole.h"
-#include "common/bitstream.h"
 
 namespace Common {
 
@@ -58,6 +57,8 @@ Huffman::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *codes, const u
 		// And put the pointer to the symbol/code struct into the symbol list.
 		_symbols[i] = &_codes[lengths[i] - 1].back();
 	}
+
+	buildLookupTables();
 }
 
 Huffman::~Huffman() {
@@ -68,19 +69,44 @@ void Huffman::setSymbols(const uint32 *symbols) {
 		_symbols[i]->symbol = symbols ? *symbols++ : i;
 }
 
-uint32 Huffman::getSymbol(BitStream &bits) const {
-	uint32 code = 0;
-
-	for (uint32 i = 0; i < _codes.size(); i++) {
-		bits.addBit(code, i);
-
-		for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
-			if (code == cCode->code)
-				return cCode->symbol;
+void Huffman::buildLookupTables() {
+	_lookupBits = MIN<uint8>(_codes.size(), kMaxLookupBits);
+
+	LookupEntry unused;
+	unused.symbol = 0;
+	unused.length = 0;
+
+	_lookupMSB.resize(1 << _lookupBits);
+	_lookupLSB.resize(1 << _lookupBits);
+	for (uint32 i = 0; i < _lookupMSB.size(); i++)
+		_lookupMSB[i] = _lookupLSB[i] = unused;
+
+	// Go through the codes in the order getSymbolSlow() checks them, and only
+	// fill unused entries, so that the first matching code wins, like there.
+	for (uint8 length = 1; length <= _lookupBits; length++) {
+		const uint32 fill = 1 << (_lookupBits - length);
+
+		for (CodeList::const_iterator cCode = _codes[length - 1].begin(); cCode != _codes[length - 1].end(); ++cCode) {
+			if (cCode->code >= (1u << length))
+				continue; // Can never match
+
+			LookupEntry entry;
+			entry.symbol = &*cCode;
+			entry.length = length;
+
+			// In a MSB-first stream, the code is the top part of the looked up
+			// bits, in a LSB-first stream, it's the bottom part.
+			for (uint32 i = 0; i < fill; i++) {
+				LookupEntry &msb = _lookupMSB[(cCode->code << (_lookupBits - length)) | i];
+				if (!msb.length)
+					msb = entry;
+
+				LookupEntry &lsb = _lookupLSB[cCode->code | (i << length)];
+				if (!lsb.length)
+					lsb = entry;
+			}
+		}
 	}
-
-	error("Unknown Huffman code");
-	return 0;
 }
 
 } // End of namespace Common
@@ -27,6 +27,7 @@
 
 #include "common/array.h"
 #include "common/list.h"
+#include "common/textconsole.h"
 #include "common/types.h"
 
 namespace Common {
@@ -55,8 +56,14 @@ public:
 	/** Modify the codes' symbols. */
 	void setSymbols(const uint32 *symbols = 0);
 
-	/** Return the next symbol in the bitstream. */
-	uint32 getSymbol(BitStream &bits) const;
+	/**
+	 * Return the next symbol in the bitstream.
+	 *
+	 * This works with BitStream as well as directly with any of the bit stream
+	 * implementations, which avoids the virtual calls.
+	 */
+	template<class BITSTREAM>
+	uint32 getSymbol(BITSTREAM &bits) const;
 
 private:
 	struct Symbol {
@@ -66,17 +73,79 @@ private:
 		Symbol(uint32 c, uint32 s);
 	};
 
+	/** An entry of the lookup tables. A length of 0 marks an unused entry. */
+	struct LookupEntry {
+		const Symbol *symbol;
+		uint8 length;
+	};
+
+	enum {
+		/** Maximal number of bits looked up at once. */
+		kMaxLookupBits = 9
+	};
+
 	typedef List<Symbol> CodeList;
 	typedef Array<CodeList> CodeLists;
 	typedef Array<Symbol *> SymbolList;
+	typedef Array<LookupEntry> LookupTable;
 
 	/** Lists of codes and their symbols, sorted by code length. */
 	CodeLists _codes;
 
 	/** Sorted list of pointers to the symbols. */
 	SymbolList _symbols;
+
+	/** Number of bits looked up at once. */
+	uint8 _lookupBits;
+
+	/**
+	 * Tables mapping the next _lookupBits bits of a stream to the code
+	 * they start with, for MSB-first and LSB-first bit streams. Codes
+	 * longer than _lookupBits are not contained in the tables.
+	 */
+	LookupTable _lookupMSB;
+	LookupTable _lookupLSB;
+
+	void buildLookupTables();
+
+	/** Find the next symbol by reading the code bit by bit. */
+	template<class BITSTREAM>
+	uint32 getSymbolSlow(BITSTREAM &bits) const;
 };
 
+template<class BITSTREAM>
+uint32 Huffman::getSymbol(BITSTREAM &bits) const {
+	// Look up as many bits as possible at once. Near the end of the stream,
+	// there might not be enough bits left to do so.
+	if (bits.size() - bits.pos() >= _lookupBits) {
+		const LookupTable &lookup = bits.isMSBFirst() ? _lookupMSB : _lookupLSB;
+		const LookupEntry &entry = lookup[bits.peekBits(_lookupBits)];
+
+		if (entry.length) {
+			bits.skip(entry.length);
+			return entry.symbol->symbol;
+		}
+	}
+
+	return getSymbolSlow(bits);
+}
+
+template<class BITSTREAM>
+uint32 Huffman::getSymbolSlow(BITSTREAM &bits) const {
+	uint32 code = 0;
+
+	for (uint32 i = 0; i < _codes.size(); i++) {
+		bits.addBit(code, i);
+
+		for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
+			if (code == cCode->code)
+				return cCode->symbol;
+	}
+
+	error("Unknown Huffman code");
+	return 0;
+}
+
 } // End of namespace Common
 
 #endif // COMMON_HUFFMAN_H
@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	archive.o \
 	config-file.o \
 	config-manager.o \
+	coroutines.o \
 	dcl.o \
 	debug.o \
 	error.o \
@@ -14,6 +15,7 @@ MODULE_OBJS := \
 	fs.o \
 	gui_options.o \
 	hashmap.o \
+	huffman.o \
 	iff_container.o \
 	language.o \
 	localization.o \
@@ -22,6 +24,7 @@ MODULE_OBJS := \
 	md5.o \
 	mutex.o \
 	platform.o \
+	profiler.o \
 	quicktime.o \
 	random.o \
 	rational.o \
@@ -46,7 +49,6 @@ MODULE_OBJS += \
 	cosinetables.o \
 	dct.o \
 	fft.o \
-	huffman.o \
 	rdft.o \
 	sinetables.o
 endif
@@ -0,0 +1,184 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/profiler.h"
+#include "common/str.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+bool Profiler::_enabled = false;
+
+void ProfileScope::begin(ProfileZone &zone) {
+	_zone = &zone;
+	ProfileMan.beginZone(zone);
+	_start = g_system->getMicros();
+}
+
+void ProfileScope::end() {
+	uint32 duration = g_system->getMicros() - _start;
+	ProfileMan.endZone(*_zone, _start, duration);
+}
+
+Profiler::Profiler() {
+	_firstZone = -1;
+	_timings = new Timing[kTimingCount];
+	_timingPos = 0;
+	_timingSize = 0;
+}
+
+Profiler::~Profiler() {
+	_enabled = false;
+	delete[] _timings;
+}
+
+void Profiler::enable(bool enable) {
+	_enabled = enable;
+}
+
+void Profiler::reset() {
+	StackLock lock(_mutex);
+
+	// The zones are kept, as the ProfileZone objects still refer to them,
+	// and so is the depth of the zones being run
+	while (_firstZone != -1) {
+		Zone &zone = _zones[_firstZone];
+		_firstZone = zone.next;
+
+		zone.count = 0;
+		zone.totalTime = 0;
+		zone.maxTime = 0;
+		zone.next = -1;
+	}
+
+	_timingPos = 0;
+	_timingSize = 0;
+}
+
+void Profiler::beginZone(ProfileZone &zone) {
+	StackLock lock(_mutex);
+
+	// The zones of a plugin loaded again find their statistics by name
+	if (zone.id == -1) {
+		for (uint i = 0; i < _zones.size(); i++) {
+			if (_zones[i].name == zone.name) {
+				zone.id = i;
+				break;
+			}
+		}
+	}
+
+	if (zone.id == -1) {
+		Zone newZone;
+		newZone.name = zone.name;
+		newZone.count = 0;
+		newZone.totalTime = 0;
+		newZone.maxTime = 0;
+		newZone.depth = 0;
+		newZone.next = -1;
+
+		zone.id = _zones.size();
+		_zones.push_back(newZone);
+	}
+
+	_zones[zone.id].depth++;
+}
+
+void Profiler::endZone(const ProfileZone &profileZone, uint32 start, uint32 duration) {
+	StackLock lock(_mutex);
+
+	Zone &zone = _zones[profileZone.id];
+
+	// Only the outermost entry of a recursive zone is timed, and the
+	// profiler may have been stopped in the meantime
+	zone.depth--;
+	if (zone.depth > 0 || !_enabled)
+		return;
+
+	// Zones are listed once they are entered for the first time
+	if (zone.count == 0) {
+		zone.next = _firstZone;
+		_firstZone = profileZone.id;
+	}
+
+	zone.count++;
+	zone.totalTime += duration;
+	if (duration > zone.maxTime)
+		zone.maxTime = duration;
+
+	Timing &timing = _timings[_timingPos];
+	timing.zone = profileZone.id;
+	timing.start = start;
+	timing.duration = duration;
+
+	_timingPos = (_timingPos + 1) % kTimingCount;
+	if (_timingSize < kTimingCount)
+		_timingSize++;
+}
+
+void Profiler::getZones(Array<ProfileZoneStats> &zones) {
+	StackLock lock(_mutex);
+
+	zones.clear();
+	for (int i = _firstZone; i != -1; i = _zones[i].next)
+		zones.push_back(_zones[i]);
+}
+
+bool Profiler::writeTrace(WriteStream &stream) {
+	Array<Timing> timings;
+	Array<String> names;
+
+	{
+		StackLock lock(_mutex);
+
+		for (uint32 i = 0; i < _zones.size(); i++)
+			names.push_back(_zones[i].name);
+
+		const uint32 first = (_timingPos + kTimingCount - _timingSize) % kTimingCount;
+		timings.reserve(_timingSize);
+		for (uint32 i = 0; i < _timingSize; i++)
+			timings.push_back(_timings[(first + i) % kTimingCount]);
+	}
+
+	const uint32 startTime = timings.empty() ? 0 : timings[0].start;
+
+	stream.writeString("{\"traceEvents\":[\n");
+
+	for (uint32 i = 0; i < timings.size(); i++) {
+		const Timing &timing = timings[i];
+
+		// Timestamps are relative to the oldest timing, so that the wrap
+		// around of the microsecond clock doesn't matter
+		stream.writeString(String::format("{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u,\"pid\":1,\"tid\":1}%s\n",
+			names[timing.zone].c_str(), timing.start - startTime, timing.duration, (i + 1 < timings.size()) ? "," : ""));
+	}
+
+	stream.writeString("]}\n");
+	stream.flush();
+
+	return !stream.err();
+}
+
+} // End of namespace Common
@@ -0,0 +1,171 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * A named piece of code whose running time is measured by the profiler.
+ * Declared through the PROFILE_ZONE macro, never directly.
+ *
+ * The statistics are kept by the profiler, as the zones of a plugin go away
+ * when it is unloaded. Zones with the same name share their statistics.
+ */
+struct ProfileZone {
+	const char *name;
+	int id;             ///< Where the profiler keeps the statistics, -1 until entered.
+};
+
+/** The statistics of a zone. */
+struct ProfileZoneStats {
+	String name;
+	uint32 count;       ///< How often the zone was entered, leaving out recursion.
+	uint64 totalTime;   ///< The total time spent in the zone, in microseconds.
+	uint32 maxTime;     ///< The longest time spent in the zone at once.
+};
+
+class ProfileScope;
+
+/**
+ * The profiler keeps statistics for every zone entered, and the most
+ * recent zone timings in a ring buffer. The timings can be written in
+ * the Chrome trace event format, which can be viewed in chrome://tracing.
+ *
+ * The ring buffer is shared by all threads. As the backends don't tell
+ * threads apart, zones running on the audio or timer threads show up
+ * overlapping the ones of the main thread. For the same reason, a zone
+ * entered on two threads at once is only timed on the first one, like a
+ * recursive zone.
+ *
+ * The profiler is created on the main thread at startup. The zones only
+ * use it once it has been enabled.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	Profiler();
+	~Profiler();
+
+	/** Start or stop recording. */
+	void enable(bool enable);
+
+	/** Is the profiler recording? Checked by every profiled zone. */
+	static bool isEnabled() { return _enabled; }
+
+	/** Clear the statistics and the recorded timings. */
+	void reset();
+
+	/**
+	 * Copy the statistics of the zones entered since the last reset, most
+	 * recent first. The copies stay consistent while other threads go on
+	 * recording.
+	 */
+	void getZones(Array<ProfileZoneStats> &zones);
+
+	/**
+	 * Write the recorded timings as Chrome trace JSON. The timings are
+	 * copied first, so that recording is not held up by the writing.
+	 */
+	bool writeTrace(WriteStream &stream);
+
+private:
+	friend class ProfileScope;
+
+	void beginZone(ProfileZone &zone);
+	void endZone(const ProfileZone &zone, uint32 start, uint32 duration);
+
+	struct Zone : ProfileZoneStats {
+		uint32 depth;   ///< How deep the zone is nested in itself.
+		int next;       ///< The next zone entered since the last reset, or -1.
+	};
+
+	struct Timing {
+		int zone;
+		uint32 start;
+		uint32 duration;
+	};
+
+	enum {
+		kTimingCount = 65536
+	};
+
+	static bool _enabled;
+
+	Mutex _mutex;
+	Array<Zone> _zones;
+	int _firstZone;      ///< The zone entered last since the last reset, or -1.
+	Timing *_timings;
+	uint32 _timingPos;   ///< Where the next timing is stored.
+	uint32 _timingSize;  ///< How many timings are stored.
+};
+
+/**
+ * Measures the time until it goes out of scope, when the profiler is
+ * enabled. Only a flag is checked when it is disabled. Recursive entries
+ * of a zone are accounted to the outermost one.
+ */
+class ProfileScope {
+public:
+	ProfileScope(ProfileZone &zone) : _zone(0) {
+		if (Profiler::isEnabled())
+			begin(zone);
+	}
+
+	~ProfileScope() {
+		if (_zone)
+			end();
+	}
+
+private:
+	void begin(ProfileZone &zone);
+	void end();
+
+	ProfileZone *_zone;
+	uint32 _start;
+};
+
+} // End of namespace Common
+
+/** Shortcut for accessing the profiler. */
+#define ProfileMan Common::Profiler::instance()
+
+#define PROFILE_ZONE_CONCAT2(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT2(a, b)
+
+/**
+ * Measure the time until the end of the enclosing scope, and account it
+ * to the zone with the given name. The name must be a string literal.
+ */
+#define PROFILE_ZONE(name) \
+	static Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__) = { name, -1 }; \
+	Common::ProfileScope PROFILE_ZONE_CONCAT(profileScope, __LINE__)(PROFILE_ZONE_CONCAT(profileZone, __LINE__))
+
+#endif
@@ -39,6 +39,51 @@ SeekableReadStream *ReadStream::readStream(uint32 dataSize) {
 	return new MemoryReadStream((byte *)buf, dataSize, DisposeAfterUse::YES);
 }
 
+// The swap loops are kept trivial, so that compilers can turn them into
+// vector code swapping several words per instruction.
+
+static void swapBytes16(uint16 *data, uint32 count) {
+	for (uint32 i = 0; i < count; i++)
+		data[i] = SWAP_BYTES_16(data[i]);
+}
+
+static void swapBytes32(uint32 *data, uint32 count) {
+	for (uint32 i = 0; i < count; i++)
+		data[i] = SWAP_BYTES_32(data[i]);
+}
+
+uint32 ReadStream::readUint16LEArray(uint16 *dst, uint32 count) {
+	count = read(dst, count * 2) / 2;
+#ifdef SCUMM_BIG_ENDIAN
+	swapBytes16(dst, count);
+#endif
+	return count;
+}
+
+uint32 ReadStream::readUint32LEArray(uint32 *dst, uint32 count) {
+	count = read(dst, count * 4) / 4;
+#ifdef SCUMM_BIG_ENDIAN
+	swapBytes32(dst, count);
+#endif
+	return count;
+}
+
+uint32 ReadStream::readUint16BEArray(uint16 *dst, uint32 count) {
+	count = read(dst, count * 2) / 2;
+#ifdef SCUMM_LITTLE_ENDIAN
+	swapBytes16(dst, count);
+#endif
+	return count;
+}
+
+uint32 ReadStream::readUint32BEArray(uint32 *dst, uint32 count) {
+	count = read(dst, count * 4) / 4;
+#ifdef SCUMM_LITTLE_ENDIAN
+	swapBytes32(dst, count);
+#endif
+	return count;
+}
+
 
 uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	// Read at most as many bytes as are still available...
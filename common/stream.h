@@ -311,6 +311,55 @@ public:
 		return (int32)readUint32BE();
 	}
 
+	/**
+	 * Read an array of unsigned 16-bit words stored in little endian
+	 * (LSB first) order from the stream. All words are read at once, which
+	 * is much faster than calling readUint16LE() for each of them.
+	 * The values of words which could not be read are undefined.
+	 *
+	 * @param dst	pointer to the array receiving the words
+	 * @param count	number of words to read
+	 * @return the number of words which were actually read.
+	 */
+	uint32 readUint16LEArray(uint16 *dst, uint32 count);
+
+	/**
+	 * Read an array of unsigned 32-bit words stored in little endian
+	 * (LSB first) order from the stream.
+	 * @see readUint16LEArray
+	 */
+	uint32 readUint32LEArray(uint32 *dst, uint32 count);
+
+	/**
+	 * Read an array of unsigned 16-bit words stored in big endian
+	 * (MSB first) order from the stream.
+	 * @see readUint16LEArray
+	 */
+	uint32 readUint16BEArray(uint16 *dst, uint32 count);
+
+	/**
+	 * Read an array of unsigned 32-bit words stored in big endian
+	 * (MSB first) order from the stream.
+	 * @see readUint16LEArray
+	 */
+	uint32 readUint32BEArray(uint32 *dst, uint32 count);
+
+	FORCEINLINE uint32 readSint16LEArray(int16 *dst, uint32 count) {
+		return readUint16LEArray((uint16 *)dst, count);
+	}
+
+	FORCEINLINE uint32 readSint32LEArray(int32 *dst, uint32 count) {
+		return readUint32LEArray((uint32 *)dst, count);
+	}
+
+	FORCEINLINE uint32 readSint16BEArray(int16 *dst, uint32 count) {
+		return readUint16BEArray((uint16 *)dst, count);
+	}
+
+	FORCEINLINE uint32 readSint32BEArray(int32 *dst, uint32 count) {
+		return readUint32BEArray((uint32 *)dst, count);
+	}
+
 	/**
 	 * Read the specified amount of data into a malloc'ed buffer
 	 * which then is wrapped into a MemoryReadStream.
@@ -371,6 +420,20 @@ public:
 	 */
 	virtual bool skip(uint32 offset) { return seek(offset, SEEK_CUR); }
 
+	/**
+	 * Return a pointer to the next bytes of the stream, without reading
+	 * them. This allows parsing data directly from streams which are kept
+	 * in memory, instead of copying it first. Use skip() afterwards to
+	 * move past the data.
+	 *
+	 * The pointer stays valid until the stream is deleted.
+	 *
+	 * @param size	number of bytes which will be accessed
+	 * @return a pointer to the data, or 0 if the stream is not kept in
+	 *         memory or has less than size bytes left.
+	 */
+	virtual const byte *peekBuffer(uint32 size) { return 0; }
+
 	/**
 	 * Reads at most one less than the number of characters specified
 	 * by bufSize from the and stores them in the string buf. Reading
@@ -910,6 +910,16 @@ public:
 	/** Get the number of milliseconds since the program was started. */
 	virtual uint32 getMillis() = 0;
 
+	/**
+	 * Get the number of microseconds since an unspecified point in time.
+	 * This is only meant for measuring short intervals, as it wraps around
+	 * after about 71 minutes.
+	 *
+	 * The default implementation is based on getMillis(), backends with a
+	 * more precise clock should override it.
+	 */
+	virtual uint32 getMicros() { return getMillis() * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
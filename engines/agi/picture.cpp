@@ -41,6 +41,12 @@ PictureMgr::PictureMgr(AgiBase *agi, GfxMgr *gfx) {
 	_minCommand = 0xf0;
 	_flags = 0;
 	_currentStep = 0;
+
+	memset(_fillMatch, 0, sizeof(_fillMatch));
+}
+
+PictureMgr::~PictureMgr() {
+	purgePictureCache();
 }
 
 void PictureMgr::putVirtPixel(int x, int y) {
@@ -228,26 +234,36 @@ void PictureMgr::absoluteDrawLine() {
 ** okToFill
 **************************************************************************/
 int PictureMgr::isOkFillHere(int x, int y) {
-	uint8 p;
-
 	x += _xOffset;
 	y += _yOffset;
 
 	if (x < 0 || x >= _width || y < 0 || y >= _height)
 		return false;
 
-	p = _vm->_game.sbuf16c[y * _width + x];
-
-	if (_flags & kPicFTrollMode)
-		return ((p & 0x0f) != 11 && (p & 0x0f) != _scrColor);
-
-	if (!_priOn && _scrOn && _scrColor != 15)
-		return (p & 0x0f) == 15;
-
-	if (_priOn && !_scrOn && _priColor != 4)
-		return (p >> 4) == 4;
+	return _fillMatch[_vm->_game.sbuf16c[y * _width + x]];
+}
 
-	return (_scrOn && (p & 0x0f) == 15 && _scrColor != 15);
+/**
+ * Decide for every possible screen buffer byte, whether the current fill
+ * may paint over it. This only depends on the drawing state, which doesn't
+ * change during a fill.
+ */
+void PictureMgr::initFillMatch() {
+	for (int i = 0; i < 256; i++) {
+		const uint8 p = i;
+		bool match;
+
+		if (_flags & kPicFTrollMode)
+			match = ((p & 0x0f) != 11 && (p & 0x0f) != _scrColor);
+		else if (!_priOn && _scrOn && _scrColor != 15)
+			match = (p & 0x0f) == 15;
+		else if (_priOn && !_scrOn && _priColor != 4)
+			match = (p >> 4) == 4;
+		else
+			match = (_scrOn && (p & 0x0f) == 15 && _scrColor != 15);
+
+		_fillMatch[i] = match;
+	}
 }
 
 /**************************************************************************
@@ -257,6 +273,8 @@ void PictureMgr::agiFill(unsigned int x, unsigned int y) {
 	if (!_scrOn && !_priOn)
 		return;
 
+	initFillMatch();
+
 	// Push initial pixel on the stack
 	Common::Stack<Common::Point> stack;
 	stack.push(Common::Point(x,y));
@@ -264,19 +282,26 @@ void PictureMgr::agiFill(unsigned int x, unsigned int y) {
 	// Exit if stack is empty
 	while (!stack.empty()) {
 		Common::Point p = stack.pop();
-		unsigned int c;
+		int left, right, c;
 		int newspanUp, newspanDown;
 
 		if (!isOkFillHere(p.x, p.y))
 			continue;
 
-		// Scan for left border
-		for (c = p.x - 1; isOkFillHere(c, p.y); c--)
+		// Scan for the borders of the span. Filling a pixel doesn't change
+		// whether its neighbours on the same line can be filled, so the
+		// whole span gets filled afterwards.
+		for (left = p.x; isOkFillHere(left - 1, p.y); left--)
+			;
+		for (right = p.x; isOkFillHere(right + 1, p.y); right++)
 			;
 
-		newspanUp = newspanDown = 1;
-		for (c++; isOkFillHere(c, p.y); c++) {
+		for (c = left; c <= right; c++)
 			putVirtPixel(c, p.y);
+
+		// Look for spans to fill on the lines above and below
+		newspanUp = newspanDown = 1;
+		for (c = left; c <= right; c++) {
 			if (isOkFillHere(c, p.y - 1)) {
 				if (newspanUp) {
 					stack.push(Common::Point(c,p.y-1));
@@ -824,7 +849,36 @@ int PictureMgr::decodePicture(int n, int clr, bool agi256, int pic_width, int pi
 		memset(_vm->_game.sbuf16c, 0x4f, _width * _height); // Clear 16 color AGI screen (Priority 4, color white).
 
 	if (!agi256) {
-		drawPicture(); // Draw 16 color picture.
+		// Drawing onto a cleared screen always gives the same result, so
+		// these pictures are only drawn once
+		const bool cacheable = clr && !_flags && !_xOffset && !_yOffset
+				&& _width == _DEFAULT_WIDTH && _height == _DEFAULT_HEIGHT;
+		const uint32 screenSize = _width * _height;
+
+		PictureCache::iterator cached = _cache.find(n);
+		if (cacheable && cached != _cache.end() && cached->_value.dataSize == _flen
+				&& !memcmp(cached->_value.data, _data, _flen)) {
+			memcpy(_vm->_game.sbuf16c, cached->_value.screen, screenSize);
+		} else {
+			drawPicture(); // Draw 16 color picture.
+
+			if (cacheable) {
+				if (cached != _cache.end()) {
+					free(cached->_value.data);
+					free(cached->_value.screen);
+					_cache.erase(cached);
+				} else if (_cache.size() >= MAX_CACHED_PICTURES) {
+					purgePictureCache();
+				}
+
+				PictureCacheEntry &entry = _cache[n];
+				entry.data = (uint8 *)malloc(_flen);
+				entry.dataSize = _flen;
+				entry.screen = (uint8 *)malloc(screenSize);
+				memcpy(entry.data, _data, _flen);
+				memcpy(entry.screen, _vm->_game.sbuf16c, screenSize);
+			}
+		}
 	} else {
 		const uint32 maxFlen = _width * _height;
 		memcpy(_vm->_game.sbuf256c, _data, MIN(_flen, maxFlen)); // Draw 256 color picture.
@@ -890,6 +944,15 @@ int PictureMgr::unloadPicture(int n) {
 	return errOK;
 }
 
+void PictureMgr::purgePictureCache() {
+	for (PictureCache::iterator iter = _cache.begin(); iter != _cache.end(); ++iter) {
+		free(iter->_value.data);
+		free(iter->_value.screen);
+	}
+
+	_cache.clear();
+}
+
 void PictureMgr::clear() {
 	memset(_vm->_game.sbuf16c, 0x4f, _width * _height);
 }
@@ -23,6 +23,8 @@
 #ifndef AGI_PICTURE_H
 #define AGI_PICTURE_H
 
+#include "common/hashmap.h"
+
 namespace Agi {
 
 #define _DEFAULT_WIDTH		160
@@ -56,6 +58,21 @@ enum AgiPictureFlags {
 class AgiBase;
 class GfxMgr;
 
+/**
+ * A decoded picture, along with a copy of the vector data it was decoded
+ * from. The data is compared on lookup, so that a picture resource, which
+ * changed in the meantime, gets drawn again.
+ */
+struct PictureCacheEntry {
+	uint8 *data;
+	uint32 dataSize;
+	uint8 *screen;		/**< 16 color screen buffer after drawing the picture */
+};
+
+typedef Common::HashMap<int, PictureCacheEntry> PictureCache;
+
+#define MAX_CACHED_PICTURES 32
+
 class PictureMgr {
 	AgiBase *_vm;
 	GfxMgr *_gfx;
@@ -66,6 +83,7 @@ private:
 	void dynamicDrawLine();
 	void absoluteDrawLine();
 	int isOkFillHere(int x, int y);
+	void initFillMatch();
 	void agiFill(unsigned int x, unsigned int y);
 	void xCorner(bool skipOtherCoords = false);
 	void yCorner(bool skipOtherCoords = false);
@@ -77,12 +95,14 @@ private:
 
 public:
 	PictureMgr(AgiBase *agi, GfxMgr *gfx);
+	~PictureMgr();
 
 	void putVirtPixel(int x, int y);
 
 	int decodePicture(int n, int clear, bool agi256 = false, int pic_width = _DEFAULT_WIDTH, int pic_height = _DEFAULT_HEIGHT);
 	int decodePicture(byte* data, uint32 length, int clear, int pic_width = _DEFAULT_WIDTH, int pic_height = _DEFAULT_HEIGHT);
 	int unloadPicture(int);
+	void purgePictureCache();
 	void drawPicture();
 	void showPic(int x = 0, int y = 0, int pic_width = _DEFAULT_WIDTH, int pic_height = _DEFAULT_HEIGHT);
 	uint8 *convertV3Pic(uint8 *src, uint32 len);
@@ -137,6 +157,10 @@ private:
 
 	int _flags;
 	int _currentStep;
+
+	bool _fillMatch[256];	/**< Which screen buffer bytes the current fill may paint over */
+
+	PictureCache _cache;
 };
 
 } // End of namespace Agi
@@ -27,6 +27,7 @@
 #include "common/util.h"
 #include "common/frac.h"
 
+#include "graphics/conversion.h"
 #include "graphics/primitives.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
@@ -446,23 +447,9 @@ void Surface::blit(const Surface &from, int16 left, int16 top, int16 right, int1
 		return;
 	}
 
-	// Otherwise, we have to copy by pixel
-
-	// Pointers to the blit destination and source start points
-	     Pixel dst =      get(x   , y);
-	ConstPixel src = from.get(left, top);
-
-	while (height-- > 0) {
-		     Pixel dstRow = dst;
-		ConstPixel srcRow = src;
-
-		for (uint16 i = 0; i < width; i++, dstRow++, srcRow++)
-			if (srcRow.get() != ((uint32) transp))
-				dstRow.set(srcRow.get());
-
-		dst +=      _width;
-		src += from._width;
-	}
+	// Otherwise, we have to leave out the transparent pixels
+	Graphics::keyBlit(getData(x, y), from.getData(left, top), _width * _bpp, from._width * from._bpp,
+			width, height, _bpp, (uint32) transp);
 }
 
 void Surface::blit(const Surface &from, int16 x, int16 y, int32 transp) {
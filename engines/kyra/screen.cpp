@@ -48,6 +48,7 @@ Screen::Screen(KyraEngine_v1 *vm, OSystem *system, const ScreenDim *dimTable, co
 	_drawShapeVar4 = 0;
 	_drawShapeVar5 = 0;
 
+	_shapeFrameCacheSize = 0;
 	memset(_fonts, 0, sizeof(_fonts));
 
 	memset(_pagePtrs, 0, sizeof(_pagePtrs));
@@ -77,6 +78,7 @@ Screen::~Screen() {
 	delete _internFadePalette;
 	delete[] _decodeShapeBuffer;
 	delete[] _animBlockPtr;
+	clearShapeFrameCache();
 
 	for (uint i = 0; i < _palettes.size(); ++i)
 		delete _palettes[i];
@@ -1461,69 +1463,71 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		&Screen::drawShapeSkipScaleDownwind
 	};
 
-	static const DsLineFunc dsLineFunc[] = {
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind
+#define DS_LINE_FUNCS(plot) { \
+		&Screen::drawShapeProcessLineNoScaleUpwind<&Screen::plot>, \
+		&Screen::drawShapeProcessLineNoScaleDownwind<&Screen::plot>, \
+		&Screen::drawShapeProcessLineScaleUpwind<&Screen::plot>, \
+		&Screen::drawShapeProcessLineScaleDownwind<&Screen::plot> }
+#define DS_NO_LINE_FUNCS { 0, 0, 0, 0 }
+
+	// The line functions for each plot type: unscaled and scaled, upwind
+	// and downwind
+	static const DsLineFunc dsLineFunc[][4] = {
+		DS_LINE_FUNCS(drawShapePlotType0),		// used by Kyra 1 + 2
+		DS_LINE_FUNCS(drawShapePlotType1),		// used by Kyra 3
+		DS_NO_LINE_FUNCS,
+		DS_LINE_FUNCS(drawShapePlotType3_7),	// used by Kyra 3 (shadow)
+		DS_LINE_FUNCS(drawShapePlotType4),		// used by Kyra 1, 2 + 3
+		DS_LINE_FUNCS(drawShapePlotType5),		// used by Kyra 1
+		DS_LINE_FUNCS(drawShapePlotType6),		// used by Kyra 1 (invisibility)
+		DS_LINE_FUNCS(drawShapePlotType3_7),	// used by Kyra 1 (invisibility)
+		DS_LINE_FUNCS(drawShapePlotType8),		// used by Kyra 2
+		DS_LINE_FUNCS(drawShapePlotType9),		// used by Kyra 1 + 3
+		DS_NO_LINE_FUNCS,
+		DS_LINE_FUNCS(drawShapePlotType11_15),	// used by Kyra 1 (invisibility) + Kyra 3 (shadow)
+		DS_LINE_FUNCS(drawShapePlotType12),		// used by Kyra 2
+		DS_LINE_FUNCS(drawShapePlotType13),		// used by Kyra 1
+		DS_LINE_FUNCS(drawShapePlotType14),		// used by Kyra 1 (invisibility)
+		DS_LINE_FUNCS(drawShapePlotType11_15),	// used by Kyra 1 (invisibility)
+		DS_LINE_FUNCS(drawShapePlotType16),		// used by LoL PC-98/16 Colors (teleporters),
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_LINE_FUNCS(drawShapePlotType20),		// used by LoL (heal spell effect)
+		DS_LINE_FUNCS(drawShapePlotType21),		// used by LoL (white tower spirits)
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_NO_LINE_FUNCS,
+		DS_LINE_FUNCS(drawShapePlotType33),		// used by LoL (blood spots on the floor)
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_LINE_FUNCS(drawShapePlotType37),		// used by LoL (monsters)
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_LINE_FUNCS(drawShapePlotType48),		// used by LoL (slime spots on the floor)
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_LINE_FUNCS(drawShapePlotType52),		// used by LoL (projectiles)
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS, DS_NO_LINE_FUNCS,
+		DS_NO_LINE_FUNCS
 	};
 
-	static const DsPlotFunc dsPlotFunc[] = {
-		&Screen::drawShapePlotType0,		// used by Kyra 1 + 2
-		&Screen::drawShapePlotType1,		// used by Kyra 3
-		0,
-		&Screen::drawShapePlotType3_7,		// used by Kyra 3 (shadow)
-		&Screen::drawShapePlotType4,		// used by Kyra 1, 2 + 3
-		&Screen::drawShapePlotType5,		// used by Kyra 1
-		&Screen::drawShapePlotType6,		// used by Kyra 1 (invisibility)
-		&Screen::drawShapePlotType3_7,		// used by Kyra 1 (invisibility)
-		&Screen::drawShapePlotType8,		// used by Kyra 2
-		&Screen::drawShapePlotType9,		// used by Kyra 1 + 3
-		0,
-		&Screen::drawShapePlotType11_15,	// used by Kyra 1 (invisibility) + Kyra 3 (shadow)
-		&Screen::drawShapePlotType12,		// used by Kyra 2
-		&Screen::drawShapePlotType13,		// used by Kyra 1
-		&Screen::drawShapePlotType14,		// used by Kyra 1 (invisibility)
-		&Screen::drawShapePlotType11_15,	// used by Kyra 1 (invisibility)
-		&Screen::drawShapePlotType16,		// used by LoL PC-98/16 Colors (teleporters),
-		0, 0, 0,
-		&Screen::drawShapePlotType20,		// used by LoL (heal spell effect)
-		&Screen::drawShapePlotType21,		// used by LoL (white tower spirits)
-		0, 0, 0, 0,	0, 0, 0, 0, 0, 0,
-		0,
-		&Screen::drawShapePlotType33,		// used by LoL (blood spots on the floor)
-		0, 0, 0,
-		&Screen::drawShapePlotType37,		// used by LoL (monsters)
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		&Screen::drawShapePlotType48,		// used by LoL (slime spots on the floor)
-		0, 0, 0,
-		&Screen::drawShapePlotType52,		// used by LoL (projectiles)
-		0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-		0
-	};
+#undef DS_LINE_FUNCS
+#undef DS_NO_LINE_FUNCS
 
 	int scaleCounterV = 0;
 
 	const int drawFunc = flags & 0x0f;
 	_dsProcessMargin = dsMarginFunc[drawFunc];
 	_dsScaleSkip = dsSkipFunc[drawFunc];
-	_dsProcessLine = dsLineFunc[drawFunc];
 
+	const int lineFunc = (drawFunc & 1) | ((drawFunc & 4) >> 1);
 	const int ppc = (flags >> 8) & 0x3F;
-	_dsPlot = dsPlotFunc[ppc];
-	DsPlotFunc dsPlot2 = dsPlotFunc[ppc], dsPlot3 = dsPlotFunc[ppc];
-	if (flags & 0x800)
-		dsPlot3 = dsPlotFunc[((flags >> 8) & 0xF7) & 0x3F];
+	const int ppc3 = (flags & 0x800) ? (((flags >> 8) & 0xF7) & 0x3F) : ppc;
+	DsLineFunc dsLine2 = dsLineFunc[ppc][lineFunc], dsLine3 = dsLineFunc[ppc3][lineFunc];
 
-	if (!_dsPlot || !dsPlot2 || !dsPlot3) {
-		if (!dsPlot2)
+	if (!dsLine2 || !dsLine3) {
+		if (!dsLine2)
 			warning("Missing drawShape plotting method type %d", ppc);
-		if (dsPlot3 != dsPlot2 && !dsPlot3)
-			warning("Missing drawShape plotting method type %d", (((flags >> 8) & 0xF7) & 0x3F));
+		if (ppc3 != ppc && !dsLine3)
+			warning("Missing drawShape plotting method type %d", ppc3);
 		return;
 	}
 
@@ -1577,10 +1581,8 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	if (flags & 0x400)
 		src += colorTableColors;
 
-	if (!(shapeFlags & 2)) {
-		decodeFrame4(src, _animBlockPtr, frameSize);
-		src = _animBlockPtr;
-	}
+	if (!(shapeFlags & 2))
+		src = decodeShapeFrame(shapeData, src, frameSize);
 
 	int t = (flags & 2) ? y2 - y - shapeHeight : y - y1;
 
@@ -1705,7 +1707,7 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 				if (cnt > 0) {
 					if (flags & 0x800)
 						normalPlot = (curY > _maskMinY && curY < _maskMaxY);
-					_dsPlot = normalPlot ? dsPlot2 : dsPlot3;
+					_dsProcessLine = normalPlot ? dsLine2 : dsLine3;
 					(this->*_dsProcessLine)(d, src, cnt, scaleState);
 				}
 				cnt += _dsOffscreenRight;
@@ -1834,12 +1836,13 @@ int Screen::drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt)
 	return found ? 0 : _dsOffscreenScaleVal1;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
 	do {
 		uint8 c = *src++;
 		if (c) {
 			uint8 *d = dst++;
-			(this->*_dsPlot)(d, c);
+			(this->*plot)(d, c);
 			cnt--;
 		} else {
 			c = *src++;
@@ -1849,12 +1852,13 @@ void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, i
 	} while (cnt > 0);
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
 	do {
 		uint8 c = *src++;
 		if (c) {
 			uint8 *d = dst--;
-			(this->*_dsPlot)(d, c);
+			(this->*plot)(d, c);
 			cnt--;
 		} else {
 			c = *src++;
@@ -1864,6 +1868,7 @@ void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src,
 	} while (cnt > 0);
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -1883,7 +1888,7 @@ void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int
 				scaleState = r & 0xff;
 			}
 		} else if (scaleState) {
-			(this->*_dsPlot)(dst++, c);
+			(this->*plot)(dst++, c);
 			scaleState -= 0x100;
 			cnt--;
 		}
@@ -1892,6 +1897,7 @@ void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int
 	cnt = -1;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -1911,7 +1917,7 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, i
 				scaleState = r & 0xff;
 			}
 		} else {
-			(this->*_dsPlot)(dst--, c);
+			(this->*plot)(dst--, c);
 			scaleState -= 0x100;
 			cnt--;
 		}
@@ -1920,6 +1926,61 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, i
 	cnt = -1;
 }
 
+const uint8 *Screen::decodeShapeFrame(const uint8 *shapeData, const uint8 *src, uint16 frameSize) {
+	if (frameSize > kMaxCachedShapeFrameSize) {
+		decodeFrame4(src, _animBlockPtr, frameSize);
+		return _animBlockPtr;
+	}
+
+	ShapeFrameCache::iterator it = _shapeFrameCache.find(shapeData);
+	if (it != _shapeFrameCache.end()) {
+		// The compressed data is only read once the header matches, which
+		// holds the size of the shape
+		const ShapeFrameCacheEntry &entry = it->_value;
+		if (entry.frameSize == frameSize && !memcmp(entry.header, shapeData, sizeof(entry.header))
+				&& entry.checksum == getShapeDataChecksum(src, entry.dataSize))
+			return entry.frame;
+
+		_shapeFrameCacheSize -= it->_value.frameSize;
+		delete[] it->_value.frame;
+		_shapeFrameCache.erase(it);
+	}
+
+	if (_shapeFrameCacheSize + frameSize > kMaxShapeFrameCacheSize)
+		clearShapeFrameCache();
+
+	ShapeFrameCacheEntry &entry = _shapeFrameCache[shapeData];
+	memcpy(entry.header, shapeData, sizeof(entry.header));
+	entry.frame = new uint8[frameSize];
+	entry.frameSize = frameSize;
+	decodeFrame4(src, entry.frame, frameSize, &entry.dataSize);
+	entry.checksum = getShapeDataChecksum(src, entry.dataSize);
+	_shapeFrameCacheSize += frameSize;
+
+	return entry.frame;
+}
+
+uint32 Screen::getShapeDataChecksum(const uint8 *data, uint32 size) {
+	// Two running sums, like Adler-32 without the modulo
+	uint32 a = 1, b = 0;
+	for (; size >= 4; size -= 4, data += 4) {
+		a += READ_UINT32(data);
+		b += a;
+	}
+	while (size--) {
+		a += *data++;
+		b += a;
+	}
+	return a ^ ((b << 16) | (b >> 16));
+}
+
+void Screen::clearShapeFrameCache() {
+	for (ShapeFrameCache::iterator it = _shapeFrameCache.begin(); it != _shapeFrameCache.end(); ++it)
+		delete[] it->_value.frame;
+	_shapeFrameCache.clear();
+	_shapeFrameCacheSize = 0;
+}
+
 void Screen::drawShapePlotType0(uint8 *dst, uint8 cmd) {
 	*dst = cmd;
 }
@@ -2223,7 +2284,8 @@ void Screen::decodeFrame3(const uint8 *src, uint8 *dst, uint32 size) {
 	}
 }
 
-uint Screen::decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize) {
+uint Screen::decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize, uint32 *srcSize) {
+	const uint8 *srcOrig = src;
 	uint8 *dstOrig = dst;
 	uint8 *dstEnd = dst + dstSize;
 	while (1) {
@@ -2269,6 +2331,9 @@ uint Screen::decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize) {
 			break;
 		}
 	}
+
+	if (srcSize)
+		*srcSize = src - srcOrig;
 	return dst - dstOrig;
 }
 
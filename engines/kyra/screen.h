@@ -25,6 +25,7 @@
 
 #include "common/util.h"
 #include "common/func.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/array.h"
 #include "common/rect.h"
@@ -538,7 +539,7 @@ public:
 	static uint16 decodeEGAGetCode(const uint8 *&pos, uint8 &nib);
 
 	static void decodeFrame3(const uint8 *src, uint8 *dst, uint32 size);
-	static uint decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize);
+	static uint decodeFrame4(const uint8 *src, uint8 *dst, uint32 dstSize, uint32 *srcSize = 0);
 	static void decodeFrameDelta(uint8 *dst, const uint8 *src, bool noXor = false);
 	static void decodeFrameDeltaPage(uint8 *dst, const uint8 *src, const int pitch, bool noXor);
 
@@ -626,16 +627,23 @@ protected:
 	KyraEngine_v1 *_vm;
 
 	// shape
+	typedef int (Screen::*DsMarginSkipFunc)(uint8 *&dst, const uint8 *&src, int &cnt);
+	typedef void (Screen::*DsLineFunc)(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	typedef void (Screen::*DsPlotFunc)(uint8 *dst, uint8 cmd);
+
 	int drawShapeMarginNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeMarginNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeMarginScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeMarginScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeSkipScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
-	void drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+
+	// The line functions are instantiated for every plot function, so
+	// that the compiler can inline it.
+	template<DsPlotFunc plot> void drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<DsPlotFunc plot> void drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<DsPlotFunc plot> void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<DsPlotFunc plot> void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
 
 	void drawShapePlotType0(uint8 *dst, uint8 cmd);
 	void drawShapePlotType1(uint8 *dst, uint8 cmd);
@@ -657,14 +665,9 @@ protected:
 	void drawShapePlotType48(uint8 *dst, uint8 cmd);
 	void drawShapePlotType52(uint8 *dst, uint8 cmd);
 
-	typedef int (Screen::*DsMarginSkipFunc)(uint8 *&dst, const uint8 *&src, int &cnt);
-	typedef void (Screen::*DsLineFunc)(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	typedef void (Screen::*DsPlotFunc)(uint8 *dst, uint8 cmd);
-
 	DsMarginSkipFunc _dsProcessMargin;
 	DsMarginSkipFunc _dsScaleSkip;
 	DsLineFunc _dsProcessLine;
-	DsPlotFunc _dsPlot;
 
 	const uint8 *_dsTable;
 	int _dsTableLoopCount;
@@ -686,6 +689,36 @@ protected:
 	int _drawShapeVar4;
 	int _drawShapeVar5;
 
+	// Decoded frames of compressed shapes, keyed by the address of the
+	// shape. Shapes are freed and others loaded at the same address, or
+	// changed in place, so a frame is only used while the header and the
+	// size and checksum of the compressed data still match.
+	struct ShapeFrameCacheEntry {
+		uint8 header[10];
+		uint32 dataSize;
+		uint32 checksum;
+		uint8 *frame;
+		uint16 frameSize;
+	};
+
+	struct ShapeFrameHash {
+		uint operator()(const uint8 *shapeData) const { return (uint)((size_t)shapeData >> 2); }
+	};
+
+	typedef Common::HashMap<const uint8 *, ShapeFrameCacheEntry, ShapeFrameHash> ShapeFrameCache;
+
+	enum {
+		kMaxShapeFrameCacheSize = 1024 * 1024,
+		kMaxCachedShapeFrameSize = 16384
+	};
+
+	ShapeFrameCache _shapeFrameCache;
+	uint32 _shapeFrameCacheSize;
+
+	const uint8 *decodeShapeFrame(const uint8 *shapeData, const uint8 *src, uint16 frameSize);
+	void clearShapeFrameCache();
+	static uint32 getShapeDataChecksum(const uint8 *data, uint32 size);
+
 	// AMIGA version
 	bool _interfacePaletteEnabled;
 
@@ -39,9 +39,7 @@ bool StaticResource::loadRawDataBe16(Common::SeekableReadStream &stream, void *&
 	size = stream.size() >> 1;
 
 	uint16 *r = new uint16[size];
-
-	for (int i = 0; i < size; i++)
-		r[i] = stream.readUint16BE();
+	stream.readUint16BEArray(r, size);
 
 	ptr = r;
 	return true;
@@ -51,9 +49,7 @@ bool StaticResource::loadRawDataBe32(Common::SeekableReadStream &stream, void *&
 	size = stream.size() >> 2;
 
 	uint32 *r = new uint32[size];
-
-	for (int i = 0; i < size; i++)
-		r[i] = stream.readUint32BE();
+	stream.readUint32BEArray(r, size);
 
 	ptr = r;
 	return true;
@@ -122,6 +122,7 @@ MohawkSurface *MystGraphics::decodeImage(uint16 id) {
 				if (_pictureFile.entries[i].type == 0) {
 					Graphics::JPEGDecoder jpeg;
 					Common::SeekableSubReadStream subStream(&_pictureFile.picFile, _pictureFile.entries[i].offset, _pictureFile.entries[i].offset + _pictureFile.entries[i].size);
+					jpeg.setOutputPixelFormat(_pixelFormat);
 
 					if (!jpeg.loadStream(subStream))
 						error("Could not decode Myst ME Mac JPEG");
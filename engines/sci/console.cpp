@@ -54,6 +54,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "video/coktel_decoder.h"
+#include "sci/graphics/frameout.h"
 #include "sci/video/robot_decoder.h"
 #endif
 
@@ -133,6 +134,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("wl",                 WRAP_METHOD(Console, cmdWindowList));	// alias
 	DCmd_Register("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	DCmd_Register("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	DCmd_Register("frameout_rects",     WRAP_METHOD(Console, cmdFrameoutRects));
+	DCmd_Register("view_cache",         WRAP_METHOD(Console, cmdViewCache));
 	// Segments
 	DCmd_Register("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	DCmd_Register("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -146,6 +149,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	DCmd_Register("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	DCmd_Register("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	DCmd_Register("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	DCmd_Register("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	DCmd_Register("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -201,6 +205,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	DCmd_Register("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	DCmd_Register("vm_dispatch",		WRAP_METHOD(Console, cmdVMDispatch));
 	DCmd_Register("vm_varlist",			WRAP_METHOD(Console, cmdVMVarlist));
 	DCmd_Register("vmvarlist",			WRAP_METHOD(Console, cmdVMVarlist));				// alias
 	DCmd_Register("vl",					WRAP_METHOD(Console, cmdVMVarlist));				// alias
@@ -368,6 +373,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" animate_object_list / al - Shows the current list of objects in kAnimate's draw list\n");
 	DebugPrintf(" saved_bits - List saved bits on the hunk\n");
 	DebugPrintf(" show_saved_bits - Display saved bits\n");
+	DebugPrintf(" frameout_rects - Shows the parts of the screen which the last kFrameout call changed\n");
+	DebugPrintf(" view_cache - Shows statistics of the view, decoded cel and picture caches\n");
 	DebugPrintf("\n");
 	DebugPrintf("Segments:\n");
 	DebugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -380,6 +387,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	DebugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	DebugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	DebugPrintf(" gc_stats - Shows garbage collector pause statistics\n");
 	DebugPrintf("\n");
 	DebugPrintf("Music/SFX:\n");
 	DebugPrintf(" songlib - Shows the song library\n");
@@ -421,6 +429,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf("\n");
 	DebugPrintf("VM:\n");
 	DebugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	DebugPrintf(" vm_dispatch - Shows or changes how the VM dispatches opcodes\n");
 	DebugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	DebugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	DebugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -1769,6 +1778,23 @@ bool Console::cmdShowSavedBits(int argc, const char **argv) {
 }
 
 
+bool Console::cmdFrameoutRects(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (_engine->_gfxFrameout) {
+		_engine->_gfxFrameout->printChangedRects(this);
+		return true;
+	}
+#endif
+
+	DebugPrintf("This SCI version does not use kFrameout\n");
+	return true;
+}
+
+bool Console::cmdViewCache(int argc, const char **argv) {
+	_engine->_gfxCache->printViewCacheStats(this);
+	return true;
+}
+
 bool Console::cmdParseGrammar(int argc, const char **argv) {
 	DebugPrintf("Parse grammar, in strict GNF:\n");
 
@@ -2269,6 +2295,20 @@ bool Console::cmdGCNormalize(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	const GCStatistics &stats = _engine->_gamestate->gcStats;
+
+	DebugPrintf("Collections: %d, incremental steps: %d (interval: %d kernel calls)\n",
+			stats.runs, stats.steps, _engine->_gamestate->scriptGCInterval);
+	DebugPrintf("Incremental collection: %s, %d steps\n",
+			_engine->_gamestate->_segMan->getGCWorklist() ? "in progress" : "finished", stats.lastSteps);
+	DebugPrintf("Pause: last %d us, max %d us, average per collection %d us\n",
+			stats.lastPause, stats.maxPause, stats.runs ? stats.totalPause / stats.runs : 0);
+	DebugPrintf("Freed objects: last %d, total %d\n", stats.lastFreed, stats.totalFreed);
+
+	return true;
+}
+
 bool Console::cmdVMVarlist(int argc, const char **argv) {
 	EngineState *s = _engine->_gamestate;
 	const char *varnames[] = {"global", "local", "temp", "param"};
@@ -2637,6 +2677,47 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMDispatch(int argc, const char **argv) {
+	VMDispatchState &dispatch = _engine->_gamestate->vmDispatch;
+
+	if (argc == 3) {
+		bool enable;
+		if (strcmp(argv[2], "on") == 0)
+			enable = true;
+		else if (strcmp(argv[2], "off") == 0)
+			enable = false;
+		else {
+			DebugPrintf("2nd parameter must be either on or off\n");
+			return true;
+		}
+
+		if (!scumm_stricmp(argv[1], "threaded"))
+			dispatch.threaded = enable;
+		else if (!scumm_stricmp(argv[1], "fuse"))
+			dispatch.fuseOpcodes = enable;
+		else if (!scumm_stricmp(argv[1], "validate"))
+			dispatch.validate = enable;
+		else {
+			DebugPrintf("1st parameter must be threaded, fuse or validate\n");
+			return true;
+		}
+	} else if (argc != 1) {
+		DebugPrintf("Shows or changes how the VM dispatches opcodes.\n");
+		DebugPrintf("Usage: %s [threaded|fuse|validate <on/off>]\n", argv[0]);
+		DebugPrintf("threaded: dispatch simple opcodes directly (needs compiler support)\n");
+		DebugPrintf("fuse: execute common comparison sequences as one opcode\n");
+		DebugPrintf("validate: check fused opcodes against the plain ones\n");
+		return true;
+	}
+
+	DebugPrintf("Threaded dispatch: %s, fused opcodes: %s, validation: %s\n",
+			dispatch.threaded ? "on" : "off", dispatch.fuseOpcodes ? "on" : "off",
+			dispatch.validate ? "on" : "off");
+	DebugPrintf("Fused opcodes executed: %d, validated: %d, mismatches: %d\n",
+			dispatch.fusedCount, dispatch.validatedCount, dispatch.mismatchCount);
+	return true;
+}
+
 bool Console::cmdBacktrace(int argc, const char **argv) {
 	DebugPrintf("Call stack (current base: 0x%x):\n", _engine->_gamestate->executionStackBase);
 	Common::List<ExecStack>::const_iterator iter;
@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 namespace Sci {
@@ -64,6 +65,30 @@ void WorklistManager::pushArray(const Common::Array<reg_t> &tmp) {
 		push(*it);
 }
 
+void WorklistManager::pushAllocated(reg_t reg) {
+	debugC(kDebugLevelGC, "[GC] Adding new object %04x:%04x", PRINT_REG(reg));
+
+	_map.setVal(reg, true);
+	_worklist.push_back(reg);
+}
+
+void WorklistManager::discardSegment(SegmentId seg) {
+	Common::Array<reg_t> discarded;
+	for (AddrSet::const_iterator i = _map.begin(); i != _map.end(); ++i) {
+		if (i->_key.segment == seg)
+			discarded.push_back(i->_key);
+	}
+	for (Common::Array<reg_t>::const_iterator it = discarded.begin(); it != discarded.end(); ++it)
+		_map.erase(*it);
+
+	uint kept = 0;
+	for (uint i = 0; i < _worklist.size(); i++) {
+		if (_worklist[i].segment != seg)
+			_worklist[kept++] = _worklist[i];
+	}
+	_worklist.resize(kept);
+}
+
 static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_map) {
 	AddrSet *normal_map = new AddrSet();
 
@@ -80,26 +105,39 @@ static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_
 	return normal_map;
 }
 
-static void processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap) {
+/**
+ * Scans the objects in the worklist for references to further objects.
+ * @param maxObjects	the number of objects to scan at most, or 0 to empty
+ *						the worklist. An incremental collection also skips
+ *						objects which have been freed since they were added.
+ * @return true if the worklist is empty
+ */
+static bool processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap, uint maxObjects = 0) {
 	SegmentId stackSegment = segMan->findSegmentByType(SEG_TYPE_STACK);
+	uint scanned = 0;
 	while (!wm._worklist.empty()) {
+		if (maxObjects && scanned++ == maxObjects)
+			return false;
+
 		reg_t reg = wm._worklist.back();
 		wm._worklist.pop_back();
 		if (reg.segment != stackSegment) { // No need to repeat this one
 			debugC(kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
 			if (reg.segment < heap.size() && heap[reg.segment]) {
+				if (maxObjects && !heap[reg.segment]->isValidOffset(reg.offset))
+					continue;
+
 				// Valid heap object? Find its outgoing references!
 				wm.pushArray(heap[reg.segment]->listAllOutgoingReferences(reg));
 			}
 		}
 	}
+	return true;
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
+static void pushRoots(EngineState *s, WorklistManager &wm) {
 	assert(!s->_executionStack.empty());
 
-	WorklistManager wm;
-
 	// Initialize registers
 	wm.push(s->r_acc);
 	wm.push(s->r_prev);
@@ -152,19 +190,26 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 	debugC(kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
 
-	processWorkList(s->_segMan, wm, heap);
-
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->processEngineHunkList(wm);
+}
+
+AddrSet *findAllActiveReferences(EngineState *s) {
+	WorklistManager wm;
+
+	pushRoots(s, wm);
+	processWorkList(s->_segMan, wm, s->_segMan->getSegments());
 
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
-	SegManager *segMan = s->_segMan;
+/**
+ * Frees all deallocatable objects which are not in activeRefs.
+ * @return the number of objects freed
+ */
+static uint32 freeUnreferenced(SegManager *segMan, const AddrSet &activeRefs) {
+	uint32 freed = 0;
 
-	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
 #ifdef GC_DEBUG_CODE
 	const char *segnames[SEG_TYPE_MAX + 1];
 	int segcount[SEG_TYPE_MAX + 1];
@@ -172,9 +217,6 @@ void run_gc(EngineState *s) {
 	memset(segcount, 0, sizeof(segcount));
 #endif
 
-	// Compute the set of all segments references currently in use.
-	AddrSet *activeRefs = findAllActiveReferences(s);
-
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
 	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
@@ -192,10 +234,11 @@ void run_gc(EngineState *s) {
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
-				if (!activeRefs->contains(addr)) {
+				if (!activeRefs.contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					freed++;
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -205,8 +248,6 @@ void run_gc(EngineState *s) {
 		}
 	}
 
-	delete activeRefs;
-
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -214,6 +255,76 @@ void run_gc(EngineState *s) {
 		if (segcount[i])
 			debugC(kDebugLevelGC, "\t%d\t* %s", segcount[i], segnames[i]);
 #endif
+
+	return freed;
+}
+
+static void updateStatistics(GCStatistics &stats, uint32 pause) {
+	stats.lastPause = pause;
+	stats.maxPause = MAX(stats.maxPause, pause);
+	stats.totalPause += pause;
+}
+
+void run_gc(EngineState *s) {
+	SegManager *segMan = s->_segMan;
+	GCStatistics &stats = s->gcStats;
+	const uint32 startTime = g_system->getMicros();
+
+	// Some debug stuff
+	debugC(kDebugLevelGC, "[GC] Running...");
+
+	// A full collection supersedes an incremental one in progress
+	segMan->setGCWorklist(0);
+
+	// Compute the set of all segments references currently in use.
+	AddrSet *activeRefs = findAllActiveReferences(s);
+	const uint32 freed = freeUnreferenced(segMan, *activeRefs);
+	delete activeRefs;
+
+	updateStatistics(stats, g_system->getMicros() - startTime);
+	stats.runs++;
+	stats.lastFreed = freed;
+	stats.totalFreed += freed;
+	debugC(kDebugLevelGC, "[GC] Freed %d objects in %d us", freed, stats.lastPause);
+}
+
+bool run_gc_step(EngineState *s) {
+	SegManager *segMan = s->_segMan;
+	GCStatistics &stats = s->gcStats;
+	const uint32 startTime = g_system->getMicros();
+	WorklistManager *wm = segMan->getGCWorklist();
+	bool finished = false;
+
+	if (!wm) {
+		debugC(kDebugLevelGC, "[GC] Starting incremental collection");
+		wm = new WorklistManager();
+		pushRoots(s, *wm);
+		segMan->setGCWorklist(wm);
+		stats.lastSteps = 0;
+	} else if (processWorkList(segMan, *wm, segMan->getSegments(), kGCStepSize)) {
+		// Everything reachable from the roots at the start has been marked,
+		// and so has everything the write barrier saw stored into objects
+		// since. Scan the roots again for references which have only been
+		// kept on the stack or in the registers, then free the rest.
+		pushRoots(s, *wm);
+		processWorkList(segMan, *wm, segMan->getSegments());
+
+		AddrSet *activeRefs = normalizeAddresses(segMan, wm->_map);
+		segMan->setGCWorklist(0);
+		const uint32 freed = freeUnreferenced(segMan, *activeRefs);
+		delete activeRefs;
+
+		stats.runs++;
+		stats.lastFreed = freed;
+		stats.totalFreed += freed;
+		finished = true;
+		debugC(kDebugLevelGC, "[GC] Freed %d objects after %d steps", freed, stats.lastSteps + 1);
+	}
+
+	updateStatistics(stats, g_system->getMicros() - startTime);
+	stats.steps++;
+	stats.lastSteps++;
+	return finished;
 }
 
 } // End of namespace Sci
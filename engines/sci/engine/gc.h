@@ -55,12 +55,38 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+enum {
+	kGCStepSize = 256	///< Number of objects scanned by each step of an incremental collection
+};
+
+/**
+ * Performs one step of an incremental garbage collection. The first step
+ * takes the roots, each further one scans kGCStepSize objects, and the last
+ * one scans the roots again and frees all objects left unmarked. The scripts
+ * keep running between the steps, see SegManager::gcWriteBarrier().
+ * @param s The state in which we should gc
+ * @return true if the collection has finished
+ */
+bool run_gc_step(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
 
 	void push(reg_t reg);
 	void pushArray(const Common::Array<reg_t> &tmp);
+
+	/**
+	 * Adds an object allocated during an incremental collection, even if an
+	 * object freed before at the same address has already been marked.
+	 */
+	void pushAllocated(reg_t reg);
+
+	/**
+	 * Forgets all addresses in a segment which is being freed during an
+	 * incremental collection, as the segment ID may be reused.
+	 */
+	void discardSegment(SegmentId seg);
 };
 
 
@@ -208,6 +208,8 @@ static void addToFront(EngineState *s, reg_t listRef, reg_t nodeRef) {
 	checkListPointer(s->_segMan, listRef);
 #endif
 
+	s->_segMan->gcWriteBarrier(nodeRef);
+
 	newNode->pred = NULL_REG;
 	newNode->succ = list->first;
 
@@ -234,6 +236,8 @@ static void addToEnd(EngineState *s, reg_t listRef, reg_t nodeRef) {
 	checkListPointer(s->_segMan, listRef);
 #endif
 
+	s->_segMan->gcWriteBarrier(nodeRef);
+
 	newNode->pred = list->last;
 	newNode->succ = NULL_REG;
 
@@ -285,8 +289,10 @@ reg_t kNodeValue(EngineState *s, int argc, reg_t *argv) {
 reg_t kAddToFront(EngineState *s, int argc, reg_t *argv) {
 	addToFront(s, argv[0], argv[1]);
 
-	if (argc == 3)
+	if (argc == 3) {
 		s->_segMan->lookupNode(argv[1])->key = argv[2];
+		s->_segMan->gcWriteBarrier(argv[2]);
+	}
 
 	return s->r_acc;
 }
@@ -294,8 +300,10 @@ reg_t kAddToFront(EngineState *s, int argc, reg_t *argv) {
 reg_t kAddToEnd(EngineState *s, int argc, reg_t *argv) {
 	addToEnd(s, argv[0], argv[1]);
 
-	if (argc == 3)
+	if (argc == 3) {
 		s->_segMan->lookupNode(argv[1])->key = argv[2];
+		s->_segMan->gcWriteBarrier(argv[2]);
+	}
 
 	return s->r_acc;
 }
@@ -319,10 +327,13 @@ reg_t kAddAfter(EngineState *s, int argc, reg_t *argv) {
 		return NULL_REG;
 	}
 
-	if (argc == 4)
+	if (argc == 4) {
 		newnode->key = argv[3];
+		s->_segMan->gcWriteBarrier(argv[3]);
+	}
 
 	if (firstnode) { // We're really appending after
+		s->_segMan->gcWriteBarrier(argv[2]);
 		reg_t oldnext = firstnode->succ;
 
 		newnode->pred = argv[1];
@@ -381,6 +392,9 @@ reg_t kDeleteKey(EngineState *s, int argc, reg_t *argv) {
 		return NULL_REG; // Signal failure
 
 	n = s->_segMan->lookupNode(node_pos);
+	s->_segMan->gcWriteBarrier(n->pred);
+	s->_segMan->gcWriteBarrier(n->succ);
+
 	if (list->first == node_pos)
 		list->first = n->succ;
 	if (list->last == node_pos)
@@ -715,8 +729,10 @@ reg_t kArray(EngineState *s, int argc, reg_t *argv) {
 		if (array->getSize() < index + count)
 			array->setSize(index + count);
 
-		for (uint16 i = 0; i < count; i++)
+		for (uint16 i = 0; i < count; i++) {
 			array->setValue(i + index, argv[i + 3]);
+			s->_segMan->gcWriteBarrier(argv[i + 3]);
+		}
 
 		return argv[1]; // We also have to return the handle
 	}
@@ -736,6 +752,7 @@ reg_t kArray(EngineState *s, int argc, reg_t *argv) {
 
 		for (uint16 i = 0; i < count; i++)
 			array->setValue(i + index, argv[4]);
+		s->_segMan->gcWriteBarrier(argv[4]);
 
 		return argv[1];
 	}
@@ -767,8 +784,10 @@ reg_t kArray(EngineState *s, int argc, reg_t *argv) {
 		if (array1->getSize() < index1 + count)
 			array1->setSize(index1 + count);
 
-		for (uint16 i = 0; i < count; i++)
+		for (uint16 i = 0; i < count; i++) {
 			array1->setValue(i + index1, array2->getValue(i + index2));
+			s->_segMan->gcWriteBarrier(array2->getValue(i + index2));
+		}
 
 		return arrayHandle;
 	}
@@ -119,6 +119,9 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 		g_system->delayMillis(10);
 	}
 
+	// The video was drawn over whatever kFrameout showed last
+	g_sci->_gfxScreen->invalidateLastDisplayScreen();
+
 	delete[] scaleBuffer;
 	delete videoDecoder;
 }
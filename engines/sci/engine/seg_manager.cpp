@@ -22,6 +22,7 @@
 
 #include "sci/sci.h"
 #include "sci/engine/seg_manager.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/state.h"
 #include "sci/engine/script.h"
 
@@ -43,6 +44,11 @@ SegManager::SegManager(ResourceManager *resMan) {
 
 	_resMan = resMan;
 
+	// Generation 0 marks unused cache entries
+	memset(_selectorLookupCache, 0, sizeof(_selectorLookupCache));
+	_selectorLookupGeneration = 1;
+	_gcWorklist = 0;
+
 	createClassTable();
 }
 
@@ -51,6 +57,9 @@ SegManager::~SegManager() {
 }
 
 void SegManager::resetSegMan() {
+	// An incremental collection cannot continue on a new heap
+	setGCWorklist(0);
+
 	// Free memory
 	for (uint i = 0; i < _heap.size(); i++) {
 		if (_heap[i])
@@ -121,6 +130,7 @@ SegmentObj *SegManager::allocSegment(SegmentObj *mem, SegmentId *segid) {
 		_heap.push_back(0);
 	}
 	_heap[id] = mem;
+	invalidateSelectorLookups();
 
 	return mem;
 }
@@ -155,8 +165,26 @@ void SegManager::deallocate(SegmentId seg) {
 			deallocate(scr->getLocalsSegment());
 	}
 
+	if (_gcWorklist)
+		_gcWorklist->discardSegment(seg);
+
 	delete mobj;
 	_heap[seg] = NULL;
+	invalidateSelectorLookups();
+}
+
+void SegManager::setGCWorklist(WorklistManager *worklist) {
+	delete _gcWorklist;
+	_gcWorklist = worklist;
+}
+
+void SegManager::gcMarkReference(reg_t value) {
+	_gcWorklist->push(value);
+}
+
+void SegManager::gcMarkAllocated(reg_t addr) {
+	if (_gcWorklist)
+		_gcWorklist->pushAllocated(addr);
 }
 
 bool SegManager::isHeapObject(reg_t pos) const {
@@ -385,6 +413,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	offset = table->allocEntry();
 
 	reg_t addr = make_reg(_hunksSegId, offset);
+	gcMarkAllocated(addr);
 	Hunk *h = &(table->_table[offset]);
 
 	if (!h)
@@ -418,8 +447,10 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 		table = (CloneTable *)_heap[_clonesSegId];
 
 	offset = table->allocEntry();
+	invalidateSelectorLookups();
 
 	*addr = make_reg(_clonesSegId, offset);
+	gcMarkAllocated(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -434,6 +465,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_listsSegId, offset);
+	gcMarkAllocated(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -448,6 +480,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_nodesSegId, offset);
+	gcMarkAllocated(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -813,6 +846,7 @@ byte *SegManager::allocDynmem(int size, const char *descr, reg_t *addr) {
 	SegmentId seg;
 	SegmentObj *mobj = allocSegment(new DynMem(), &seg);
 	*addr = make_reg(seg, 0);
+	gcMarkAllocated(*addr);
 
 	DynMem &d = *(DynMem *)mobj;
 
@@ -850,6 +884,7 @@ SciArray<reg_t> *SegManager::allocateArray(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_arraysSegId, offset);
+	gcMarkAllocated(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -890,6 +925,7 @@ SciString *SegManager::allocateString(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_stringSegId, offset);
+	gcMarkAllocated(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -977,6 +1013,7 @@ int SegManager::instantiateScript(int scriptNum) {
 		scr = allocateScript(scriptNum, &segmentId);
 	}
 
+	invalidateSelectorLookups();
 	scr->init(scriptNum, _resMan);
 	scr->load(_resMan);
 	scr->initializeLocals(this);
@@ -42,6 +42,7 @@ enum ScriptLoadType {
 };
 
 class Script;
+struct WorklistManager;
 
 class SegManager : public Common::Serializable {
 	friend class Console;
@@ -441,6 +442,68 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * An entry of the selector lookup cache used by lookupSelector().
+	 * Entries are tagged with the cache generation they were filled in, so
+	 * that the whole cache can be invalidated in constant time.
+	 */
+	struct SelectorLookupEntry {
+		reg_t obj;
+		Selector selector;
+		uint32 generation;
+		SelectorType type;
+		int varIndex;
+		reg_t funcp;
+	};
+
+	enum {
+		kSelectorLookupCacheSize = 512 ///< Number of selector cache entries, must be a power of 2
+	};
+
+	/**
+	 * Returns the selector cache slot for the given object and selector.
+	 * The slot only holds a valid result if its obj, selector and generation
+	 * fields match.
+	 */
+	SelectorLookupEntry &getSelectorLookupEntry(reg_t obj, Selector selector) {
+		uint hash = (obj.segment * 0x9E5) ^ (obj.offset >> 1) ^ (selector * 0x3B);
+		return _selectorLookupCache[hash & (kSelectorLookupCacheSize - 1)];
+	}
+
+	uint32 getSelectorLookupGeneration() const { return _selectorLookupGeneration; }
+
+	/**
+	 * Invalidates all cached selector lookups. This is called whenever an
+	 * object address may start referring to a different object, i.e. when
+	 * segments are (de)allocated, scripts are (re)loaded or clones are made.
+	 */
+	void invalidateSelectorLookups() { _selectorLookupGeneration++; }
+
+	/**
+	 * Write barrier of the incremental garbage collector, see run_gc_step().
+	 * Every reference stored into an object, script locals, a list, a node or
+	 * an array must be passed here, so that it is marked even if the object it
+	 * is stored into has already been scanned. Stores into the stack and the
+	 * registers need no barrier, as these are scanned again before the
+	 * collection frees anything.
+	 */
+	void gcWriteBarrier(reg_t value) {
+		if (_gcWorklist && value.segment)
+			gcMarkReference(value);
+	}
+
+	/**
+	 * Returns the marking state of the incremental garbage collection in
+	 * progress, or 0 if there is none.
+	 */
+	WorklistManager *getGCWorklist() { return _gcWorklist; }
+
+	/**
+	 * Sets the marking state of the incremental garbage collection in
+	 * progress. The previous one is deleted.
+	 */
+	void setGCWorklist(WorklistManager *worklist);
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -463,11 +526,17 @@ private:
 	SegmentId _stringSegId;
 #endif
 
+	SelectorLookupEntry _selectorLookupCache[kSelectorLookupCacheSize];
+	uint32 _selectorLookupGeneration;
+	WorklistManager *_gcWorklist;
+
 public:
 	SegmentObj *allocSegment(SegmentObj *mem, SegmentId *segid);
 
 private:
 	void deallocate(SegmentId seg);
+	void gcMarkReference(reg_t value);
+	void gcMarkAllocated(reg_t addr);
 	void createClassTable();
 
 	SegmentId findFreeSegment() const;
@@ -27,6 +27,9 @@
 
 namespace Sci {
 
+// Enable this to check every cached selector lookup against a full lookup
+//#define VERIFY_SELECTOR_LOOKUPS
+
 #if 1
 
 #define FIND_SELECTOR(_slc_) _selectorCache._slc_ = findSelector(#_slc_)
@@ -210,8 +213,10 @@ void writeSelector(SegManager *segMan, reg_t object, Selector selectorId, reg_t
 	if (lookupSelector(segMan, object, selectorId, &address, NULL) != kSelectorVariable)
 		error("Selector '%s' of object at %04x:%04x could not be"
 		         " written to", g_sci->getKernel()->getSelectorName(selectorId).c_str(), PRINT_REG(object));
-	else
+	else {
 		*address.getPointer(segMan) = value;
+		segMan->gcWriteBarrier(value);
+	}
 }
 
 void invokeSelector(EngineState *s, reg_t object, int selectorId,
@@ -249,9 +254,30 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
+static SelectorType lookupSelectorUncached(SegManager *segMan, const Object *obj, Selector selectorId, int &varIndex, reg_t &funcp) {
+	varIndex = obj->locateVarSelector(segMan, selectorId);
+
+	if (varIndex >= 0) {
+		// Found it as a variable
+		return kSelectorVariable;
+	} else {
+		// Check if it's a method, with recursive lookup in superclasses
+		while (obj) {
+			int index = obj->funcSelectorPosition(selectorId);
+			if (index >= 0) {
+				funcp = obj->getFunction(index);
+				return kSelectorMethod;
+			} else {
+				obj = segMan->getObject(obj->getSuperClassSelector());
+			}
+		}
+
+		return kSelectorNone;
+	}
+}
+
 SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
 	const Object *obj = segMan->getObject(obj_location);
-	int index;
 	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
 
 	// Early SCI versions used the LSB in the selector ID as a read/write
@@ -264,34 +290,40 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 				PRINT_REG(obj_location));
 	}
 
-	index = obj->locateVarSelector(segMan, selectorId);
+	// The result only depends on the object and its superclasses, which do
+	// not change while the object exists, so it is cached. The segment
+	// manager invalidates the cache whenever an address may start referring
+	// to a different object.
+	SegManager::SelectorLookupEntry &entry = segMan->getSelectorLookupEntry(obj_location, selectorId);
+	if (entry.generation != segMan->getSelectorLookupGeneration() || entry.obj != obj_location || entry.selector != selectorId) {
+		entry.type = lookupSelectorUncached(segMan, obj, selectorId, entry.varIndex, entry.funcp);
+		entry.obj = obj_location;
+		entry.selector = selectorId;
+		entry.generation = segMan->getSelectorLookupGeneration();
+	}
+#ifdef VERIFY_SELECTOR_LOOKUPS
+	else {
+		int varIndex;
+		reg_t funcp = NULL_REG;
+		SelectorType type = lookupSelectorUncached(segMan, obj, selectorId, varIndex, funcp);
+		if (type != entry.type || (type == kSelectorVariable && varIndex != entry.varIndex) ||
+				(type == kSelectorMethod && funcp != entry.funcp))
+			error("lookupSelector(): Stale cache entry for selector %d of object %04x:%04x",
+					selectorId, PRINT_REG(obj_location));
+	}
+#endif
 
-	if (index >= 0) {
-		// Found it as a variable
+	if (entry.type == kSelectorVariable) {
 		if (varp) {
 			varp->obj = obj_location;
-			varp->varindex = index;
+			varp->varindex = entry.varIndex;
 		}
-		return kSelectorVariable;
-	} else {
-		// Check if it's a method, with recursive lookup in superclasses
-		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
-			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
-				return kSelectorMethod;
-			} else {
-				obj = segMan->getObject(obj->getSuperClassSelector());
-			}
-		}
-
-		return kSelectorNone;
+	} else if (entry.type == kSelectorMethod) {
+		if (fptr)
+			*fptr = entry.funcp;
 	}
 
-
-//	return _lookupSelector_function(segMan, obj, selectorId, fptr);
+	return entry.type;
 }
 
 } // End of namespace Sci
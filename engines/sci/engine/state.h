@@ -53,6 +53,58 @@ enum AbortGameState {
 	kAbortQuitGame = 3
 };
 
+/**
+ * Statistics about the garbage collector, shown by the gc_stats console
+ * command.
+ */
+struct GCStatistics {
+	uint32 runs;             ///< Number of collections finished
+	uint32 steps;            ///< Number of incremental collection steps performed
+	uint32 lastSteps;        ///< Number of steps of the current or last incremental collection
+	uint32 lastPause;        ///< Duration of the last full collection or step, in us
+	uint32 maxPause;         ///< Longest full collection or step so far, in us
+	uint32 totalPause;       ///< Sum of all collection pauses, in us
+	uint32 lastFreed;        ///< Objects freed by the last collection
+	uint32 totalFreed;       ///< Objects freed by all collections
+
+	GCStatistics() { memset(this, 0, sizeof(*this)); }
+};
+
+/**
+ * Records the old values of the reg_t variables written by the interpreter,
+ * while fused opcodes are checked against the plain ones (see the vm_dispatch
+ * console command). This allows undoing the fused opcodes.
+ */
+struct VMWriteLog {
+	enum {
+		kMaxWrites = 16
+	};
+
+	bool active;
+	uint count;
+	reg_t *addresses[kMaxWrites];
+	reg_t oldValues[kMaxWrites];
+
+	VMWriteLog() : active(false), count(0) {}
+};
+
+/**
+ * Settings of the opcode dispatch in run_vm(), which can be changed with the
+ * vm_dispatch console command.
+ */
+struct VMDispatchState {
+	bool threaded;           ///< Dispatch simple opcodes directly, where supported
+	bool fuseOpcodes;        ///< Execute common comparison sequences as one opcode
+	bool validate;           ///< Check fused opcodes against the plain ones
+	uint32 fusedCount;       ///< Number of fused opcodes executed
+	uint32 validatedCount;   ///< Number of fused opcodes checked
+	uint32 mismatchCount;    ///< Number of fused opcodes which differed from the plain ones
+	VMWriteLog writeLog;     ///< Writes of the opcodes being checked
+
+	VMDispatchState() : threaded(true), fuseOpcodes(true), validate(false),
+		fusedCount(0), validatedCount(0), mismatchCount(0) {}
+};
+
 class DirSeeker {
 protected:
 	reg_t _outbuffer;
@@ -216,6 +268,8 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	GCStatistics gcStats;
+	VMDispatchState vmDispatch;
 
 	MessageState *_msgState;
 
@@ -22,6 +22,7 @@
 
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -117,6 +118,18 @@ static bool validate_variable(reg_t *r, reg_t *stack_base, int type, int max, in
 extern const char *opcodeNames[]; // from scriptdebug.cpp
 #endif
 
+static inline reg_t *logWrite(EngineState *s, reg_t *r) {
+	VMWriteLog &writeLog = s->vmDispatch.writeLog;
+	if (writeLog.active) {
+		// Fused opcodes write a handful of values at most
+		assert(writeLog.count < VMWriteLog::kMaxWrites);
+		writeLog.addresses[writeLog.count] = r;
+		writeLog.oldValues[writeLog.count] = *r;
+		writeLog.count++;
+	}
+	return r;
+}
+
 static reg_t read_var(EngineState *s, int type, int index) {
 	if (validate_variable(s->variables[type], s->stack_base, type, s->variablesMax[type], index)) {
 		if (s->variables[type][index].segment == 0xffff) {
@@ -133,7 +146,7 @@ static reg_t read_var(EngineState *s, int type, int index) {
 					index, originReply.objectName.c_str(), originReply.methodName.c_str(), s->currentRoomNumber(),
 					originReply.scriptNr, originReply.localCallOffset);
 
-					s->variables[type][index] = NULL_REG;
+					*logWrite(s, &s->variables[type][index]) = NULL_REG;
 					break;
 #else
 					error("Uninitialized read for temp %d from method %s::%s (room %d, script %d, localCall %x)",
@@ -142,7 +155,7 @@ static reg_t read_var(EngineState *s, int type, int index) {
 #endif
 				}
 				assert(solution.type == WORKAROUND_FAKE);
-				s->variables[type][index] = make_reg(0, solution.value);
+				*logWrite(s, &s->variables[type][index]) = make_reg(0, solution.value);
 				break;
 			}
 			case VAR_PARAM:
@@ -187,6 +200,7 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 				if (lookupSelector(s->_segMan, stopGroopPos, SELECTOR(client), &varp, NULL) == kSelectorVariable) {
 					reg_t *clientVar = varp.getPointer(s->_segMan);
 					*clientVar = value;
+					s->_segMan->gcWriteBarrier(value);
 				}
 			}
 		}
@@ -198,7 +212,8 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 		if (type == VAR_TEMP && value.segment == 0xffff)
 			value.segment = 0;
 
-		s->variables[type][index] = value;
+		*logWrite(s, &s->variables[type][index]) = value;
+		s->_segMan->gcWriteBarrier(value);
 
 		// If the game is trying to change its speech/subtitle settings, apply the ScummVM audio
 		// options first, if they haven't been applied yet
@@ -213,7 +228,7 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 // 16 bit:
 #define PUSH(v) PUSH32(make_reg(0, v))
 // 32 bit:
-#define PUSH32(a) (*(validate_stack_addr(s, (s->xs->sp)++)) = (a))
+#define PUSH32(a) (*logWrite(s, validate_stack_addr(s, (s->xs->sp)++)) = (a))
 #define POP32() (*(validate_stack_addr(s, --(s->xs->sp))))
 
 ExecStack *execute_method(EngineState *s, uint16 script, uint16 pubfunct, StackPtr sp, reg_t calling_obj, uint16 argc, StackPtr argp) {
@@ -265,6 +280,7 @@ static void _exec_varselectors(EngineState *s) {
 			// varselector access?
 			if (xs.argc) { // write?
 				*var = xs.variables_argp[1];
+				s->_segMan->gcWriteBarrier(*var);
 
 			} else // No, read
 				s->r_acc = *var;
@@ -542,7 +558,313 @@ int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4])
 	return offset;
 }
 
+// Fused opcodes
+//
+// Sierra's compiler translates conditions like (if (< local1 5) ...) into the
+// same short sequence of opcodes, e.g. lsl, ldi, lt?, bnt. Such a sequence is
+// executed as one pseudo opcode, which skips the instruction fetch and the
+// dispatch of all but its first opcode.
+
+enum {
+	op_fusedCompare = 0x80,	// Pseudo opcode, see fuseCompare()
+	kOpcodeHandlerCount = 0x81
+};
+
+/**
+ * A fused sequence of opcodes: an optional push, an optional ldi, one of the
+ * comparison opcodes and an optional bt or bnt.
+ */
+struct FusedCompare {
+	byte pushOpcode;	///< op_lsg to op_lsp, op_push, op_pushi, op_push0 to op_push2 or 0
+	int16 pushParam;
+	bool loadImmediate;	///< Whether there is an ldi
+	int16 immediate;
+	byte compareOpcode;
+	byte branchOpcode;	///< op_bt, op_bnt or 0
+	int16 branchOffset;
+	int instructionCount;
+};
+
+static inline bool isCompareOpcode(byte opcode) {
+	return opcode >= op_eq_ && opcode <= op_ule_;
+}
+
+static inline bool isFusablePush(byte opcode) {
+	return (opcode >= op_lsg && opcode <= op_lsp) || opcode == op_push || opcode == op_pushi
+		|| (opcode >= op_push0 && opcode <= op_push2);
+}
+
+/**
+ * Checks whether the instruction which was just read starts a sequence of
+ * opcodes which can be executed as op_fusedCompare. If so, the program
+ * counter is moved past the whole sequence.
+ */
+static bool fuseCompare(EngineState *s, Script *scr, byte opcode, const int16 opparams[4], FusedCompare &fused) {
+	if (!isFusablePush(opcode) && opcode != op_ldi && !isCompareOpcode(opcode))
+		return false;
+
+	const byte *buf = scr->getBuf();
+	const uint bufSize = scr->getBufSize();
+	uint pc = s->xs->addr.pc.offset;
+	byte nextExtOpcode;
+	int16 nextParams[4];
+
+	fused.pushOpcode = 0;
+	fused.loadImmediate = false;
+	fused.branchOpcode = 0;
+	fused.instructionCount = 1;
+
+	if (isFusablePush(opcode)) {
+		fused.pushOpcode = opcode;
+		fused.pushParam = opparams[0];
+
+		if (pc >= bufSize)
+			return false;
+		opcode = buf[pc] >> 1;
+		if (opcode != op_ldi && !isCompareOpcode(opcode))
+			return false;
+		pc += readPMachineInstruction(buf + pc, nextExtOpcode, nextParams);
+		fused.instructionCount++;
+		if (opcode == op_ldi)
+			fused.immediate = nextParams[0];
+	} else if (opcode == op_ldi) {
+		fused.immediate = opparams[0];
+	}
+
+	if (opcode == op_ldi) {
+		fused.loadImmediate = true;
+
+		if (pc >= bufSize)
+			return false;
+		opcode = buf[pc] >> 1;
+		if (!isCompareOpcode(opcode))
+			return false;
+		pc += readPMachineInstruction(buf + pc, nextExtOpcode, nextParams);
+		fused.instructionCount++;
+	}
+
+	fused.compareOpcode = opcode;
+
+	if (pc < bufSize) {
+		opcode = buf[pc] >> 1;
+		if (opcode == op_bt || opcode == op_bnt) {
+			pc += readPMachineInstruction(buf + pc, nextExtOpcode, nextParams);
+			fused.branchOpcode = opcode;
+			fused.branchOffset = nextParams[0];
+			fused.instructionCount++;
+		}
+	}
+
+	if (fused.instructionCount < 2)
+		return false;
+
+	s->xs->addr.pc.offset = pc;
+	return true;
+}
+
+static bool compareRegs(byte opcode, reg_t left, reg_t right) {
+	switch (opcode) {
+	case op_eq_:
+		return left == right;
+	case op_ne_:
+		return left != right;
+	case op_gt_:
+		return left > right;
+	case op_ge_:
+		return left >= right;
+	case op_lt_:
+		return left < right;
+	case op_le_:
+		return left <= right;
+	case op_ugt_:
+		return left.gtU(right);
+	case op_uge_:
+		return left.geU(right);
+	case op_ult_:
+		return left.ltU(right);
+	case op_ule_:
+		return left.leU(right);
+	default:
+		error("compareRegs: Invalid opcode %x", opcode);
+	}
+}
+
+/**
+ * Executes op_fusedCompare. The opcodes are executed in the same order and
+ * with the same checks as by the plain interpreter.
+ */
+static void executeFusedCompare(EngineState *s, Script *local_script, const FusedCompare &fused) {
+	switch (fused.pushOpcode) {
+	case 0:
+		break;
+	case op_push:
+		PUSH32(s->r_acc);
+		break;
+	case op_pushi:
+		PUSH(fused.pushParam);
+		break;
+	case op_push0:
+	case op_push1:
+	case op_push2:
+		PUSH(fused.pushOpcode - op_push0);
+		break;
+	default:
+		PUSH32(read_var(s, fused.pushOpcode & 0x3, fused.pushParam));
+		break;
+	}
+
+	if (fused.loadImmediate)
+		s->r_acc = make_reg(0, fused.immediate);
+
+	s->r_prev = s->r_acc;
+	s->r_acc = make_reg(0, compareRegs(fused.compareOpcode, POP32(), s->r_acc));
+
+	if (fused.branchOpcode) {
+		const bool condition = s->r_acc.offset || s->r_acc.segment;
+		if (condition == (fused.branchOpcode == op_bt))
+			s->xs->addr.pc.offset += fused.branchOffset;
+
+		if (s->xs->addr.pc.offset >= local_script->getScriptSize())
+			error("[VM] %s: request to jump past the end of script %d (offset %d, script is %d bytes)",
+				fused.branchOpcode == op_bt ? "op_bt" : "op_bnt",
+				local_script->getScriptNumber(), s->xs->addr.pc.offset, local_script->getScriptSize());
+	}
+}
+
+/**
+ * The result of a fused opcode, which is checked against the result of the
+ * plain opcodes when validating them.
+ */
+struct FusedCheck {
+	int remaining;	///< Number of plain opcodes still to be executed before comparing
+	uint16 startPc;
+	reg_t acc;
+	reg_t prev;
+	StackPtr sp;
+	uint16 pc;
+	uint writeCount;
+	reg_t *writeAddresses[VMWriteLog::kMaxWrites];
+	reg_t writeValues[VMWriteLog::kMaxWrites];
+};
+
+/**
+ * Executes op_fusedCompare while recording its results, then undoes it. The
+ * plain opcodes are executed afterwards and compared by finishFusedCheck().
+ */
+static void startFusedCheck(EngineState *s, Script *local_script, const FusedCompare &fused, FusedCheck &check) {
+	const reg_t acc = s->r_acc;
+	const reg_t prev = s->r_prev;
+	const StackPtr sp = s->xs->sp;
+	check.startPc = g_sci->_debugState.old_pc_offset;
+	VMWriteLog &writeLog = s->vmDispatch.writeLog;
+
+	writeLog.active = true;
+	writeLog.count = 0;
+	executeFusedCompare(s, local_script, fused);
+	writeLog.active = false;
+
+	check.acc = s->r_acc;
+	check.prev = s->r_prev;
+	check.sp = s->xs->sp;
+	check.pc = s->xs->addr.pc.offset;
+	check.writeCount = writeLog.count;
+	for (uint i = 0; i < writeLog.count; i++) {
+		check.writeAddresses[i] = writeLog.addresses[i];
+		check.writeValues[i] = *writeLog.addresses[i];
+	}
+
+	// Undo everything, in reverse order
+	for (int i = writeLog.count - 1; i >= 0; i--)
+		*writeLog.addresses[i] = writeLog.oldValues[i];
+
+	s->r_acc = acc;
+	s->r_prev = prev;
+	s->xs->sp = sp;
+	s->xs->addr.pc.offset = check.startPc;
+	check.remaining = fused.instructionCount;
+
+	// Record the writes of the plain opcodes
+	writeLog.active = true;
+	writeLog.count = 0;
+}
+
+static void finishFusedCheck(EngineState *s, Script *local_script, const FusedCheck &check) {
+	VMWriteLog &writeLog = s->vmDispatch.writeLog;
+	writeLog.active = false;
+
+	bool equal = s->r_acc == check.acc && s->r_prev == check.prev && s->xs->sp == check.sp
+		&& s->xs->addr.pc.offset == check.pc && writeLog.count == check.writeCount;
+
+	for (uint i = 0; equal && i < check.writeCount; i++)
+		equal = writeLog.addresses[i] == check.writeAddresses[i] && *check.writeAddresses[i] == check.writeValues[i];
+
+	s->vmDispatch.validatedCount++;
+	if (!equal) {
+		s->vmDispatch.mismatchCount++;
+		warning("[VM] Fused opcodes at %04x:%04x in script %d differ from the plain ones: acc %04x:%04x instead of %04x:%04x, pc %04x instead of %04x",
+			s->xs->addr.pc.segment, check.startPc, local_script->getScriptNumber(),
+			PRINT_REG(check.acc), PRINT_REG(s->r_acc), check.pc, s->xs->addr.pc.offset);
+	}
+}
+
+/**
+ * Reads the instruction at the program counter. Returns its opcode, or
+ * op_fusedCompare when it starts a sequence of opcodes which are executed
+ * together, which is then described by fused.
+ */
+static inline int fetchInstruction(EngineState *s, Script *scr, bool fuse, byte &extOpcode, int16 opparams[4], FusedCompare &fused) {
+	if (s->xs->sp < s->xs->fp)
+		error("run_vm(): stack underflow, sp: %04x:%04x, fp: %04x:%04x",
+		PRINT_REG(*s->xs->sp), PRINT_REG(*s->xs->fp));
+
+	s->variablesMax[VAR_TEMP] = s->xs->sp - s->xs->fp;
+
+	if (s->xs->addr.pc.offset >= scr->getBufSize())
+		error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
+		s->xs->addr.pc.offset, scr->getBufSize());
+
+	s->xs->addr.pc.offset += readPMachineInstruction(scr->getBuf() + s->xs->addr.pc.offset, extOpcode, opparams);
+	const byte opcode = extOpcode >> 1;
+
+	if (fuse && fuseCompare(s, scr, opcode, opparams, fused))
+		return op_fusedCompare;
+
+	return opcode;
+}
+
+// Threaded dispatch
+//
+// Where the compiler supports computed gotos, opcodes can be dispatched
+// through a table of handler addresses. Simple opcodes, which cannot change
+// the execution stack or call the kernel, then continue with the next
+// instruction directly (see NEXT_OPCODE), bypassing the checks of the main
+// loop for debugging, aborts and execution stack changes. Otherwise, the
+// opcodes are dispatched by the switch in run_vm().
+#if defined(__GNUC__) && !defined(SCI_VM_SWITCH_DISPATCH)
+#define SCI_VM_THREADED_DISPATCH
+#endif
+
+#ifdef SCI_VM_THREADED_DISPATCH
+#define OPCODE_HANDLER(n) handler_##n:
+#define OPCODE_HANDLER_ADDRESS(n) __extension__ &&handler_##n
+#define GOTO_OPCODE_HANDLER(n) __extension__ ({ goto *opcodeHandlers[n]; })
+#define NEXT_OPCODE \
+	if (fastDispatch && !s->_executionStackPosChanged && s->abortScriptProcessing == kAbortNone) { \
+		++s->scriptStepCounter; \
+		g_sci->_debugState.old_pc_offset = s->xs->addr.pc.offset; \
+		g_sci->_debugState.old_sp = s->xs->sp; \
+		opcode = fetchInstruction(s, scr, fuse, extOpcode, opparams, fused); \
+		GOTO_OPCODE_HANDLER(opcode); \
+	} \
+	break
+#else
+#define OPCODE_HANDLER(n)
+#define NEXT_OPCODE break
+#endif
+
 void run_vm(EngineState *s) {
+	PROFILE_ZONE("run_vm");
+
 	assert(s);
 
 	int temp;
@@ -574,6 +896,54 @@ void run_vm(EngineState *s) {
 	byte prevOpcode = 0xFF;
 #endif
 
+#ifdef SCI_VM_THREADED_DISPATCH
+	static const void *const opcodeHandlers[kOpcodeHandlerCount] = {
+		OPCODE_HANDLER_ADDRESS(0x00), OPCODE_HANDLER_ADDRESS(0x01), OPCODE_HANDLER_ADDRESS(0x02), OPCODE_HANDLER_ADDRESS(0x03),
+		OPCODE_HANDLER_ADDRESS(0x04), OPCODE_HANDLER_ADDRESS(0x05), OPCODE_HANDLER_ADDRESS(0x06), OPCODE_HANDLER_ADDRESS(0x07),
+		OPCODE_HANDLER_ADDRESS(0x08), OPCODE_HANDLER_ADDRESS(0x09), OPCODE_HANDLER_ADDRESS(0x0a), OPCODE_HANDLER_ADDRESS(0x0b),
+		OPCODE_HANDLER_ADDRESS(0x0c), OPCODE_HANDLER_ADDRESS(0x0d), OPCODE_HANDLER_ADDRESS(0x0e), OPCODE_HANDLER_ADDRESS(0x0f),
+		OPCODE_HANDLER_ADDRESS(0x10), OPCODE_HANDLER_ADDRESS(0x11), OPCODE_HANDLER_ADDRESS(0x12), OPCODE_HANDLER_ADDRESS(0x13),
+		OPCODE_HANDLER_ADDRESS(0x14), OPCODE_HANDLER_ADDRESS(0x15), OPCODE_HANDLER_ADDRESS(0x16), OPCODE_HANDLER_ADDRESS(0x17),
+		OPCODE_HANDLER_ADDRESS(0x18), OPCODE_HANDLER_ADDRESS(0x19), OPCODE_HANDLER_ADDRESS(0x1a), OPCODE_HANDLER_ADDRESS(0x1b),
+		OPCODE_HANDLER_ADDRESS(0x1c), OPCODE_HANDLER_ADDRESS(0x1d), OPCODE_HANDLER_ADDRESS(0x1e), OPCODE_HANDLER_ADDRESS(0x1f),
+		OPCODE_HANDLER_ADDRESS(0x20), OPCODE_HANDLER_ADDRESS(0x21), OPCODE_HANDLER_ADDRESS(0x22), OPCODE_HANDLER_ADDRESS(0x23),
+		OPCODE_HANDLER_ADDRESS(0x24), OPCODE_HANDLER_ADDRESS(0x25), OPCODE_HANDLER_ADDRESS(0x26), OPCODE_HANDLER_ADDRESS(0x27),
+		OPCODE_HANDLER_ADDRESS(0x28), OPCODE_HANDLER_ADDRESS(0x29), OPCODE_HANDLER_ADDRESS(0x2a), OPCODE_HANDLER_ADDRESS(0x2b),
+		OPCODE_HANDLER_ADDRESS(0x2c), OPCODE_HANDLER_ADDRESS(0x2d), OPCODE_HANDLER_ADDRESS(0x2e), OPCODE_HANDLER_ADDRESS(0x2f),
+		OPCODE_HANDLER_ADDRESS(0x30), OPCODE_HANDLER_ADDRESS(0x31), OPCODE_HANDLER_ADDRESS(0x32), OPCODE_HANDLER_ADDRESS(0x33),
+		OPCODE_HANDLER_ADDRESS(0x34), OPCODE_HANDLER_ADDRESS(0x35), OPCODE_HANDLER_ADDRESS(0x36), OPCODE_HANDLER_ADDRESS(0x37),
+		OPCODE_HANDLER_ADDRESS(0x38), OPCODE_HANDLER_ADDRESS(0x39), OPCODE_HANDLER_ADDRESS(0x3a), OPCODE_HANDLER_ADDRESS(0x3b),
+		OPCODE_HANDLER_ADDRESS(0x3c), OPCODE_HANDLER_ADDRESS(0x3d), OPCODE_HANDLER_ADDRESS(0x3e), OPCODE_HANDLER_ADDRESS(0x3f),
+		OPCODE_HANDLER_ADDRESS(0x40), OPCODE_HANDLER_ADDRESS(0x41), OPCODE_HANDLER_ADDRESS(0x42), OPCODE_HANDLER_ADDRESS(0x43),
+		OPCODE_HANDLER_ADDRESS(0x44), OPCODE_HANDLER_ADDRESS(0x45), OPCODE_HANDLER_ADDRESS(0x46), OPCODE_HANDLER_ADDRESS(0x47),
+		OPCODE_HANDLER_ADDRESS(0x48), OPCODE_HANDLER_ADDRESS(0x49), OPCODE_HANDLER_ADDRESS(0x4a), OPCODE_HANDLER_ADDRESS(0x4b),
+		OPCODE_HANDLER_ADDRESS(0x4c), OPCODE_HANDLER_ADDRESS(0x4d), OPCODE_HANDLER_ADDRESS(0x4e), OPCODE_HANDLER_ADDRESS(0x4f),
+		OPCODE_HANDLER_ADDRESS(0x50), OPCODE_HANDLER_ADDRESS(0x51), OPCODE_HANDLER_ADDRESS(0x52), OPCODE_HANDLER_ADDRESS(0x53),
+		OPCODE_HANDLER_ADDRESS(0x54), OPCODE_HANDLER_ADDRESS(0x55), OPCODE_HANDLER_ADDRESS(0x56), OPCODE_HANDLER_ADDRESS(0x57),
+		OPCODE_HANDLER_ADDRESS(0x58), OPCODE_HANDLER_ADDRESS(0x59), OPCODE_HANDLER_ADDRESS(0x5a), OPCODE_HANDLER_ADDRESS(0x5b),
+		OPCODE_HANDLER_ADDRESS(0x5c), OPCODE_HANDLER_ADDRESS(0x5d), OPCODE_HANDLER_ADDRESS(0x5e), OPCODE_HANDLER_ADDRESS(0x5f),
+		OPCODE_HANDLER_ADDRESS(0x60), OPCODE_HANDLER_ADDRESS(0x61), OPCODE_HANDLER_ADDRESS(0x62), OPCODE_HANDLER_ADDRESS(0x63),
+		OPCODE_HANDLER_ADDRESS(0x64), OPCODE_HANDLER_ADDRESS(0x65), OPCODE_HANDLER_ADDRESS(0x66), OPCODE_HANDLER_ADDRESS(0x67),
+		OPCODE_HANDLER_ADDRESS(0x68), OPCODE_HANDLER_ADDRESS(0x69), OPCODE_HANDLER_ADDRESS(0x6a), OPCODE_HANDLER_ADDRESS(0x6b),
+		OPCODE_HANDLER_ADDRESS(0x6c), OPCODE_HANDLER_ADDRESS(0x6d), OPCODE_HANDLER_ADDRESS(0x6e), OPCODE_HANDLER_ADDRESS(0x6f),
+		OPCODE_HANDLER_ADDRESS(0x70), OPCODE_HANDLER_ADDRESS(0x71), OPCODE_HANDLER_ADDRESS(0x72), OPCODE_HANDLER_ADDRESS(0x73),
+		OPCODE_HANDLER_ADDRESS(0x74), OPCODE_HANDLER_ADDRESS(0x75), OPCODE_HANDLER_ADDRESS(0x76), OPCODE_HANDLER_ADDRESS(0x77),
+		OPCODE_HANDLER_ADDRESS(0x78), OPCODE_HANDLER_ADDRESS(0x79), OPCODE_HANDLER_ADDRESS(0x7a), OPCODE_HANDLER_ADDRESS(0x7b),
+		OPCODE_HANDLER_ADDRESS(0x7c), OPCODE_HANDLER_ADDRESS(0x7d), OPCODE_HANDLER_ADDRESS(0x7e), OPCODE_HANDLER_ADDRESS(0x7f),
+		OPCODE_HANDLER_ADDRESS(0x80)
+	};
+#endif
+
+	int opcode;
+	byte extOpcode;
+	FusedCompare fused;
+	FusedCheck fusedCheck;
+	fusedCheck.remaining = 0;
+	bool fuse = false;
+#ifdef SCI_VM_THREADED_DISPATCH
+	bool fastDispatch = false;
+#endif
+
 	while (1) {
 		int var_type; // See description below
 		int var_number;
@@ -618,20 +988,17 @@ void run_vm(EngineState *s) {
 		Console *con = g_sci->getSciDebugger();
 		con->onFrame();
 
-		if (s->xs->sp < s->xs->fp)
-			error("run_vm(): stack underflow, sp: %04x:%04x, fp: %04x:%04x",
-			PRINT_REG(*s->xs->sp), PRINT_REG(*s->xs->fp));
-
-		s->variablesMax[VAR_TEMP] = s->xs->sp - s->xs->fp;
-
-		if (s->xs->addr.pc.offset >= scr->getBufSize())
-			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
-			s->xs->addr.pc.offset, scr->getBufSize());
+		// Opcodes are neither fused nor dispatched directly while debugging,
+		// or while the plain opcodes are checked against fused ones
+#ifndef ABORT_ON_INFINITE_LOOP
+		fuse = s->vmDispatch.fuseOpcodes && !g_sci->_debugState.debugging && !fusedCheck.remaining;
+#ifdef SCI_VM_THREADED_DISPATCH
+		fastDispatch = s->vmDispatch.threaded && !g_sci->_debugState.debugging && !fusedCheck.remaining;
+#endif
+#endif
 
 		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.offset += readPMachineInstruction(scr->getBuf() + s->xs->addr.pc.offset, extOpcode, opparams);
-		const byte opcode = extOpcode >> 1;
+		opcode = fetchInstruction(s, scr, fuse, extOpcode, opparams, fused);
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
 #ifdef ABORT_ON_INFINITE_LOOP
@@ -649,121 +1016,150 @@ void run_vm(EngineState *s) {
 		prevOpcode = opcode;
 #endif
 
+#ifdef SCI_VM_THREADED_DISPATCH
+		if (fastDispatch)
+			GOTO_OPCODE_HANDLER(opcode);
+#endif
+
 		switch (opcode) {
 
 		case op_bnot: // 0x00 (00)
+		OPCODE_HANDLER(0x00)
 			// Binary not
 			s->r_acc = make_reg(0, 0xffff ^ s->r_acc.requireUint16());
-			break;
+			NEXT_OPCODE;
 
 		case op_add: // 0x01 (01)
+		OPCODE_HANDLER(0x01)
 			s->r_acc = POP32() + s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_sub: // 0x02 (02)
+		OPCODE_HANDLER(0x02)
 			s->r_acc = POP32() - s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_mul: // 0x03 (03)
+		OPCODE_HANDLER(0x03)
 			s->r_acc = POP32() * s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_div: // 0x04 (04)
+		OPCODE_HANDLER(0x04)
 			// we check for division by 0 inside the custom reg_t division operator
 			s->r_acc = POP32() / s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_mod: // 0x05 (05)
+		OPCODE_HANDLER(0x05)
 			// we check for division by 0 inside the custom reg_t modulo operator
 			s->r_acc = POP32() % s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_shr: // 0x06 (06)
+		OPCODE_HANDLER(0x06)
 			// Shift right logical
 			s->r_acc = POP32() >> s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_shl: // 0x07 (07)
+		OPCODE_HANDLER(0x07)
 			// Shift left logical
 			s->r_acc = POP32() << s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_xor: // 0x08 (08)
+		OPCODE_HANDLER(0x08)
 			s->r_acc = POP32() ^ s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_and: // 0x09 (09)
+		OPCODE_HANDLER(0x09)
 			s->r_acc = POP32() & s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_or: // 0x0a (10)
+		OPCODE_HANDLER(0x0a)
 			s->r_acc = POP32() | s->r_acc;
-			break;
+			NEXT_OPCODE;
 
 		case op_neg:	// 0x0b (11)
+		OPCODE_HANDLER(0x0b)
 			s->r_acc = make_reg(0, -s->r_acc.requireSint16());
-			break;
+			NEXT_OPCODE;
 
 		case op_not: // 0x0c (12)
+		OPCODE_HANDLER(0x0c)
 			s->r_acc = make_reg(0, !(s->r_acc.offset || s->r_acc.segment));
 			// Must allow pointers to be negated, as this is used for checking whether objects exist
-			break;
+			NEXT_OPCODE;
 
 		case op_eq_: // 0x0d (13)
+		OPCODE_HANDLER(0x0d)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() == s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_ne_: // 0x0e (14)
+		OPCODE_HANDLER(0x0e)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() != s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_gt_: // 0x0f (15)
+		OPCODE_HANDLER(0x0f)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() > s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_ge_: // 0x10 (16)
+		OPCODE_HANDLER(0x10)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() >= s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_lt_: // 0x11 (17)
+		OPCODE_HANDLER(0x11)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() < s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_le_: // 0x12 (18)
+		OPCODE_HANDLER(0x12)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32() <= s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_ugt_: // 0x13 (19)
+		OPCODE_HANDLER(0x13)
 			// > (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().gtU(s->r_acc));
-			break;
+			NEXT_OPCODE;
 
 		case op_uge_: // 0x14 (20)
+		OPCODE_HANDLER(0x14)
 			// >= (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().geU(s->r_acc));
-			break;
+			NEXT_OPCODE;
 
 		case op_ult_: // 0x15 (21)
+		OPCODE_HANDLER(0x15)
 			// < (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().ltU(s->r_acc));
-			break;
+			NEXT_OPCODE;
 
 		case op_ule_: // 0x16 (22)
+		OPCODE_HANDLER(0x16)
 			// <= (unsigned)
 			s->r_prev = s->r_acc;
 			s->r_acc  = make_reg(0, POP32().leU(s->r_acc));
-			break;
+			NEXT_OPCODE;
 
 		case op_bt: // 0x17 (23)
+		OPCODE_HANDLER(0x17)
 			// Branch relative if true
 			if (s->r_acc.offset || s->r_acc.segment)
 				s->xs->addr.pc.offset += opparams[0];
@@ -771,9 +1167,10 @@ void run_vm(EngineState *s) {
 			if (s->xs->addr.pc.offset >= local_script->getScriptSize())
 				error("[VM] op_bt: request to jump past the end of script %d (offset %d, script is %d bytes)",
 					local_script->getScriptNumber(), s->xs->addr.pc.offset, local_script->getScriptSize());
-			break;
+			NEXT_OPCODE;
 
 		case op_bnt: // 0x18 (24)
+		OPCODE_HANDLER(0x18)
 			// Branch relative if not true
 			if (!(s->r_acc.offset || s->r_acc.segment))
 				s->xs->addr.pc.offset += opparams[0];
@@ -781,52 +1178,60 @@ void run_vm(EngineState *s) {
 			if (s->xs->addr.pc.offset >= local_script->getScriptSize())
 				error("[VM] op_bnt: request to jump past the end of script %d (offset %d, script is %d bytes)",
 					local_script->getScriptNumber(), s->xs->addr.pc.offset, local_script->getScriptSize());
-			break;
+			NEXT_OPCODE;
 
 		case op_jmp: // 0x19 (25)
+		OPCODE_HANDLER(0x19)
 			s->xs->addr.pc.offset += opparams[0];
 
 			if (s->xs->addr.pc.offset >= local_script->getScriptSize())
 				error("[VM] op_jmp: request to jump past the end of script %d (offset %d, script is %d bytes)",
 					local_script->getScriptNumber(), s->xs->addr.pc.offset, local_script->getScriptSize());
-			break;
+			NEXT_OPCODE;
 
 		case op_ldi: // 0x1a (26)
+		OPCODE_HANDLER(0x1a)
 			// Load data immediate
 			s->r_acc = make_reg(0, opparams[0]);
-			break;
+			NEXT_OPCODE;
 
 		case op_push: // 0x1b (27)
+		OPCODE_HANDLER(0x1b)
 			// Push to stack
 			PUSH32(s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_pushi: // 0x1c (28)
+		OPCODE_HANDLER(0x1c)
 			// Push immediate
 			PUSH(opparams[0]);
-			break;
+			NEXT_OPCODE;
 
 		case op_toss: // 0x1d (29)
+		OPCODE_HANDLER(0x1d)
 			// TOS (Top Of Stack) subtract
 			s->xs->sp--;
-			break;
+			NEXT_OPCODE;
 
 		case op_dup: // 0x1e (30)
+		OPCODE_HANDLER(0x1e)
 			// Duplicate TOD (Top Of Stack) element
 			r_temp = s->xs->sp[-1];
 			PUSH32(r_temp);
-			break;
+			NEXT_OPCODE;
 
 		case op_link: // 0x1f (31)
+		OPCODE_HANDLER(0x1f)
 			// We shouldn't initialize temp variables at all
 			//  We put special segment 0xFFFF in there, so that uninitialized reads can get detected
 			for (int i = 0; i < opparams[0]; i++)
 				s->xs->sp[i] = make_reg(0xffff, 0);
 
 			s->xs->sp += opparams[0];
-			break;
+			NEXT_OPCODE;
 
 		case op_call: { // 0x20 (32)
+			OPCODE_HANDLER(0x20)
 			// Call a script subroutine
 			int argc = (opparams[1] >> 1) // Given as offset, but we need count
 			           + 1 + s->r_rest;
@@ -852,10 +1257,14 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callk: { // 0x21 (33)
-			// Run the garbage collector, if needed
-			if (s->gcCountDown-- <= 0) {
+			OPCODE_HANDLER(0x21)
+			// Run the garbage collector, if needed. Once started, a collection
+			// advances by one step with every kernel call until it finishes.
+			if (s->_segMan->getGCWorklist()) {
+				run_gc_step(s);
+			} else if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc_step(s);
 			}
 
 			// Call kernel function
@@ -889,6 +1298,7 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callb: // 0x22 (34)
+		OPCODE_HANDLER(0x22)
 			// Call base script
 			temp = ((opparams[1] >> 1) + s->r_rest + 1);
 			s_temp = s->xs->sp;
@@ -903,6 +1313,7 @@ void run_vm(EngineState *s) {
 			break;
 
 		case op_calle: // 0x23 (35)
+		OPCODE_HANDLER(0x23)
 			// Call external script
 			temp = ((opparams[2] >> 1) + s->r_rest + 1);
 			s_temp = s->xs->sp;
@@ -918,6 +1329,7 @@ void run_vm(EngineState *s) {
 			break;
 
 		case op_ret: // 0x24 (36)
+		OPCODE_HANDLER(0x24)
 			// Return from an execution loop started by call, calle, callb, send, self or super
 			do {
 				StackPtr old_sp2 = s->xs->sp;
@@ -936,9 +1348,10 @@ void run_vm(EngineState *s) {
 				if (old_xs->type == EXEC_STACK_TYPE_VARSELECTOR) {
 					// varselector access?
 					reg_t *var = old_xs->getVarPointer(s->_segMan);
-					if (old_xs->argc) // write?
+					if (old_xs->argc) { // write?
 						*var = old_xs->variables_argp[1];
-					else // No, read
+						s->_segMan->gcWriteBarrier(*var);
+					} else // No, read
 						s->r_acc = *var;
 				}
 
@@ -961,6 +1374,7 @@ void run_vm(EngineState *s) {
 			break;
 
 		case op_send: // 0x25 (37)
+		OPCODE_HANDLER(0x25)
 			// Send for one or more selectors
 			s_temp = s->xs->sp;
 			s->xs->sp -= ((opparams[0] >> 1) + s->r_rest); // Adjust stack
@@ -977,7 +1391,9 @@ void run_vm(EngineState *s) {
 			break;
 
 		case 0x26: // (38)
+		OPCODE_HANDLER(0x26)
 		case 0x27: // (39)
+		OPCODE_HANDLER(0x27)
 			if (getSciVersion() == SCI_VERSION_3) {
 				if (extOpcode == 0x4c)
 					s->r_acc = obj->getInfoSelector();
@@ -994,16 +1410,19 @@ void run_vm(EngineState *s) {
 			break;
 
 		case op_class: // 0x28 (40)
+		OPCODE_HANDLER(0x28)
 			// Get class address
 			s->r_acc = s->_segMan->getClassAddress((unsigned)opparams[0], SCRIPT_GET_LOCK,
 											s->xs->addr.pc);
 			break;
 
 		case 0x29: // (41)
+		OPCODE_HANDLER(0x29)
 			error("Dummy opcode 0x%x called", opcode);	// should never happen
 			break;
 
 		case op_self: // 0x2a (42)
+		OPCODE_HANDLER(0x2a)
 			// Send to self
 			s_temp = s->xs->sp;
 			s->xs->sp -= ((opparams[0] >> 1) + s->r_rest); // Adjust stack
@@ -1020,6 +1439,7 @@ void run_vm(EngineState *s) {
 			break;
 
 		case op_super: // 0x2b (43)
+		OPCODE_HANDLER(0x2b)
 			// Send to any class
 			r_temp = s->_segMan->getClassAddress(opparams[0], SCRIPT_GET_LOAD, s->xs->addr.pc);
 
@@ -1043,6 +1463,7 @@ void run_vm(EngineState *s) {
 			break;
 
 		case op_rest: // 0x2c (44)
+		OPCODE_HANDLER(0x2c)
 			// Pushes all or part of the parameter variable list on the stack
 			temp = (uint16) opparams[0]; // First argument
 			s->r_rest = MAX<int16>(s->xs->argc - temp + 1, 0); // +1 because temp counts the paramcount while argc doesn't
@@ -1050,9 +1471,10 @@ void run_vm(EngineState *s) {
 			for (; temp <= s->xs->argc; temp++)
 				PUSH32(s->xs->variables_argp[temp]);
 
-			break;
+			NEXT_OPCODE;
 
 		case op_lea: // 0x2d (45)
+		OPCODE_HANDLER(0x2d)
 			// Load Effective Address
 			temp = (uint16) opparams[0] >> 1;
 			var_number = temp & 0x03; // Get variable type
@@ -1068,48 +1490,62 @@ void run_vm(EngineState *s) {
 			r_temp.offset *= 2; // variables are 16 bit
 			// That's the immediate address now
 			s->r_acc = r_temp;
-			break;
+			NEXT_OPCODE;
 
 
 		case op_selfID: // 0x2e (46)
+		OPCODE_HANDLER(0x2e)
 			// Get 'self' identity
 			s->r_acc = s->xs->objp;
-			break;
+			NEXT_OPCODE;
 
 		case 0x2f: // (47)
+		OPCODE_HANDLER(0x2f)
 			error("Dummy opcode 0x%x called", opcode);	// should never happen
 			break;
 
 		case op_pprev: // 0x30 (48)
+		OPCODE_HANDLER(0x30)
 			// Pushes the value of the prev register, set by the last comparison
 			// bytecode (eq?, lt?, etc.), on the stack
 			PUSH32(s->r_prev);
-			break;
+			NEXT_OPCODE;
 
 		case op_pToa: // 0x31 (49)
+		OPCODE_HANDLER(0x31)
 			// Property To Accumulator
 			s->r_acc = validate_property(s, obj, opparams[0]);
-			break;
+			NEXT_OPCODE;
 
 		case op_aTop: // 0x32 (50)
+		OPCODE_HANDLER(0x32)
 			// Accumulator To Property
 			validate_property(s, obj, opparams[0]) = s->r_acc;
-			break;
+			s->_segMan->gcWriteBarrier(s->r_acc);
+			NEXT_OPCODE;
 
 		case op_pTos: // 0x33 (51)
+		OPCODE_HANDLER(0x33)
 			// Property To Stack
 			PUSH32(validate_property(s, obj, opparams[0]));
-			break;
+			NEXT_OPCODE;
 
 		case op_sTop: // 0x34 (52)
+		OPCODE_HANDLER(0x34)
 			// Stack To Property
-			validate_property(s, obj, opparams[0]) = POP32();
-			break;
+			r_temp = POP32();
+			validate_property(s, obj, opparams[0]) = r_temp;
+			s->_segMan->gcWriteBarrier(r_temp);
+			NEXT_OPCODE;
 
 		case op_ipToa: // 0x35 (53)
+		OPCODE_HANDLER(0x35)
 		case op_dpToa: // 0x36 (54)
+		OPCODE_HANDLER(0x36)
 		case op_ipTos: // 0x37 (55)
+		OPCODE_HANDLER(0x37)
 		case op_dpTos: // 0x38 (56)
+		OPCODE_HANDLER(0x38)
 			{
 			// Increment/decrement a property and copy to accumulator,
 			// or push to stack
@@ -1123,11 +1559,13 @@ void run_vm(EngineState *s) {
 				s->r_acc = opProperty;
 			else
 				PUSH32(opProperty);
-			break;
+			NEXT_OPCODE;
 		}
 
 		case op_lofsa: // 0x39 (57)
+		OPCODE_HANDLER(0x39)
 		case op_lofss: // 0x3a (58)
+		OPCODE_HANDLER(0x3a)
 			// Load offset to accumulator or push to stack
 			r_temp.segment = s->xs->addr.pc.segment;
 
@@ -1158,21 +1596,25 @@ void run_vm(EngineState *s) {
 				s->r_acc = r_temp;
 			else
 				PUSH32(r_temp);
-			break;
+			NEXT_OPCODE;
 
 		case op_push0: // 0x3b (59)
+		OPCODE_HANDLER(0x3b)
 			PUSH(0);
-			break;
+			NEXT_OPCODE;
 
 		case op_push1: // 0x3c (60)
+		OPCODE_HANDLER(0x3c)
 			PUSH(1);
-			break;
+			NEXT_OPCODE;
 
 		case op_push2: // 0x3d (61)
+		OPCODE_HANDLER(0x3d)
 			PUSH(2);
-			break;
+			NEXT_OPCODE;
 
 		case op_pushSelf: // 0x3e (62)
+		OPCODE_HANDLER(0x3e)
 			// Compensate for a bug in non-Sierra compilers, which seem to generate
 			// pushSelf instructions with the low bit set. This makes the following
 			// heuristic fail and leads to endless loops and crashes. Our
@@ -1184,53 +1626,78 @@ void run_vm(EngineState *s) {
 			} else {
 				// Debug opcode op_file
 			}
-			break;
+			NEXT_OPCODE;
 
 		case op_line: // 0x3f (63)
+		OPCODE_HANDLER(0x3f)
 			// Debug opcode (line number)
-			break;
+			NEXT_OPCODE;
 
 		case op_lag: // 0x40 (64)
+		OPCODE_HANDLER(0x40)
 		case op_lal: // 0x41 (65)
+		OPCODE_HANDLER(0x41)
 		case op_lat: // 0x42 (66)
+		OPCODE_HANDLER(0x42)
 		case op_lap: // 0x43 (67)
+		OPCODE_HANDLER(0x43)
 			// Load global, local, temp or param variable into the accumulator
 		case op_lagi: // 0x48 (72)
+		OPCODE_HANDLER(0x48)
 		case op_lali: // 0x49 (73)
+		OPCODE_HANDLER(0x49)
 		case op_lati: // 0x4a (74)
+		OPCODE_HANDLER(0x4a)
 		case op_lapi: // 0x4b (75)
+		OPCODE_HANDLER(0x4b)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_lagi ? s->r_acc.requireSint16() : 0);
 			s->r_acc = read_var(s, var_type, var_number);
-			break;
+			NEXT_OPCODE;
 
 		case op_lsg: // 0x44 (68)
+		OPCODE_HANDLER(0x44)
 		case op_lsl: // 0x45 (69)
+		OPCODE_HANDLER(0x45)
 		case op_lst: // 0x46 (70)
+		OPCODE_HANDLER(0x46)
 		case op_lsp: // 0x47 (71)
+		OPCODE_HANDLER(0x47)
 			// Load global, local, temp or param variable into the stack
 		case op_lsgi: // 0x4c (76)
+		OPCODE_HANDLER(0x4c)
 		case op_lsli: // 0x4d (77)
+		OPCODE_HANDLER(0x4d)
 		case op_lsti: // 0x4e (78)
+		OPCODE_HANDLER(0x4e)
 		case op_lspi: // 0x4f (79)
+		OPCODE_HANDLER(0x4f)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_lsgi ? s->r_acc.requireSint16() : 0);
 			PUSH32(read_var(s, var_type, var_number));
-			break;
+			NEXT_OPCODE;
 
 		case op_sag: // 0x50 (80)
+		OPCODE_HANDLER(0x50)
 		case op_sal: // 0x51 (81)
+		OPCODE_HANDLER(0x51)
 		case op_sat: // 0x52 (82)
+		OPCODE_HANDLER(0x52)
 		case op_sap: // 0x53 (83)
+		OPCODE_HANDLER(0x53)
 			// Save the accumulator into the global, local, temp or param variable
 		case op_sagi: // 0x58 (88)
+		OPCODE_HANDLER(0x58)
 		case op_sali: // 0x59 (89)
+		OPCODE_HANDLER(0x59)
 		case op_sati: // 0x5a (90)
+		OPCODE_HANDLER(0x5a)
 		case op_sapi: // 0x5b (91)
+		OPCODE_HANDLER(0x5b)
 			// Save the accumulator into the global, local, temp or param variable,
 			// using the accumulator as an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
@@ -1238,52 +1705,76 @@ void run_vm(EngineState *s) {
 			if (opcode >= op_sagi)	// load the actual value to store in the accumulator
 				s->r_acc = POP32();
 			write_var(s, var_type, var_number, s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_ssg: // 0x54 (84)
+		OPCODE_HANDLER(0x54)
 		case op_ssl: // 0x55 (85)
+		OPCODE_HANDLER(0x55)
 		case op_sst: // 0x56 (86)
+		OPCODE_HANDLER(0x56)
 		case op_ssp: // 0x57 (87)
+		OPCODE_HANDLER(0x57)
 			// Save the stack into the global, local, temp or param variable
 		case op_ssgi: // 0x5c (92)
+		OPCODE_HANDLER(0x5c)
 		case op_ssli: // 0x5d (93)
+		OPCODE_HANDLER(0x5d)
 		case op_ssti: // 0x5e (94)
+		OPCODE_HANDLER(0x5e)
 		case op_sspi: // 0x5f (95)
+		OPCODE_HANDLER(0x5f)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_ssgi ? s->r_acc.requireSint16() : 0);
 			write_var(s, var_type, var_number, POP32());
-			break;
+			NEXT_OPCODE;
 
 		case op_plusag: // 0x60 (96)
+		OPCODE_HANDLER(0x60)
 		case op_plusal: // 0x61 (97)
+		OPCODE_HANDLER(0x61)
 		case op_plusat: // 0x62 (98)
+		OPCODE_HANDLER(0x62)
 		case op_plusap: // 0x63 (99)
+		OPCODE_HANDLER(0x63)
 			// Increment the global, local, temp or param variable and save it
 			// to the accumulator
 		case op_plusagi: // 0x68 (104)
+		OPCODE_HANDLER(0x68)
 		case op_plusali: // 0x69 (105)
+		OPCODE_HANDLER(0x69)
 		case op_plusati: // 0x6a (106)
+		OPCODE_HANDLER(0x6a)
 		case op_plusapi: // 0x6b (107)
+		OPCODE_HANDLER(0x6b)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_plusagi ? s->r_acc.requireSint16() : 0);
 			s->r_acc = read_var(s, var_type, var_number) + 1;
 			write_var(s, var_type, var_number, s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_plussg: // 0x64 (100)
+		OPCODE_HANDLER(0x64)
 		case op_plussl: // 0x65 (101)
+		OPCODE_HANDLER(0x65)
 		case op_plusst: // 0x66 (102)
+		OPCODE_HANDLER(0x66)
 		case op_plussp: // 0x67 (103)
+		OPCODE_HANDLER(0x67)
 			// Increment the global, local, temp or param variable and save it
 			// to the stack
 		case op_plussgi: // 0x6c (108)
+		OPCODE_HANDLER(0x6c)
 		case op_plussli: // 0x6d (109)
+		OPCODE_HANDLER(0x6d)
 		case op_plussti: // 0x6e (110)
+		OPCODE_HANDLER(0x6e)
 		case op_plusspi: // 0x6f (111)
+		OPCODE_HANDLER(0x6f)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
@@ -1291,36 +1782,52 @@ void run_vm(EngineState *s) {
 			r_temp = read_var(s, var_type, var_number) + 1;
 			PUSH32(r_temp);
 			write_var(s, var_type, var_number, r_temp);
-			break;
+			NEXT_OPCODE;
 
 		case op_minusag: // 0x70 (112)
+		OPCODE_HANDLER(0x70)
 		case op_minusal: // 0x71 (113)
+		OPCODE_HANDLER(0x71)
 		case op_minusat: // 0x72 (114)
+		OPCODE_HANDLER(0x72)
 		case op_minusap: // 0x73 (115)
+		OPCODE_HANDLER(0x73)
 			// Decrement the global, local, temp or param variable and save it
 			// to the accumulator
 		case op_minusagi: // 0x78 (120)
+		OPCODE_HANDLER(0x78)
 		case op_minusali: // 0x79 (121)
+		OPCODE_HANDLER(0x79)
 		case op_minusati: // 0x7a (122)
+		OPCODE_HANDLER(0x7a)
 		case op_minusapi: // 0x7b (123)
+		OPCODE_HANDLER(0x7b)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
 			var_number = opparams[0] + (opcode >= op_minusagi ? s->r_acc.requireSint16() : 0);
 			s->r_acc = read_var(s, var_type, var_number) - 1;
 			write_var(s, var_type, var_number, s->r_acc);
-			break;
+			NEXT_OPCODE;
 
 		case op_minussg: // 0x74 (116)
+		OPCODE_HANDLER(0x74)
 		case op_minussl: // 0x75 (117)
+		OPCODE_HANDLER(0x75)
 		case op_minusst: // 0x76 (118)
+		OPCODE_HANDLER(0x76)
 		case op_minussp: // 0x77 (119)
+		OPCODE_HANDLER(0x77)
 			// Decrement the global, local, temp or param variable and save it
 			// to the stack
 		case op_minussgi: // 0x7c (124)
+		OPCODE_HANDLER(0x7c)
 		case op_minussli: // 0x7d (125)
+		OPCODE_HANDLER(0x7d)
 		case op_minussti: // 0x7e (126)
+		OPCODE_HANDLER(0x7e)
 		case op_minusspi: // 0x7f (127)
+		OPCODE_HANDLER(0x7f)
 			// Same as the 4 ones above, except that the accumulator is used as
 			// an additional index
 			var_type = opcode & 0x3; // Gets the variable type: g, l, t or p
@@ -1328,7 +1835,20 @@ void run_vm(EngineState *s) {
 			r_temp = read_var(s, var_type, var_number) - 1;
 			PUSH32(r_temp);
 			write_var(s, var_type, var_number, r_temp);
-			break;
+			NEXT_OPCODE;
+
+		case op_fusedCompare:
+		OPCODE_HANDLER(0x80)
+			if (s->vmDispatch.validate) {
+				// Execute the plain opcodes afterwards, and compare the results
+				startFusedCheck(s, local_script, fused, fusedCheck);
+				continue;
+			}
+
+			executeFusedCompare(s, local_script, fused);
+			s->scriptStepCounter += fused.instructionCount - 1;
+			s->vmDispatch.fusedCount++;
+			NEXT_OPCODE;
 
 		default:
 			error("run_vm(): illegal opcode %x", opcode);
@@ -1344,6 +1864,9 @@ void run_vm(EngineState *s) {
 					opcode);
 		}
 		++s->scriptStepCounter;
+
+		if (fusedCheck.remaining && --fusedCheck.remaining == 0)
+			finishFusedCheck(s, local_script, fusedCheck);
 	}
 }
 
@@ -25,22 +25,33 @@
 #include "graphics/primitives.h"
 
 #include "sci/sci.h"
+#include "sci/console.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
 #include "sci/graphics/cache.h"
 #include "sci/graphics/font.h"
 #include "sci/graphics/fontsjis.h"
+#include "sci/graphics/screen.h"
 #include "sci/graphics/view.h"
 
 namespace Sci {
 
 GfxCache::GfxCache(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette)
 	: _resMan(resMan), _screen(screen), _palette(palette) {
+	_viewHits = 0;
+	_viewMisses = 0;
+	_viewPurges = 0;
+	memset(&_purgedViewStats, 0, sizeof(_purgedViewStats));
+	_cachedPicturesSize = 0;
+	_pictureHits = 0;
+	_pictureMisses = 0;
+	_picturePurges = 0;
 }
 
 GfxCache::~GfxCache() {
 	purgeFontCache();
 	purgeViewCache();
+	purgePictureCache();
 }
 
 void GfxCache::purgeFontCache() {
@@ -54,6 +65,12 @@ void GfxCache::purgeFontCache() {
 
 void GfxCache::purgeViewCache() {
 	for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
+		const ViewCacheStats &stats = iter->_value->getCacheStats();
+		_purgedViewStats.celHits += stats.celHits;
+		_purgedViewStats.celMisses += stats.celMisses;
+		_purgedViewStats.scalingHits += stats.scalingHits;
+		_purgedViewStats.scalingMisses += stats.scalingMisses;
+
 		delete iter->_value;
 		iter->_value = 0;
 	}
@@ -61,6 +78,14 @@ void GfxCache::purgeViewCache() {
 	_cachedViews.clear();
 }
 
+void GfxCache::purgePictureCache() {
+	for (PictureCache::iterator iter = _cachedPictures.begin(); iter != _cachedPictures.end(); ++iter)
+		delete[] iter->_value.bits;
+
+	_cachedPictures.clear();
+	_cachedPicturesSize = 0;
+}
+
 GfxFont *GfxCache::getFont(GuiResourceId fontId) {
 	if (_cachedFonts.size() >= MAX_CACHED_FONTS)
 		purgeFontCache();
@@ -76,14 +101,65 @@ GfxFont *GfxCache::getFont(GuiResourceId fontId) {
 	return _cachedFonts[fontId];
 }
 
+uint32 GfxCache::getViewCacheSize() const {
+	uint32 size = 0;
+	for (ViewCache::const_iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter)
+		size += iter->_value->getDecodedSize();
+	return size;
+}
+
 GfxView *GfxCache::getView(GuiResourceId viewId) {
-	if (_cachedViews.size() >= MAX_CACHED_VIEWS)
+	ViewCache::iterator iter = _cachedViews.find(viewId);
+	if (iter != _cachedViews.end()) {
+		_viewHits++;
+		return iter->_value;
+	}
+	_viewMisses++;
+
+	// The views keep their decoded cels, so also limit the memory used by
+	// them. This is only checked when a view gets loaded, as the pointers
+	// returned before may still be used until then.
+	if (_cachedViews.size() >= MAX_CACHED_VIEWS || getViewCacheSize() >= MAX_CACHED_VIEWS_SIZE) {
 		purgeViewCache();
+		_viewPurges++;
+	}
 
-	if (!_cachedViews.contains(viewId))
-		_cachedViews[viewId] = new GfxView(_resMan, _screen, _palette, viewId);
+	GfxView *view = new GfxView(_resMan, _screen, _palette, viewId);
+	_cachedViews[viewId] = view;
+	return view;
+}
 
-	return _cachedViews[viewId];
+byte *GfxCache::getPicture(uint32 key, const Common::Rect &rect) {
+	PictureCache::iterator iter = _cachedPictures.find(key);
+	if (iter != _cachedPictures.end()) {
+		Common::Rect cachedRect;
+		_screen->bitsGetRect(iter->_value.bits, &cachedRect);
+		if (cachedRect == rect) {
+			_pictureHits++;
+			return iter->_value.bits;
+		}
+	}
+	_pictureMisses++;
+	return 0;
+}
+
+void GfxCache::addPicture(uint32 key, byte *bits, uint32 size) {
+	PictureCache::iterator iter = _cachedPictures.find(key);
+	if (iter != _cachedPictures.end()) {
+		_cachedPicturesSize -= iter->_value.size;
+		delete[] iter->_value.bits;
+		_cachedPictures.erase(iter);
+	}
+
+	if (_cachedPicturesSize + size > MAX_CACHED_PICTURES_SIZE) {
+		purgePictureCache();
+		_picturePurges++;
+	}
+
+	CachedPicture &picture = _cachedPictures[key];
+	picture.bits = bits;
+	picture.size = size;
+	_cachedPicturesSize += size;
 }
 
 int16 GfxCache::kernelViewGetCelWidth(GuiResourceId viewId, int16 loopNo, int16 celNo) {
@@ -106,4 +182,24 @@ byte GfxCache::kernelViewGetColorAtCoordinate(GuiResourceId viewId, int16 loopNo
 	return getView(viewId)->getColorAtCoordinate(loopNo, celNo, x, y);
 }
 
+void GfxCache::printViewCacheStats(Console *con) const {
+	ViewCacheStats stats = _purgedViewStats;
+	for (ViewCache::const_iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
+		const ViewCacheStats &viewStats = iter->_value->getCacheStats();
+		stats.celHits += viewStats.celHits;
+		stats.celMisses += viewStats.celMisses;
+		stats.scalingHits += viewStats.scalingHits;
+		stats.scalingMisses += viewStats.scalingMisses;
+	}
+
+	con->DebugPrintf("Cached views: %d, using %d KB of decoded data (limits: %d views, %d KB)\n",
+			_cachedViews.size(), getViewCacheSize() / 1024, MAX_CACHED_VIEWS, MAX_CACHED_VIEWS_SIZE / 1024);
+	con->DebugPrintf("View lookups: %d hits, %d misses, %d purges\n", _viewHits, _viewMisses, _viewPurges);
+	con->DebugPrintf("Decoded cels: %d hits, %d misses\n", stats.celHits, stats.celMisses);
+	con->DebugPrintf("Scaling tables: %d hits, %d misses\n", stats.scalingHits, stats.scalingMisses);
+	con->DebugPrintf("Cached pictures: %d, using %d KB (limit: %d KB)\n",
+			_cachedPictures.size(), _cachedPicturesSize / 1024, MAX_CACHED_PICTURES_SIZE / 1024);
+	con->DebugPrintf("Picture lookups: %d hits, %d misses, %d purges\n", _pictureHits, _pictureMisses, _picturePurges);
+}
+
 } // End of namespace Sci
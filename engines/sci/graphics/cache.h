@@ -25,14 +25,27 @@
 
 #include "common/hashmap.h"
 
+#include "sci/graphics/view.h"
+
 namespace Sci {
 
+class Console;
 class GfxFont;
 class GfxView;
 
 typedef Common::HashMap<int, GfxFont *> FontCache;
 typedef Common::HashMap<int, GfxView *> ViewCache;
 
+/**
+ * The screen after drawing a picture, as saved by GfxScreen::bitsSave().
+ */
+struct CachedPicture {
+	byte *bits;
+	uint32 size;
+};
+
+typedef Common::HashMap<uint32, CachedPicture> PictureCache;
+
 /**
  * Cache class, handles caching of views/fonts
  */
@@ -44,6 +57,14 @@ public:
 	GfxFont *getFont(GuiResourceId fontId);
 	GfxView *getView(GuiResourceId viewId);
 
+	/**
+	 * Returns the screen bits saved for the given picture key, or 0 when
+	 * there are none or they were saved for a different rectangle.
+	 */
+	byte *getPicture(uint32 key, const Common::Rect &rect);
+	/** Stores the screen bits of a picture, the cache takes ownership of them. */
+	void addPicture(uint32 key, byte *bits, uint32 size);
+
 	int16 kernelViewGetCelWidth(GuiResourceId viewId, int16 loopNo, int16 celNo);
 	int16 kernelViewGetCelHeight(GuiResourceId viewId, int16 loopNo, int16 celNo);
 	int16 kernelViewGetLoopCount(GuiResourceId viewId);
@@ -51,9 +72,13 @@ public:
 
 	byte kernelViewGetColorAtCoordinate(GuiResourceId viewId, int16 loopNo, int16 celNo, int16 x, int16 y);
 
+	void printViewCacheStats(Console *con) const;
+
 private:
 	void purgeFontCache();
 	void purgeViewCache();
+	void purgePictureCache();
+	uint32 getViewCacheSize() const;
 
 	ResourceManager *_resMan;
 	GfxScreen *_screen;
@@ -61,6 +86,17 @@ private:
 
 	FontCache _cachedFonts;
 	ViewCache _cachedViews;
+	PictureCache _cachedPictures;
+	uint32 _cachedPicturesSize;
+
+	uint32 _viewHits;
+	uint32 _viewMisses;
+	uint _viewPurges;
+	ViewCacheStats _purgedViewStats; // statistics of the views purged so far
+
+	uint32 _pictureHits;
+	uint32 _pictureMisses;
+	uint _picturePurges;
 };
 
 } // End of namespace Sci
@@ -31,6 +31,7 @@
 #include "graphics/surface.h"
 
 #include "sci/sci.h"
+#include "sci/console.h"
 #include "sci/engine/kernel.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
@@ -388,6 +389,7 @@ void GfxFrameout::showVideo() {
 			const Graphics::Surface *frame = videoDecoder->decodeNextFrame();
 			if (frame) {
 				g_system->copyRectToScreen((byte *)frame->pixels, frame->pitch, x, y, frame->w, frame->h);
+				_screen->invalidateLastDisplayScreen();
 
 				if (videoDecoder->hasDirtyPalette())
 					videoDecoder->setSystemPalette();
@@ -662,9 +664,33 @@ void GfxFrameout::kernelFrameout() {
 		}
 	}
 
-	_screen->copyToScreen();
+	// Everything got redrawn, but only the parts which actually changed need
+	// to be copied to the actual screen
+	_screen->copyChangedToScreen(_changedRects);
+
+	debugC(4, kDebugLevelGraphics, "kFrameout: %d rects, %d pixels changed", _changedRects.size(), getChangedArea());
 
 	g_sci->getEngineState()->_throttleTrigger = true;
 }
 
+uint GfxFrameout::getChangedArea() const {
+	uint area = 0;
+	for (uint i = 0; i < _changedRects.size(); i++)
+		area += _changedRects[i].width() * _changedRects[i].height();
+	return area;
+}
+
+void GfxFrameout::printChangedRects(Console *con) const {
+	const uint screenArea = _screen->getDisplayWidth() * _screen->getDisplayHeight();
+	const uint area = getChangedArea();
+
+	con->DebugPrintf("Last frame: %d rects, %d of %d pixels (%d%%) changed\n",
+			_changedRects.size(), area, screenArea, area * 100 / screenArea);
+
+	for (uint i = 0; i < _changedRects.size(); i++) {
+		const Common::Rect &rect = _changedRects[i];
+		con->DebugPrintf(" (%d, %d, %d, %d)\n", rect.left, rect.top, rect.right, rect.bottom);
+	}
+}
+
 } // End of namespace Sci
@@ -75,6 +75,7 @@ struct PlanePictureEntry {
 
 typedef Common::List<PlanePictureEntry> PlanePictureList;
 
+class Console;
 class GfxCache;
 class GfxCoordAdjuster32;
 class GfxPaint32;
@@ -104,6 +105,9 @@ public:
 	void deletePlanePictures(reg_t object);
 	void clear();
 
+	/** Prints the rectangles which the last kFrameout copied to the screen. */
+	void printChangedRects(Console *con) const;
+
 private:
 	void showVideo();
 	void createPlaneItemList(reg_t planeObject, FrameoutList &itemList);
@@ -127,6 +131,11 @@ private:
 
 	void sortPlanes();
 
+	uint getChangedArea() const;
+
+	/** The rectangles which the last kFrameout copied to the screen. */
+	Common::Array<Common::Rect> _changedRects;
+
 	uint16 _scriptsRunningWidth;
 	uint16 _scriptsRunningHeight;
 };
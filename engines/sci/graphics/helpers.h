@@ -34,6 +34,8 @@ namespace Sci {
 #define MAX_CACHED_CURSORS 10
 #define MAX_CACHED_FONTS 20
 #define MAX_CACHED_VIEWS 50
+#define MAX_CACHED_VIEWS_SIZE (16 * 1024 * 1024) // decoded cels and scaling tables, in bytes
+#define MAX_CACHED_PICTURES_SIZE (4 * 1024 * 1024) // saved screens of drawn pictures, in bytes
 
 #define SCI_SHAKE_DIRECTION_VERTICAL 1
 #define SCI_SHAKE_DIRECTION_HORIZONTAL 2
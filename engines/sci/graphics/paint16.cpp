@@ -60,14 +60,37 @@ void GfxPaint16::debugSetEGAdrawingVisualize(bool state) {
 }
 
 void GfxPaint16::drawPicture(GuiResourceId pictureId, int16 animationNr, bool mirroredFlag, bool addToFlag, GuiResourceId paletteId) {
-	GfxPicture *picture = new GfxPicture(_resMan, _coordAdjuster, _ports, _screen, _palette, pictureId, _EGAdrawingVisualize);
+	// A picture drawn onto a cleared port always looks the same, so the
+	// screen gets saved afterwards and restored when the picture is drawn
+	// again. Only ports covering the screen below their top are cached, as
+	// the vector data isn't clipped to the port.
+	Port *port = _ports->getPort();
+	Common::Rect pictureRect = port->rect;
+	pictureRect.translate(port->left, port->top);
+	bool cacheable = !addToFlag && !_EGAdrawingVisualize && !_screen->isUnditheringEnabled()
+			&& pictureRect.left == 0 && pictureRect.right == _screen->getWidth() && pictureRect.bottom == _screen->getHeight();
+	uint32 cacheKey = ((paletteId & 0xFF) << 24) | (mirroredFlag ? 0x10000 : 0) | (pictureId & 0xFFFF);
+
+	byte *cachedBits = cacheable ? _cache->getPicture(cacheKey, pictureRect) : 0;
+	if (cachedBits) {
+		_screen->bitsRestore(cachedBits);
+	} else {
+		GfxPicture *picture = new GfxPicture(_resMan, _coordAdjuster, _ports, _screen, _palette, pictureId, _EGAdrawingVisualize);
+
+		// do we add to a picture? if not -> clear screen with white
+		if (!addToFlag)
+			clearScreen(_screen->getColorWhite());
 
-	// do we add to a picture? if not -> clear screen with white
-	if (!addToFlag)
-		clearScreen(_screen->getColorWhite());
+		picture->draw(animationNr, mirroredFlag, addToFlag, paletteId);
 
-	picture->draw(animationNr, mirroredFlag, addToFlag, paletteId);
-	delete picture;
+		if (cacheable && picture->isCacheable()) {
+			uint32 size = _screen->bitsGetDataSize(pictureRect, GFX_SCREEN_MASK_ALL);
+			byte *bits = new byte[size];
+			_screen->bitsSave(pictureRect, GFX_SCREEN_MASK_ALL, bits);
+			_cache->addPicture(cacheKey, bits, size);
+		}
+		delete picture;
+	}
 
 	// We make a call to SciPalette here, for increasing sys timestamp and also loading targetpalette, if palvary active
 	//  (SCI1.1 only)
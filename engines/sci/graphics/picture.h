@@ -51,6 +51,13 @@ public:
 	GuiResourceId getResourceId();
 	void draw(int16 animationNr, bool mirroredFlag, bool addToFlag, int16 EGApaletteNo);
 
+	/**
+	 * Returns true, when the last draw() only changed the screen. Pictures,
+	 * which also set the palette or the priority bands, can't be replaced
+	 * by a copy of the screen.
+	 */
+	bool isCacheable() const { return _cacheable; }
+
 #ifdef ENABLE_SCI32
 	int16 getSci32celCount();
 	int16 getSci32celY(int16 celNo);
@@ -95,6 +102,7 @@ private:
 	bool _addToFlag;
 	int16 _EGApaletteNo;
 	byte _priority;
+	bool _cacheable;
 
 	// If true, we will show the whole EGA drawing process...
 	bool _EGAdrawingVisualize;
@@ -102,6 +102,8 @@ GfxScreen::GfxScreen(ResourceManager *resMan) : _resMan(resMan) {
 	_priorityScreen = (byte *)calloc(_pixels, 1);
 	_controlScreen = (byte *)calloc(_pixels, 1);
 	_displayScreen = (byte *)calloc(_displayPixels, 1);
+	_lastDisplayScreen = 0;
+	_lastDisplayScreenValid = false;
 
 	// Sets display screen to be actually displayed
 	_activeScreen = _displayScreen;
@@ -147,9 +149,11 @@ GfxScreen::~GfxScreen() {
 	free(_priorityScreen);
 	free(_controlScreen);
 	free(_displayScreen);
+	free(_lastDisplayScreen);
 }
 
 void GfxScreen::copyToScreen() {
+	_lastDisplayScreenValid = false;
 	g_system->copyRectToScreen(_activeScreen, _displayWidth, 0, 0, _displayWidth, _displayHeight);
 }
 
@@ -168,6 +172,7 @@ void GfxScreen::kernelSyncWithFramebuffer() {
 }
 
 void GfxScreen::copyRectToScreen(const Common::Rect &rect) {
+	_lastDisplayScreenValid = false;
 	if (!_upscaledHires)  {
 		g_system->copyRectToScreen(_activeScreen + rect.top * _displayWidth + rect.left, _displayWidth, rect.left, rect.top, rect.width(), rect.height());
 	} else {
@@ -183,10 +188,12 @@ void GfxScreen::copyRectToScreen(const Common::Rect &rect) {
 void GfxScreen::copyDisplayRectToScreen(const Common::Rect &rect) {
 	if (!_upscaledHires)
 		error("copyDisplayRectToScreen: not in upscaled hires mode");
+	_lastDisplayScreenValid = false;
 	g_system->copyRectToScreen(_activeScreen + rect.top * _displayWidth + rect.left, _displayWidth, rect.left, rect.top, rect.width(), rect.height());
 }
 
 void GfxScreen::copyRectToScreen(const Common::Rect &rect, int16 x, int16 y) {
+	_lastDisplayScreenValid = false;
 	if (!_upscaledHires)  {
 		g_system->copyRectToScreen(_activeScreen + rect.top * _displayWidth + rect.left, _displayWidth, x, y, rect.width(), rect.height());
 	} else {
@@ -195,6 +202,64 @@ void GfxScreen::copyRectToScreen(const Common::Rect &rect, int16 x, int16 y) {
 	}
 }
 
+void GfxScreen::copyChangedToScreen(Common::Array<Common::Rect> &changedRects) {
+	// Unchanged rows between changed ones are copied as well, when there are
+	// at most this many, so that we don't end up with lots of thin rectangles
+	const int16 maxUnchangedRows = 8;
+
+	changedRects.clear();
+
+	if (!_lastDisplayScreen)
+		_lastDisplayScreen = (byte *)malloc(_displayPixels);
+
+	if (!_lastDisplayScreenValid) {
+		memcpy(_lastDisplayScreen, _activeScreen, _displayPixels);
+		_lastDisplayScreenValid = true;
+
+		g_system->copyRectToScreen(_activeScreen, _displayWidth, 0, 0, _displayWidth, _displayHeight);
+		changedRects.push_back(Common::Rect(_displayWidth, _displayHeight));
+		return;
+	}
+
+	Common::Rect rect;
+
+	for (int16 y = 0; y < _displayHeight; y++) {
+		const byte *row = _activeScreen + y * _displayWidth;
+		byte *lastRow = _lastDisplayScreen + y * _displayWidth;
+
+		if (!memcmp(row, lastRow, _displayWidth))
+			continue;
+
+		int16 left = 0;
+		while (row[left] == lastRow[left])
+			left++;
+		int16 right = _displayWidth;
+		while (row[right - 1] == lastRow[right - 1])
+			right--;
+
+		memcpy(lastRow + left, row + left, right - left);
+
+		if (!rect.isEmpty() && y - rect.bottom > maxUnchangedRows) {
+			g_system->copyRectToScreen(_activeScreen + rect.top * _displayWidth + rect.left, _displayWidth, rect.left, rect.top, rect.width(), rect.height());
+			changedRects.push_back(rect);
+			rect = Common::Rect();
+		}
+
+		if (rect.isEmpty()) {
+			rect = Common::Rect(left, y, right, y + 1);
+		} else {
+			rect.left = MIN(rect.left, left);
+			rect.right = MAX(rect.right, right);
+			rect.bottom = y + 1;
+		}
+	}
+
+	if (!rect.isEmpty()) {
+		g_system->copyRectToScreen(_activeScreen + rect.top * _displayWidth + rect.left, _displayWidth, rect.left, rect.top, rect.width(), rect.height());
+		changedRects.push_back(rect);
+	}
+}
+
 byte GfxScreen::getDrawingMask(byte color, byte prio, byte control) {
 	byte flag = 0;
 	if (color != 255)
@@ -230,6 +295,30 @@ void GfxScreen::putPixel(int x, int y, byte drawMask, byte color, byte priority,
 		_controlScreen[offset] = control;
 }
 
+void GfxScreen::putPixelSpan(int left, int right, int y, byte drawMask, byte color, byte priority, byte control) {
+	int offset = y * _width + left;
+	int width = right - left + 1;
+
+	if (drawMask & GFX_SCREEN_MASK_VISUAL) {
+		memset(_visualScreen + offset, color, width);
+		if (!_upscaledHires) {
+			memset(_displayScreen + offset, color, width);
+		} else {
+			int displayOffset = _upscaledMapping[y] * _displayWidth + left * 2;
+			int heightOffsetBreak = (_upscaledMapping[y + 1] - _upscaledMapping[y]) * _displayWidth;
+			int heightOffset = 0;
+			do {
+				memset(_displayScreen + displayOffset + heightOffset, color, width * 2);
+				heightOffset += _displayWidth;
+			} while (heightOffset != heightOffsetBreak);
+		}
+	}
+	if (drawMask & GFX_SCREEN_MASK_PRIORITY)
+		memset(_priorityScreen + offset, priority, width);
+	if (drawMask & GFX_SCREEN_MASK_CONTROL)
+		memset(_controlScreen + offset, control, width);
+}
+
 /**
  * This is used to put font pixels onto the screen - we adjust differently, so that we won't
  *  do triple pixel lines in any case on upscaled hires. That way the font will not get distorted
@@ -27,6 +27,8 @@
 #include "sci/graphics/helpers.h"
 #include "sci/graphics/view.h"
 
+#include "common/array.h"
+
 #include "graphics/sjis.h"
 
 namespace Sci {
@@ -79,8 +81,24 @@ public:
 	void copyDisplayRectToScreen(const Common::Rect &rect);
 	void copyRectToScreen(const Common::Rect &rect, int16 x, int16 y);
 
+	/**
+	 * Copies only the parts of the display screen, which changed since the
+	 * last call, to the actual screen. Changed rows close to each other are
+	 * merged into one rectangle, the rectangles copied are returned in
+	 * changedRects. Everything is copied, when something else copied to the
+	 * actual screen in the meantime.
+	 */
+	void copyChangedToScreen(Common::Array<Common::Rect> &changedRects);
+	/**
+	 * Makes the next copyChangedToScreen() copy everything. Needs to be
+	 * called when drawing to the actual screen directly, e.g. for videos.
+	 */
+	void invalidateLastDisplayScreen() { _lastDisplayScreenValid = false; }
+
 	byte getDrawingMask(byte color, byte prio, byte control);
 	void putPixel(int x, int y, byte drawMask, byte color, byte prio, byte control);
+	/** Like putPixel(), for all pixels of a row from left to right, both inclusive. */
+	void putPixelSpan(int left, int right, int y, byte drawMask, byte color, byte prio, byte control);
 	void putFontPixel(int startingY, int x, int y, byte color);
 	void putPixelOnDisplay(int x, int y, byte color);
 	void drawLine(Common::Point startPoint, Common::Point endPoint, byte color, byte prio, byte control);
@@ -168,6 +186,13 @@ private:
 	 */
 	byte *_displayScreen;
 
+	/**
+	 * The display screen, as it was last copied by copyChangedToScreen().
+	 * Only allocated once that is used.
+	 */
+	byte *_lastDisplayScreen;
+	bool _lastDisplayScreenValid;
+
 	ResourceManager *_resMan;
 
 	/**
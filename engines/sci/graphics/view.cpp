@@ -34,6 +34,8 @@ GfxView::GfxView(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette
 	: _resMan(resMan), _screen(screen), _palette(palette), _resourceId(resourceId) {
 	assert(resourceId != -1);
 	_coordAdjuster = g_sci->_gfxCoordAdjuster;
+	_decodedSize = 0;
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
 	initData(resourceId);
 }
 
@@ -43,11 +45,15 @@ GfxView::~GfxView() {
 		// and through the cells of each loop
 		for (uint16 celNum = 0; celNum < _loop[loopNum].celCount; celNum++) {
 			delete[] _loop[loopNum].cel[celNum].rawBitmap;
+			delete[] _loop[loopNum].cel[celNum].spans;
+			delete[] _loop[loopNum].cel[celNum].spanRows;
 		}
 		delete[] _loop[loopNum].cel;
 	}
 	delete[] _loop;
 
+	purgeScalingTables();
+
 	_resMan->unlockResource(_resource);
 }
 
@@ -201,6 +207,8 @@ void GfxView::initData(GuiResourceId resourceId) {
 					}
 				}
 				cel->rawBitmap = 0;
+				cel->spans = 0;
+				cel->spanRows = 0;
 				if (_loop[loopNo].mirrorFlag)
 					cel->displaceX = -cel->displaceX;
 			}
@@ -293,6 +301,8 @@ void GfxView::initData(GuiResourceId resourceId) {
 					SWAP(cel->offsetRLE, cel->offsetLiteral);
 
 				cel->rawBitmap = 0;
+				cel->spans = 0;
+				cel->spanRows = 0;
 				if (_loop[loopNo].mirrorFlag)
 					cel->displaceX = -cel->displaceX;
 
@@ -582,14 +592,18 @@ void GfxView::unpackCel(int16 loopNo, int16 celNo, byte *outPtr, uint32 pixelCou
 const byte *GfxView::getBitmap(int16 loopNo, int16 celNo) {
 	loopNo = CLIP<int16>(loopNo, 0, _loopCount -1);
 	celNo = CLIP<int16>(celNo, 0, _loop[loopNo].celCount - 1);
-	if (_loop[loopNo].cel[celNo].rawBitmap)
+	if (_loop[loopNo].cel[celNo].rawBitmap) {
+		_cacheStats.celHits++;
 		return _loop[loopNo].cel[celNo].rawBitmap;
+	}
+	_cacheStats.celMisses++;
 
 	uint16 width = _loop[loopNo].cel[celNo].width;
 	uint16 height = _loop[loopNo].cel[celNo].height;
 	// allocating memory to store cel's bitmap
 	int pixelCount = width * height;
 	_loop[loopNo].cel[celNo].rawBitmap = new byte[pixelCount];
+	_decodedSize += pixelCount;
 	byte *pBitmap = _loop[loopNo].cel[celNo].rawBitmap;
 
 	// unpack the actual cel bitmap data
@@ -607,6 +621,112 @@ const byte *GfxView::getBitmap(int16 loopNo, int16 celNo) {
 	return _loop[loopNo].cel[celNo].rawBitmap;
 }
 
+/**
+ * Creates the lists of opaque pixel runs of a cel, which allow draw() to
+ * skip transparent parts of the cel at once. Like the bitmap, they're kept
+ * for as long as the view.
+ */
+const CelInfo *GfxView::getSpans(int16 loopNo, int16 celNo) {
+	loopNo = CLIP<int16>(loopNo, 0, _loopCount -1);
+	celNo = CLIP<int16>(celNo, 0, _loop[loopNo].celCount - 1);
+	CelInfo *celInfo = &_loop[loopNo].cel[celNo];
+
+	if (celInfo->spans)
+		return celInfo;
+
+	const byte *bitmap = celInfo->rawBitmap ? celInfo->rawBitmap : getBitmap(loopNo, celNo);
+
+	const int16 width = celInfo->width;
+	const int16 height = celInfo->height;
+	const byte clearKey = celInfo->clearKey;
+	const byte *row;
+	int16 x, y;
+
+	// Count the runs first, so that they can be stored in one block
+	uint32 spanCount = 0;
+	row = bitmap;
+	for (y = 0; y < height; y++, row += width) {
+		for (x = 0; x < width; x++) {
+			if (row[x] != clearKey && (x == 0 || row[x - 1] == clearKey))
+				spanCount++;
+		}
+	}
+
+	celInfo->spans = new CelSpan[MAX<uint32>(spanCount, 1)];
+	celInfo->spanRows = new uint32[height + 1];
+	_decodedSize += spanCount * sizeof(CelSpan) + (height + 1) * sizeof(uint32);
+
+	CelSpan *span = celInfo->spans;
+	row = bitmap;
+	for (y = 0; y < height; y++, row += width) {
+		celInfo->spanRows[y] = span - celInfo->spans;
+		x = 0;
+		while (x < width) {
+			while (x < width && row[x] == clearKey)
+				x++;
+			if (x == width)
+				break;
+			span->left = x;
+			while (x < width && row[x] != clearKey)
+				x++;
+			span->right = x;
+			span++;
+		}
+	}
+	celInfo->spanRows[height] = span - celInfo->spans;
+
+	return celInfo;
+}
+
+void GfxView::purgeScalingTables() {
+	for (ScalingTableMap::iterator it = _scalingTables.begin(); it != _scalingTables.end(); ++it) {
+		_decodedSize -= ((it->_key & 0x80000000) ? 480 : 640) * sizeof(uint16);
+		delete[] it->_value;
+	}
+	_scalingTables.clear();
+}
+
+/**
+ * Returns the table which maps the scaled coordinates of a cel to the ones of
+ * the unscaled cel. The tables only depend on the width or height of the cel
+ * and the scale, so cels of the same size share them.
+ */
+const uint16 *GfxView::getScalingTable(int16 celLength, int16 scale, bool vertical) {
+	const uint32 key = (vertical ? 0x80000000 : 0) | ((uint32)celLength << 16) | (uint16)scale;
+
+	ScalingTableMap::const_iterator it = _scalingTables.find(key);
+	if (it != _scalingTables.end()) {
+		_cacheStats.scalingHits++;
+		return it->_value;
+	}
+	_cacheStats.scalingMisses++;
+
+	const int tableSize = vertical ? 480 : 640;
+	uint16 *table = new uint16[tableSize];
+	_decodedSize += tableSize * sizeof(uint16);
+
+	int16 scaledLength = (celLength * scale) >> 7;
+	scaledLength = CLIP<int16>(scaledLength, 0, vertical ? _screen->getHeight() : _screen->getWidth());
+
+	int pixelNo = 0;
+	int scaledPixel = 0, scaledPixelNo = 0, prevScaledPixelNo = 0;
+	while (pixelNo < celLength) {
+		scaledPixelNo = scaledPixel >> 7;
+		assert(scaledPixelNo < tableSize);
+		for (; prevScaledPixelNo <= scaledPixelNo; prevScaledPixelNo++)
+			table[prevScaledPixelNo] = pixelNo;
+		pixelNo++;
+		scaledPixel += scale;
+	}
+	pixelNo--;
+	scaledPixelNo++;
+	for (; scaledPixelNo < scaledLength; scaledPixelNo++)
+		table[scaledPixelNo] = pixelNo;
+
+	_scalingTables[key] = table;
+	return table;
+}
+
 /**
  * Called after unpacking an EGA cel, this will try to undither (parts) of the
  * cel if the dithering in here matches dithering used by the current picture.
@@ -721,10 +841,24 @@ void GfxView::draw(const Common::Rect &rect, const Common::Rect &clipRect, const
 	bitmap += (clipRect.top - rect.top) * celWidth + (clipRect.left - rect.left);
 
 	if (!_EGAmapping) {
+		// Only the opaque runs of each row need to be looked at
+		const CelInfo *spanInfo = getSpans(loopNo, celNo);
+		const int16 offsetX = clipRect.left - rect.left;
+		const int16 offsetY = clipRect.top - rect.top;
+
 		for (y = 0; y < height; y++, bitmap += celWidth) {
-			for (x = 0; x < width; x++) {
-				const byte color = bitmap[x];
-				if (color != clearKey) {
+			if (offsetY + y < 0 || offsetY + y >= celHeight)
+				continue;
+
+			const CelSpan *span = spanInfo->spans + spanInfo->spanRows[offsetY + y];
+			const CelSpan *spanEnd = spanInfo->spans + spanInfo->spanRows[offsetY + y + 1];
+
+			for (; span < spanEnd; span++) {
+				const int16 left = MAX<int16>(span->left - offsetX, 0);
+				const int16 right = MIN<int16>(span->right - offsetX, width);
+
+				for (x = left; x < right; x++) {
+					const byte color = bitmap[x];
 					const int x2 = clipRectTranslated.left + x;
 					const int y2 = clipRectTranslated.top + y;
 					if (!upscaledHires) {
@@ -770,10 +904,7 @@ void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect,
 	const int16 celWidth = celInfo->width;
 	const byte clearKey = celInfo->clearKey;
 	const byte drawMask = priority > 15 ? GFX_SCREEN_MASK_VISUAL : GFX_SCREEN_MASK_VISUAL|GFX_SCREEN_MASK_PRIORITY;
-	uint16 scalingX[640];
-	uint16 scalingY[480];
 	int16 scaledWidth, scaledHeight;
-	int pixelNo, scaledPixel, scaledPixelNo, prevScaledPixelNo;
 
 	if (_embeddedPal)
 		// Merge view palette in...
@@ -784,41 +915,14 @@ void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect,
 	scaledWidth = CLIP<int16>(scaledWidth, 0, _screen->getWidth());
 	scaledHeight = CLIP<int16>(scaledHeight, 0, _screen->getHeight());
 
-	// Do we really need to do this?!
-	//memset(scalingX, 0, sizeof(scalingX));
-	//memset(scalingY, 0, sizeof(scalingY));
-
-	// Create height scaling table
-	pixelNo = 0;
-	scaledPixel = scaledPixelNo = prevScaledPixelNo = 0;
-	while (pixelNo < celHeight) {
-		scaledPixelNo = scaledPixel >> 7;
-		assert(scaledPixelNo < ARRAYSIZE(scalingY));
-		for (; prevScaledPixelNo <= scaledPixelNo; prevScaledPixelNo++)
-			scalingY[prevScaledPixelNo] = pixelNo;
-		pixelNo++;
-		scaledPixel += scaleY;
-	}
-	pixelNo--;
-	scaledPixelNo++;
-	for (; scaledPixelNo < scaledHeight; scaledPixelNo++)
-		scalingY[scaledPixelNo] = pixelNo;
+	// Actors walking through a room with perspective scaling use lots of
+	// different scales, so start over every now and then. This must not
+	// happen in between getting both tables.
+	if (_scalingTables.size() + 2 > SCI_VIEW_MAX_SCALING_TABLES)
+		purgeScalingTables();
 
-	// Create width scaling table
-	pixelNo = 0;
-	scaledPixel = scaledPixelNo = prevScaledPixelNo = 0;
-	while (pixelNo < celWidth) {
-		scaledPixelNo = scaledPixel >> 7;
-		assert(scaledPixelNo < ARRAYSIZE(scalingX));
-		for (; prevScaledPixelNo <= scaledPixelNo; prevScaledPixelNo++)
-			scalingX[prevScaledPixelNo] = pixelNo;
-		pixelNo++;
-		scaledPixel += scaleX;
-	}
-	pixelNo--;
-	scaledPixelNo++;
-	for (; scaledPixelNo < scaledWidth; scaledPixelNo++)
-		scalingX[scaledPixelNo] = pixelNo;
+	const uint16 *scalingX = getScalingTable(celWidth, scaleX, false);
+	const uint16 *scalingY = getScalingTable(celHeight, scaleY, true);
 
 	scaledWidth = MIN(clipRect.width(), scaledWidth);
 	scaledHeight = MIN(clipRect.height(), scaledHeight);
@@ -830,8 +934,8 @@ void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect,
 	if (offsetX < 0 || offsetY < 0)
 		return;
 
-	assert(scaledHeight + offsetY <= ARRAYSIZE(scalingY));
-	assert(scaledWidth + offsetX <= ARRAYSIZE(scalingX));
+	assert(scaledHeight + offsetY <= 480);
+	assert(scaledWidth + offsetX <= 640);
 	for (int y = 0; y < scaledHeight; y++) {
 		for (int x = 0; x < scaledWidth; x++) {
 			const byte color = bitmap[scalingY[y + offsetY] * celWidth + scalingX[x + offsetX]];
@@ -23,6 +23,8 @@
 #ifndef SCI_GRAPHICS_VIEW_H
 #define SCI_GRAPHICS_VIEW_H
 
+#include "common/hashmap.h"
+
 namespace Sci {
 
 enum Sci32ViewNativeResolution {
@@ -32,6 +34,14 @@ enum Sci32ViewNativeResolution {
 	SCI_VIEW_NATIVERES_640x400 = 2
 };
 
+/**
+ * A run of pixels in a row of a cel, which aren't transparent.
+ */
+struct CelSpan {
+	uint16 left;
+	uint16 right;
+};
+
 struct CelInfo {
 	int16 width, height;
 	int16 scriptWidth, scriptHeight;
@@ -42,6 +52,10 @@ struct CelInfo {
 	uint32 offsetRLE;
 	uint32 offsetLiteral;
 	byte *rawBitmap;
+	// The opaque runs of rawBitmap, row by row. The runs of row y are
+	// spans[spanRows[y]] up to spans[spanRows[y + 1]].
+	CelSpan *spans;
+	uint32 *spanRows;
 };
 
 struct LoopInfo {
@@ -52,6 +66,17 @@ struct LoopInfo {
 
 #define SCI_VIEW_EGAMAPPING_SIZE 16
 #define SCI_VIEW_EGAMAPPING_COUNT 8
+#define SCI_VIEW_MAX_SCALING_TABLES 64
+
+/**
+ * How often a view found decoded cels and scaling tables in its cache.
+ */
+struct ViewCacheStats {
+	uint32 celHits;
+	uint32 celMisses;
+	uint32 scalingHits;
+	uint32 scalingMisses;
+};
 
 class GfxScreen;
 class GfxPalette;
@@ -87,9 +112,16 @@ public:
 
 	byte getColorAtCoordinate(int16 loopNo, int16 celNo, int16 x, int16 y);
 
+	/** Returns the size of the decoded cels and scaling tables, in bytes. */
+	uint32 getDecodedSize() const { return _decodedSize; }
+	const ViewCacheStats &getCacheStats() const { return _cacheStats; }
+
 private:
 	void initData(GuiResourceId resourceId);
 	void unpackCel(int16 loopNo, int16 celNo, byte *outPtr, uint32 pixelCount);
+	const CelInfo *getSpans(int16 loopNo, int16 celNo);
+	const uint16 *getScalingTable(int16 celLength, int16 scale, bool vertical);
+	void purgeScalingTables();
 	void unditherBitmap(byte *bitmap, int16 width, int16 height, byte clearKey);
 
 	ResourceManager *_resMan;
@@ -118,6 +150,13 @@ private:
 	// this is not set for some views in laura bow 2 floppy and signals that the view shall never get scaled
 	//  even if scaleX/Y are set (inside kAnimate)
 	bool _isScaleable;
+
+	// scaling tables of drawScaled(), by scale and cel width/height, see getScalingTable()
+	typedef Common::HashMap<uint32, uint16 *> ScalingTableMap;
+	ScalingTableMap _scalingTables;
+
+	uint32 _decodedSize;
+	ViewCacheStats _cacheStats;
 };
 
 } // End of namespace Sci
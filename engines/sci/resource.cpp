@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/profiler.h"
 #include "common/textconsole.h"
 
 #include "sci/resource.h"
@@ -369,6 +370,8 @@ Common::SeekableReadStream *ResourceManager::getVolumeFile(ResourceSource *sourc
 }
 
 void ResourceManager::loadResource(Resource *res) {
+	PROFILE_ZONE("SCI loadResource");
+
 	res->_source->loadResource(this, res);
 }
 
@@ -1683,21 +1686,47 @@ int ResourceManager::readResourceMapSCI1(ResourceSource *map) {
 
 	// reading each type's offsets
 	uint32 fileOffset = 0;
+	byte *entryBuffer = 0;
+	uint32 entryBufferSize = 0;
 	for (type = 0; type < 32; type++) {
 		if (resMap[type].wOffset == 0) // this resource does not exist in map
 			continue;
 		fileStream->seek(resMap[type].wOffset);
+
+		// Parse the entries of the type from memory. Maps kept in memory are
+		// parsed in place, others are read with a single call. Every type is
+		// seeked to anyway, so the stream isn't moved past peeked entries.
+		uint32 entriesSize = resMap[type].wSize * nEntrySize;
+		int entryCount = resMap[type].wSize;
+		const byte *entries = fileStream->peekBuffer(entriesSize);
+		if (!entries) {
+			if (entriesSize > entryBufferSize) {
+				delete[] entryBuffer;
+				entryBuffer = new byte[entriesSize];
+				entryBufferSize = entriesSize;
+			}
+			entryCount = fileStream->read(entryBuffer, entriesSize) / nEntrySize;
+			entries = entryBuffer;
+		}
+
 		for (int i = 0; i < resMap[type].wSize; i++) {
-			uint16 number = fileStream->readUint16LE();
+			if (i >= entryCount || fileStream->err()) {
+				delete[] entryBuffer;
+				delete fileStream;
+				warning("Error while reading %s", map->getLocationName().c_str());
+				return SCI_ERROR_RESMAP_NOT_FOUND;
+			}
+			const byte *entry = entries + i * nEntrySize;
+			uint16 number = READ_LE_UINT16(entry);
 			int volume_nr = 0;
 			if (_mapVersion == kResVersionSci11) {
 				// offset stored in 3 bytes
-				fileOffset = fileStream->readUint16LE();
-				fileOffset |= fileStream->readByte() << 16;
+				fileOffset = READ_LE_UINT16(entry + 2);
+				fileOffset |= entry[4] << 16;
 				fileOffset <<= 1;
 			} else {
 				// offset/volume stored in 4 bytes
-				fileOffset = fileStream->readUint32LE();
+				fileOffset = READ_LE_UINT32(entry + 2);
 				if (_mapVersion < kResVersionSci11) {
 					volume_nr = fileOffset >> 28; // most significant 4 bits
 					fileOffset &= 0x0FFFFFFF;     // least significant 28 bits
@@ -1705,11 +1734,6 @@ int ResourceManager::readResourceMapSCI1(ResourceSource *map) {
 					// in SCI32 it's a plain offset
 				}
 			}
-			if (fileStream->eos() || fileStream->err()) {
-				delete fileStream;
-				warning("Error while reading %s", map->getLocationName().c_str());
-				return SCI_ERROR_RESMAP_NOT_FOUND;
-			}
 			resId = ResourceId(convertResType(type), number);
 			// NOTE: We add the map's volume number here to the specified volume number
 			// for SCI2.1 and SCI3 maps that are not resmap.000. The resmap.* files' numbers
@@ -1741,6 +1765,7 @@ int ResourceManager::readResourceMapSCI1(ResourceSource *map) {
 		}
 	}
 
+	delete[] entryBuffer;
 	delete fileStream;
 	return 0;
 }
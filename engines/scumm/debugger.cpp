@@ -34,9 +34,13 @@
 #include "scumm/resource.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
+#include "scumm/he/intern_he.h"
+#include "scumm/he/wiz_he.h"
 
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
 void debugC(int channel, const char *s, ...) {
 	char buf[STRINGBUFLEN];
 	va_list va;
@@ -98,6 +102,13 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	DCmd_Register("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
 	DCmd_Register("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+
+	DCmd_Register("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
+
+#ifdef ENABLE_HE
+	if (_vm->_game.heversion >= 71)
+		DCmd_Register("wizcache", WRAP_METHOD(ScummDebugger, Cmd_WizCache));
+#endif
 }
 
 ScummDebugger::~ScummDebugger() {
@@ -868,4 +879,65 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager *res = _vm->_res;
+
+	if (argc == 2) {
+		if (!strcmp(argv[1], "lru")) {
+			res->setExpirePolicy(kExpireLRU);
+		} else if (!strcmp(argv[1], "sized")) {
+			res->setExpirePolicy(kExpireSizeWeighted);
+		} else {
+			DebugPrintf("Syntax: resources [lru|sized]\n");
+			return true;
+		}
+	}
+
+	DebugPrintf("Heap: %d bytes allocated, %d peak, thresholds %d-%d\n",
+		res->getAllocatedSize(), res->getPeakAllocatedSize(),
+		res->getMinHeapThreshold(), res->getMaxHeapThreshold());
+	DebugPrintf("Expire policy: %s, %d expire runs\n",
+		res->getExpirePolicy() == kExpireSizeWeighted ? "sized" : "lru", res->getNumExpireRuns());
+
+	DebugPrintf("\nType          Loaded      Bytes  Expired      Bytes\n");
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		const ResourceManager::ResTypeData &typeData = res->_types[type];
+		if (!typeData._numLoaded && !typeData._numExpired)
+			continue;
+		DebugPrintf("%-12s %7d %10d %8d %10d\n", nameOfResType(type),
+			typeData._numLoaded, typeData._loadedSize, typeData._numExpired, typeData._expiredSize);
+	}
+
+	DebugPrintf("\nSize class      Loaded\n");
+	for (int i = 0; i < kResSizeClasses; i++) {
+		if (!res->getSizeClassCount(i))
+			continue;
+		if (i == kResSizeClasses - 1)
+			DebugPrintf(">= %-11d %7d\n", 1 << (i - 1), res->getSizeClassCount(i));
+		else
+			DebugPrintf("< %-12d %7d\n", 1 << i, res->getSizeClassCount(i));
+	}
+
+	return true;
+}
+
+#ifdef ENABLE_HE
+bool ScummDebugger::Cmd_WizCache(int argc, const char **argv) {
+	Wiz *wiz = ((ScummEngine_v71he *)_vm)->_wiz;
+
+	if (argc == 2 && !strcmp(argv[1], "purge")) {
+		wiz->purgeWizCache();
+	} else if (argc != 1) {
+		DebugPrintf("Syntax: wizcache [purge]\n");
+		return true;
+	}
+
+	const WizCacheStats &stats = wiz->getWizCacheStats();
+	DebugPrintf("Wiz cache: %d images, %d bytes\n", wiz->getWizCacheCount(), wiz->getWizCacheSize());
+	DebugPrintf("%d hits, %d misses, %d purges\n", stats.hits, stats.misses, stats.purges);
+
+	return true;
+}
+#endif
+
 } // End of namespace Scumm
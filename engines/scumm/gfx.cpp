@@ -214,9 +214,13 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+	_stripCacheEnabled = true;
+	_stripCacheSize = 0;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
 }
 
 Gdi::~Gdi() {
+	clearStripCache();
 }
 
 GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(0) {
@@ -224,11 +228,13 @@ GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(0) {
 
 
 GdiNES::GdiNES(ScummEngine *vm) : Gdi(vm) {
+	_stripCacheEnabled = false;
 	memset(&_NES, 0, sizeof(_NES));
 }
 
 #ifdef USE_RGB_COLOR
 GdiPCEngine::GdiPCEngine(ScummEngine *vm) : Gdi(vm) {
+	_stripCacheEnabled = false;
 	memset(&_PCE, 0, sizeof(_PCE));
 }
 
@@ -240,10 +246,12 @@ GdiPCEngine::~GdiPCEngine() {
 #endif
 
 GdiV1::GdiV1(ScummEngine *vm) : Gdi(vm) {
+	_stripCacheEnabled = false;
 	memset(&_V1, 0, sizeof(_V1));
 }
 
 GdiV2::GdiV2(ScummEngine *vm) : Gdi(vm) {
+	_stripCacheEnabled = false;
 	_roomStrips = 0;
 }
 
@@ -253,6 +261,8 @@ GdiV2::~GdiV2() {
 
 #ifdef USE_RGB_COLOR
 GdiHE16bit::GdiHE16bit(ScummEngine *vm) : GdiHE(vm) {
+	// The room colors depend on the current palette
+	_stripCacheEnabled = false;
 }
 #endif
 
@@ -271,9 +281,15 @@ void Gdi::init() {
 		// the backbuf (thus we have to treat the right border seperately).
 		_numStrips += 1;
 	}
+
+	// The Amiga versions pick the palette map of the strips depending on
+	// the virtual screen, and shift their colors
+	if (_vm->_game.platform == Common::kPlatformAmiga)
+		_stripCacheEnabled = false;
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -573,27 +589,50 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
-
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
-			vs->tdirty[i] = vs->h;
-			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
+	int start = -1;
+	int top = 0, bottom = 0;
+	int dirtyArea = 0;
+
+	for (int i = 0; i < _gdi->_numStrips; i++) {
+		if (!vs->bdirty[i]) {
+			if (start >= 0) {
+				drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
+				start = -1;
+			}
+			continue;
+		}
+
+		const int stripTop = vs->tdirty[i];
+		const int stripBottom = vs->bdirty[i];
+		vs->tdirty[i] = vs->h;
+		vs->bdirty[i] = 0;
+
+		if (start >= 0) {
+			// Neighboring strips are coalesced into one bigger rectangle,
+			// as long as that doesn't blit much more than what is dirty.
+			// Every blit to the screen has its own overhead.
+			const int mergedTop = MIN(top, stripTop);
+			const int mergedBottom = MAX(bottom, stripBottom);
+			const int mergedDirtyArea = dirtyArea + stripBottom - stripTop;
+
+			if ((i + 1 - start) * (mergedBottom - mergedTop) <= mergedDirtyArea * 3 / 2) {
+				top = mergedTop;
+				bottom = mergedBottom;
+				dirtyArea = mergedDirtyArea;
 				continue;
 			}
-			drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
+
+			drawStripToScreen(vs, start * 8, (i - start) * 8, top, bottom);
 		}
-		start = i + 1;
+
+		start = i;
+		top = stripTop;
+		bottom = stripBottom;
+		dirtyArea = stripBottom - stripTop;
 	}
+
+	if (start >= 0)
+		drawStripToScreen(vs, start * 8, (_gdi->_numStrips - start) * 8, top, bottom);
 }
 
 /**
@@ -1797,6 +1836,22 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	// Strips are cached along with the masks decoded for them, unless
+	// these are combined with the existing masks
+	bool useStripCache = _stripCacheEnabled && vs->format.bytesPerPixel == 1;
+	uint16 maskPlanes = 0;
+	if (useStripCache) {
+		if (memcmp(_stripCachePalette, _roomPalette, sizeof(_stripCachePalette))) {
+			clearStripCache();
+			memcpy(_stripCachePalette, _roomPalette, sizeof(_stripCachePalette));
+		}
+
+		for (int i = 1; i < numzbuf; i++) {
+			if (zplane_list[i])
+				maskPlanes |= 1 << i;
+		}
+	}
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1829,12 +1884,27 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->pixels + y * vs->pitch + (x * 8 * vs->format.bytesPerPixel);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const StripCacheEntry *cachedStrip = 0;
+		if (useStripCache)
+			cachedStrip = findCachedStrip(smap_ptr, stripnr, y, height);
+
+		if (cachedStrip) {
+			blit(dstPtr, vs->pitch, cachedStrip->data, 8, 8, height, 1);
+			transpStrip = false;
+		} else {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		}
+
+		// Only opaque strips are cached, as the others depend on what was
+		// drawn before
+		const bool cacheStripNow = useStripCache && !cachedStrip && !transpStrip;
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
 			transpStrip = true;
 
+		const bool cacheMasks = canCacheMasks(transpStrip, flag);
+
 		if (vs->hasTwoBuffers) {
 			byte *frontBuf = (byte *)vs->pixels + y * vs->pitch + (x * 8 * vs->format.bytesPerPixel);
 			if (lightsOn)
@@ -1843,7 +1913,21 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (cachedStrip && cacheMasks && cachedStrip->maskPlanes == maskPlanes) {
+			const byte *src = cachedStrip->data + 8 * height;
+			for (int i = 1; i < numzbuf; i++) {
+				if (!(maskPlanes & (1 << i)))
+					continue;
+
+				blit(getMaskBuffer(x, y, i), _numStrips, src, 1, 1, height, 1);
+				src += height;
+			}
+		} else {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		}
+
+		if (cacheStripNow)
+			cacheStrip(dstPtr, vs->pitch, x, y, height, stripnr, smap_ptr, cacheMasks ? maskPlanes : 0);
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -1871,6 +1955,86 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+bool Gdi::canCacheMasks(bool transpStrip, byte flag) const {
+	// Masks which are ORed into the existing ones depend on what was drawn before
+	return !(flag & dbDrawMaskOnAll) && !(transpStrip && (flag & dbAllowMaskOr));
+}
+
+bool GdiHE::canCacheMasks(bool transpStrip, byte flag) const {
+	// TMSK masks are combined with the existing ones too
+	return !_tmskPtr && Gdi::canCacheMasks(transpStrip, flag);
+}
+
+static uint32 stripCacheKey(const byte *smap_ptr, int stripnr) {
+	return (uint32)(size_t)smap_ptr + stripnr * 0x9E3779B1;
+}
+
+const Gdi::StripCacheEntry *Gdi::findCachedStrip(const byte *smap_ptr, int stripnr, int y, int height) const {
+	StripCache::const_iterator it = _stripCache.find(stripCacheKey(smap_ptr, stripnr));
+	if (it == _stripCache.end())
+		return 0;
+
+	const StripCacheEntry *entry = it->_value;
+	if (entry->smapPtr != smap_ptr || entry->stripnr != stripnr || entry->y != y || entry->height != height)
+		return 0;
+
+	return entry;
+}
+
+void Gdi::cacheStrip(const byte *src, int srcPitch, int x, int y, int height, int stripnr, const byte *smap_ptr, uint16 maskPlanes) {
+	int numPlanes = 0;
+	for (int i = 1; i < 16; i++) {
+		if (maskPlanes & (1 << i))
+			numPlanes++;
+	}
+
+	const uint32 size = (8 + numPlanes) * height;
+	if (_stripCacheSize + size > kMaxStripCacheSize) {
+		debugC(DEBUG_GENERAL, "Strip cache is full, purging %d strips", _stripCache.size());
+		clearStripCache();
+	}
+
+	const uint32 key = stripCacheKey(smap_ptr, stripnr);
+	StripCache::iterator it = _stripCache.find(key);
+	if (it != _stripCache.end()) {
+		_stripCacheSize -= it->_value->size;
+		free(it->_value->data);
+		delete it->_value;
+		_stripCache.erase(it);
+	}
+
+	StripCacheEntry *entry = new StripCacheEntry;
+	entry->smapPtr = smap_ptr;
+	entry->stripnr = stripnr;
+	entry->y = y;
+	entry->height = height;
+	entry->maskPlanes = maskPlanes;
+	entry->size = size;
+	entry->data = (byte *)malloc(size);
+
+	blit(entry->data, 8, src, srcPitch, 8, height, 1);
+	byte *dst = entry->data + 8 * height;
+	for (int i = 1; i < 16; i++) {
+		if (!(maskPlanes & (1 << i)))
+			continue;
+
+		blit(dst, 1, getMaskBuffer(x, y, i), _numStrips, 1, height, 1);
+		dst += height;
+	}
+
+	_stripCache[key] = entry;
+	_stripCacheSize += size;
+}
+
+void Gdi::clearStripCache() {
+	for (StripCache::iterator it = _stripCache.begin(); it != _stripCache.end(); ++it) {
+		free(it->_value->data);
+		delete it->_value;
+	}
+	_stripCache.clear();
+	_stripCacheSize = 0;
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
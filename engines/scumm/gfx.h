@@ -23,6 +23,7 @@
 #ifndef SCUMM_GFX_H
 #define SCUMM_GFX_H
 
+#include "common/hashmap.h"
 #include "common/system.h"
 #include "common/list.h"
 
@@ -197,6 +198,32 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * A decoded opaque strip of a room or object image, along with the
+	 * z-plane masks decoded for it.
+	 */
+	struct StripCacheEntry {
+		const byte *smapPtr;
+		int stripnr;
+		int y;
+		int height;
+		uint16 maskPlanes;  ///< Bit i is set if z-plane i is cached.
+		uint32 size;
+		byte *data;         ///< 8 pixels per line, followed by one byte per line for every cached z-plane.
+	};
+
+	typedef Common::HashMap<uint32, StripCacheEntry *> StripCache;
+
+	enum {
+		kMaxStripCacheSize = 1024 * 1024
+	};
+
+	/** Whether the strips only depend on the image data, which is what the strip cache needs. */
+	bool _stripCacheEnabled;
+	StripCache _stripCache;
+	uint32 _stripCacheSize;
+	byte _stripCachePalette[256];
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -244,6 +271,12 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
 
+	/** Whether the masks decoded for a strip only depend on the image, so they can be cached. */
+	virtual bool canCacheMasks(bool transpStrip, byte flag) const;
+
+	const StripCacheEntry *findCachedStrip(const byte *smap_ptr, int stripnr, int y, int height) const;
+	void cacheStrip(const byte *src, int srcPitch, int x, int y, int height, int stripnr, const byte *smap_ptr, uint16 maskPlanes);
+
 public:
 	Gdi(ScummEngine *vm);
 	virtual ~Gdi();
@@ -267,6 +300,8 @@ public:
 
 	void resetBackground(int top, int bottom, int strip);
 
+	void clearStripCache();
+
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
@@ -288,6 +323,8 @@ protected:
 	virtual void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
+
+	virtual bool canCacheMasks(bool transpStrip, byte flag) const;
 public:
 	GdiHE(ScummEngine *vm);
 };
@@ -286,6 +286,7 @@ void Wiz::fillWizFlood(const WizParameters *params) {
 			}
 		}
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
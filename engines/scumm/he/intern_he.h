@@ -191,6 +191,7 @@ protected:
 	virtual void setupOpcodes();
 
 	virtual void saveOrLoad(Serializer *s);
+	virtual void resourceNuked(ResType type, ResId idx);
 
 	virtual void redrawBGAreas();
 
@@ -251,6 +251,14 @@ void ScummEngine_v70he::readGlobalObjects() {
 }
 
 #ifdef ENABLE_HE
+void ScummEngine_v71he::resourceNuked(ResType type, ResId idx) {
+	ScummEngine_v70he::resourceNuked(type, idx);
+
+	// Drop the decoded copies of an expired image, its memory may be reused
+	if (type == rtImage)
+		_wiz->invalidateWizCache(idx);
+}
+
 void ScummEngine_v99he::readMAXS(int blockSize) {
 	if (blockSize == 52) {
 		_numVariables = _fileHandle->readUint16LE();
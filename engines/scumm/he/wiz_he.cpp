@@ -23,6 +23,7 @@
 #ifdef ENABLE_HE
 
 #include "common/archive.h"
+#include "common/array.h"
 #include "common/system.h"
 #include "graphics/cursorman.h"
 #include "graphics/primitives.h"
@@ -40,6 +41,12 @@ Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+	_cacheSize = 0;
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
+}
+
+Wiz::~Wiz() {
+	purgeWizCache();
 }
 
 void Wiz::clearWizBuffer() {
@@ -942,6 +949,204 @@ template void Wiz::decompressWizImage<kWizXMap>(uint8 *dst, int dstPitch, int ds
 template void Wiz::decompressWizImage<kWizRMap>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 template void Wiz::decompressWizImage<kWizCopy>(uint8 *dst, int dstPitch, int dstType, const uint8 *src, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 
+static void freeWizCacheEntry(WizCacheEntry *entry) {
+	delete[] entry->pixels;
+	delete[] entry->spans;
+	delete[] entry->spanRows;
+	delete entry;
+}
+
+void Wiz::invalidateWizCache(int resNum) {
+	Common::Array<uint32> keys;
+	for (WizCache::const_iterator it = _cache.begin(); it != _cache.end(); ++it) {
+		if ((int)(it->_key >> 16) == resNum)
+			keys.push_back(it->_key);
+	}
+
+	for (uint i = 0; i < keys.size(); i++) {
+		WizCacheEntry *entry = _cache[keys[i]];
+		_cacheSize -= entry->size;
+		freeWizCacheEntry(entry);
+		_cache.erase(keys[i]);
+	}
+}
+
+void Wiz::purgeWizCache() {
+	for (WizCache::iterator it = _cache.begin(); it != _cache.end(); ++it)
+		freeWizCacheEntry(it->_value);
+	_cache.clear();
+	_cacheSize = 0;
+}
+
+const WizCacheEntry *Wiz::getCachedWizImage(int resNum, int state, const uint8 *wizd, int width, int height) {
+	const uint32 key = (resNum << 16) | (state & 0xFFFF);
+	const uint32 wizdSize = _vm->getResourceDataSize(wizd);
+
+	WizCache::iterator it = _cache.find(key);
+	if (it != _cache.end()) {
+		WizCacheEntry *entry = it->_value;
+
+		// The resource may have been expired and loaded again since
+		if (entry->wizd == wizd && entry->wizdSize == wizdSize && entry->width == width && entry->height == height) {
+			_cacheStats.hits++;
+			return entry;
+		}
+
+		_cacheSize -= entry->size;
+		freeWizCacheEntry(entry);
+		_cache.erase(it);
+	}
+
+	_cacheStats.misses++;
+
+	const uint32 pixelSize = width * height;
+	if (width <= 0 || height <= 0 || width > 0xFFFF || pixelSize > MAX_CACHED_WIZ_SIZE / 2)
+		return 0;
+
+	if (_cacheSize + pixelSize > MAX_CACHED_WIZ_SIZE) {
+		debugC(DEBUG_RESOURCE, "Wiz cache is full, purging %d images", _cache.size());
+		purgeWizCache();
+		_cacheStats.purges++;
+	}
+
+	uint8 *pixels = new uint8[pixelSize];
+	uint32 *spanRows = new uint32[height + 1];
+	Common::Array<WizSpan> spans;
+
+	const uint8 *dataPtr = wizd;
+	const uint8 *dataEnd = wizd + wizdSize;
+
+	for (int y = 0; y < height; y++) {
+		spanRows[y] = spans.size();
+		if (dataPtr + 2 > dataEnd)
+			continue;
+
+		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
+		const uint8 *dataPtrNext = MIN(dataPtr + lineSize, dataEnd);
+		uint8 *row = pixels + y * width;
+		int x = 0;
+
+		while (x < width && dataPtr < dataPtrNext) {
+			uint8 code = *dataPtr++;
+			if (code & 1) {
+				x += code >> 1;
+				continue;
+			}
+
+			int count = MIN((code >> 2) + 1, width - x);
+			if (code & 2) {
+				if (dataPtr >= dataPtrNext)
+					break;
+				memset(row + x, *dataPtr++, count);
+			} else {
+				count = MIN<int>(count, dataPtrNext - dataPtr);
+				memcpy(row + x, dataPtr, count);
+				dataPtr += (code >> 2) + 1;
+			}
+
+			// Runs and literals often follow each other
+			if (spans.size() > spanRows[y] && spans.back().right == x) {
+				spans.back().right = x + count;
+			} else {
+				WizSpan span = { (uint16)x, (uint16)(x + count) };
+				spans.push_back(span);
+			}
+			x += count;
+		}
+
+		dataPtr = dataPtrNext;
+	}
+	spanRows[height] = spans.size();
+
+	WizCacheEntry *entry = new WizCacheEntry;
+	entry->wizd = wizd;
+	entry->wizdSize = wizdSize;
+	entry->width = width;
+	entry->height = height;
+	entry->pixels = pixels;
+	entry->spans = new WizSpan[MAX<uint>(spans.size(), 1)];
+	for (uint i = 0; i < spans.size(); i++)
+		entry->spans[i] = spans[i];
+	entry->spanRows = spanRows;
+	entry->size = pixelSize + spans.size() * sizeof(WizSpan) + (height + 1) * sizeof(uint32) + sizeof(WizCacheEntry);
+
+	_cache[key] = entry;
+	_cacheSize += entry->size;
+
+	return entry;
+}
+
+void Wiz::copyCachedWizImage(uint8 *dst, const WizCacheEntry *entry, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	Common::Rect r1, r2;
+	if (calcClipRects(dstw, dsth, srcx, srcy, entry->width, entry->height, rect, r1, r2)) {
+		dst += r2.top * dstPitch + r2.left * bitDepth;
+		if (flags & kWIFFlipY) {
+			const int dy = (srcy < 0) ? srcy : (entry->height - r1.height());
+			r1.translate(0, dy);
+		}
+		if (flags & kWIFFlipX) {
+			const int dx = (srcx < 0) ? srcx : (entry->width - r1.width());
+			r1.translate(dx, 0);
+		}
+		if (xmapPtr) {
+			drawCachedWizImage<kWizXMap>(dst, dstPitch, dstType, entry, r1, flags, palPtr, xmapPtr, bitDepth);
+		} else if (palPtr) {
+			drawCachedWizImage<kWizRMap>(dst, dstPitch, dstType, entry, r1, flags, palPtr, NULL, bitDepth);
+		} else {
+			drawCachedWizImage<kWizCopy>(dst, dstPitch, dstType, entry, r1, flags, NULL, NULL, bitDepth);
+		}
+	}
+}
+
+template<int type>
+void Wiz::drawCachedWizImage(uint8 *dst, int dstPitch, int dstType, const WizCacheEntry *entry, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	const int h = srcRect.height();
+	const int w = srcRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	if (flags & kWIFFlipY) {
+		dst += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	int dstInc = bitDepth;
+	if (flags & kWIFFlipX) {
+		dst += (w - 1) * bitDepth;
+		dstInc = -bitDepth;
+	}
+
+	for (int y = srcRect.top; y < srcRect.bottom; y++, dst += dstPitch) {
+		// Flipped images clipped at the top or left end up partly outside
+		// of the source, like in decompressWizImage()
+		if (y < 0 || y >= entry->height)
+			continue;
+
+		const uint8 *row = entry->pixels + y * entry->width;
+		const WizSpan *span = entry->spans + entry->spanRows[y];
+		const WizSpan *spanEnd = entry->spans + entry->spanRows[y + 1];
+
+		// Only the opaque spans are visited, the transparent pixels in
+		// between are skipped at once
+		for (; span < spanEnd && span->left < srcRect.right; span++) {
+			const int left = MAX<int>(span->left, srcRect.left);
+			const int right = MIN<int>(span->right, srcRect.right);
+			if (left >= right)
+				continue;
+
+			uint8 *dstPtr = dst + (left - srcRect.left) * dstInc;
+			if (type == kWizCopy && dstInc == 1) {
+				memcpy(dstPtr, row + left, right - left);
+				continue;
+			}
+
+			for (int x = left; x < right; x++) {
+				write8BitColor<type>(dstPtr, row + x, dstType, palPtr, xmapPtr, bitDepth);
+				dstPtr += dstInc;
+			}
+		}
+	}
+}
+
 template<int type>
 void Wiz::decompressRawWizImage(uint8 *dst, int dstPitch, int dstType, const uint8 *src, int srcPitch, int w, int h, int transColor, const uint8 *palPtr, uint8 bitDepth) {
 	if (type == kWizRMap) {
@@ -1408,6 +1613,7 @@ void Wiz::captureImage(uint8 *src, int srcPitch, int srcw, int srch, int resNum,
 			break;
 		}
 	}
+	invalidateWizCache(resNum);
 	_vm->_res->setModified(rtImage, resNum);
 }
 
@@ -1525,6 +1731,7 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 			assert(dstPtr);
 			dst = _vm->findWrappedBlock(MKTAG('W','I','Z','D'), dstPtr, 0, 0);
 			assert(dst);
+			invalidateWizCache(dstResNum);
 			getWizImageDim(dstResNum, 0, cw, ch);
 			dstPitch = cw * _vm->_bytesPerPixel;
 			dstType = kDstResource;
@@ -1582,7 +1789,12 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 			dstPitch /= _vm->_bytesPerPixel;
 			copyWizImageWithMask(dst, wizd, dstPitch, cw, ch, x1, y1, width, height, &rScreen, 0, 1);
 		} else {
-			copyWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
+			const WizCacheEntry *entry = getCachedWizImage(resNum, state, wizd, width, height);
+			if (entry) {
+				copyCachedWizImage(dst, entry, dstPitch, dstType, cw, ch, x1, y1, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
+			} else {
+				copyWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
+			}
 		}
 		break;
 #ifdef USE_RGB_COLOR
@@ -1841,6 +2053,7 @@ void Wiz::drawWizPolygonTransform(int resNum, int state, Common::Point *wp, int
 		assert(dstPtr);
 		dst = _vm->findWrappedBlock(MKTAG('W','I','Z','D'), dstPtr, 0, 0);
 		assert(dst);
+		invalidateWizCache(dstResNum);
 		getWizImageDim(dstResNum, 0, dstw, dsth);
 		dstpitch = dstw * _vm->_bytesPerPixel;
 		dstType = kDstResource;
@@ -2172,6 +2385,7 @@ void Wiz::createWizEmptyImage(int resNum, int img_x, int img_y, int img_w, int i
 		WRITE_BE_UINT32(res_data, 'WIZD'); res_data += 4;
 		WRITE_BE_UINT32(res_data, 8 + img_w * img_h * bitDepth); res_data += 4;
 	}
+	invalidateWizCache(resNum);
 	_vm->_res->setModified(rtImage, resNum);
 }
 
@@ -2223,6 +2437,7 @@ void Wiz::fillWizRect(const WizParameters *params) {
 			}
 		}
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2293,6 +2508,7 @@ void Wiz::fillWizLine(const WizParameters *params) {
 			}
 		}
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2330,6 +2546,7 @@ void Wiz::fillWizPixel(const WizParameters *params) {
 			}
 		}
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2346,6 +2563,7 @@ void Wiz::remapWizImagePal(const WizParameters *params) {
 		uint8 idx = *index++;
 		rmap[4 + idx] = params->remapColor[idx];
 	}
+	invalidateWizCache(params->img.resNum);
 	_vm->_res->setModified(rtImage, params->img.resNum);
 }
 
@@ -2387,6 +2605,7 @@ void Wiz::processWizImage(const WizParameters *params) {
 						_vm->VAR(_vm->VAR_GAME_LOADED) = -2;
 						_vm->VAR(119) = -2;
 					} else {
+						invalidateWizCache(params->img.resNum);
 						_vm->_res->setModified(rtImage, params->img.resNum);
 						_vm->VAR(_vm->VAR_GAME_LOADED) = 0;
 						_vm->VAR(119) = 0;
@@ -2497,6 +2716,7 @@ void Wiz::processWizImage(const WizParameters *params) {
 	case 17:
 		// Used in to draw circles in FreddisFunShop/PuttsFunShop/SamsFunShop
 		// TODO: Ellipse
+		invalidateWizCache(params->img.resNum);
 		_vm->_res->setModified(rtImage, params->img.resNum);
 		break;
 	default:
@@ -23,6 +23,7 @@
 #if !defined(SCUMM_HE_WIZ_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_WIZ_HE_H
 
+#include "common/hashmap.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -146,6 +147,34 @@ enum DstSurface {
  	kDstCursor   = 3
 };
 
+/** An opaque run of pixels in a row of a decoded Wiz image, right exclusive. */
+struct WizSpan {
+	uint16 left;
+	uint16 right;
+};
+
+/**
+ * A decoded 8 bit RLE Wiz image: the color indices of the image and the
+ * opaque spans of each row. The palette, remap table and XMAP are applied
+ * when drawing, so one entry serves all of them.
+ */
+struct WizCacheEntry {
+	const uint8 *wizd;  ///< The WIZD data the image was decoded from.
+	uint32 wizdSize;
+	int width;
+	int height;
+	uint8 *pixels;
+	WizSpan *spans;
+	uint32 *spanRows;   ///< The spans of row y are spans[spanRows[y]] up to spans[spanRows[y + 1]].
+	uint32 size;        ///< The memory used by the entry.
+};
+
+struct WizCacheStats {
+	uint32 hits;
+	uint32 misses;
+	uint32 purges;
+};
+
 class ScummEngine_v71he;
 
 class Wiz {
@@ -155,11 +184,16 @@ public:
 		NUM_IMAGES   = 255
 	};
 
+	enum {
+		MAX_CACHED_WIZ_SIZE = 4 * 1024 * 1024
+	};
+
 	WizImage _images[NUM_IMAGES];
 	uint16 _imagesNum;
 	WizPolygon _polygons[NUM_POLYGONS];
 
 	Wiz(ScummEngine_v71he *vm);
+	~Wiz();
 
 	void clearWizBuffer();
 	Common::Rect _rectOverride;
@@ -192,6 +226,12 @@ public:
 
 	void flushWizBuffer();
 
+	void invalidateWizCache(int resNum);
+	void purgeWizCache();
+	const WizCacheStats &getWizCacheStats() const { return _cacheStats; }
+	uint getWizCacheCount() const { return _cache.size(); }
+	uint32 getWizCacheSize() const { return _cacheSize; }
+
 	void getWizImageSpot(int resId, int state, int32 &x, int32 &y);
 	void loadWizCursor(int resId, int palette);
 
@@ -238,6 +278,16 @@ public:
 
 private:
 	ScummEngine_v71he *_vm;
+
+	typedef Common::HashMap<uint32, WizCacheEntry *> WizCache;
+
+	WizCache _cache;
+	uint32 _cacheSize;
+	WizCacheStats _cacheStats;
+
+	const WizCacheEntry *getCachedWizImage(int resNum, int state, const uint8 *wizd, int width, int height);
+	void copyCachedWizImage(uint8 *dst, const WizCacheEntry *entry, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void drawCachedWizImage(uint8 *dst, int dstPitch, int dstType, const WizCacheEntry *entry, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 };
 
 } // End of namespace Scumm
@@ -229,15 +229,21 @@ bool BundleMgr::loadCompTable(int32 index) {
 
 	_compTable = (CompTable *)malloc(sizeof(CompTable) * _numCompItems);
 	assert(_compTable);
+
+	// Each entry holds the offset, size and codec, followed by an unused word
+	uint32 *entries = new uint32[_numCompItems * 4];
+	_file->readUint32BEArray(entries, _numCompItems * 4);
+
 	int32 maxSize = 0;
 	for (int i = 0; i < _numCompItems; i++) {
-		_compTable[i].offset = _file->readUint32BE();
-		_compTable[i].size = _file->readUint32BE();
-		_compTable[i].codec = _file->readUint32BE();
-		_file->seek(4, SEEK_CUR);
+		_compTable[i].offset = entries[i * 4 + 0];
+		_compTable[i].size = entries[i * 4 + 1];
+		_compTable[i].codec = entries[i * 4 + 2];
 		if (_compTable[i].size > maxSize)
 			maxSize = _compTable[i].size;
 	}
+	delete[] entries;
+
 	// CMI hack: one more byte at the end of input buffer
 	_compInputBuff = (byte *)malloc(maxSize + 1);
 	assert(_compInputBuff);
@@ -20,9 +20,11 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/str.h"
 #ifndef MACOSX
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #endif
 
 #include "scumm/charset.h"
@@ -539,7 +541,10 @@ void ResourceManager::allocResTypeData(ResType type, uint32 tag, int num, ResTyp
 	_types[type]._tag = tag;
 
 	// If there was data in there, let's clear it out completely. This is important
-	// in case we are restarting the game.
+	// in case we are restarting the game. Nuke the resources first, so that the
+	// heap accounting stays correct.
+	for (ResId idx = 0; idx < _types[type].size(); idx++)
+		nukeResource(type, idx);
 	_types[type].clear();
 	_types[type].resize(num);
 
@@ -619,6 +624,8 @@ void ScummEngine::ensureResourceLoaded(ResType type, ResId idx) {
 }
 
 int ScummEngine::loadResource(ResType type, ResId idx) {
+	PROFILE_ZONE("SCUMM loadResource");
+
 	int roomNr;
 	uint32 fileOffs;
 	uint32 size, tag;
@@ -830,6 +837,12 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	memset(ptr, 0, size + SAFETY_AREA);
 	_allocatedSize += size;
+	if (_allocatedSize > _peakAllocatedSize)
+		_peakAllocatedSize = _allocatedSize;
+
+	_types[type]._numLoaded++;
+	_types[type]._loadedSize += size;
+	_sizeClassCount[getSizeClass(size)]++;
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
@@ -862,6 +875,10 @@ void ResourceManager::Resource::nuke() {
 ResourceManager::ResTypeData::ResTypeData() {
 	_mode = kDynamicResTypeMode;
 	_tag = 0;
+	_numLoaded = 0;
+	_loadedSize = 0;
+	_numExpired = 0;
+	_expiredSize = 0;
 }
 
 ResourceManager::ResTypeData::~ResTypeData() {
@@ -872,6 +889,10 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_expirePolicy = kExpireLRU;
+	_peakAllocatedSize = 0;
+	_numExpireRuns = 0;
+	memset(_sizeClassCount, 0, sizeof(_sizeClassCount));
 }
 
 ResourceManager::~ResourceManager() {
@@ -897,8 +918,29 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	byte *ptr = _types[type][idx]._address;
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
-		_allocatedSize -= _types[type][idx]._size;
+		const uint32 size = _types[type][idx]._size;
+		_allocatedSize -= size;
+		_types[type]._numLoaded--;
+		_types[type]._loadedSize -= size;
+		_sizeClassCount[getSizeClass(size)]--;
 		_types[type][idx].nuke();
+		_vm->resourceNuked(type, idx);
+	}
+}
+
+void ScummEngine::resourceNuked(ResType type, ResId idx) {
+	// The strip cache is keyed on the image addresses, which may be reused
+	// by the next resource
+	switch (type) {
+	case rtRoom:
+	case rtRoomImage:
+	case rtInventory:
+	case rtVerb:
+	case rtFlObject:
+		_gdi->clearStripCache();
+		break;
+	default:
+		break;
 	}
 }
 
@@ -1032,10 +1074,41 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+namespace {
+
+struct ExpireCandidate {
+	ResType type;
+	ResId idx;
+	uint32 weight;
+};
+
+/**
+ * Orders expire candidates by descending weight. Ties are broken the same
+ * way the former linear search did, which picked the candidate with the
+ * highest type and, within that, the lowest index.
+ */
+struct ExpireCandidateLess {
+	bool operator()(const ExpireCandidate &a, const ExpireCandidate &b) const {
+		if (a.weight != b.weight)
+			return a.weight > b.weight;
+		if (a.type != b.type)
+			return a.type > b.type;
+		return a.idx < b.idx;
+	}
+};
+
+} // End of anonymous namespace
+
+int ResourceManager::getSizeClass(uint32 size) {
+	int sizeClass = 0;
+	while (size && sizeClass < kResSizeClasses - 1) {
+		size >>= 1;
+		sizeClass++;
+	}
+	return sizeClass;
+}
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1047,32 +1120,45 @@ void ResourceManager::expireResources(uint32 size) {
 		return;
 
 	oldAllocatedSize = _allocatedSize;
+	_numExpireRuns++;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
+	// Gather all resources which may be expired in a single pass, then sort
+	// them once, instead of searching all resources again for every single
+	// resource that is thrown out.
+	Common::Array<ExpireCandidate> candidates;
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		if (_types[type]._mode != kDynamicResTypeMode && _types[type]._numLoaded) {
+			// Resources of this type can be reloaded from the data files,
+			// so we can potentially unload them to free memory.
+			ResId idx = _types[type].size();
+			while (idx-- > 0) {
+				Resource &tmp = _types[type][idx];
+				byte counter = tmp.getResourceCounter();
+				if (!tmp.isLocked() && counter >= 2 && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+					ExpireCandidate candidate;
+					candidate.type = type;
+					candidate.idx = idx;
+					if (_expirePolicy == kExpireSizeWeighted)
+						candidate.weight = counter * ((tmp._size >> 10) + 1);
+					else
+						candidate.weight = counter;
+					candidates.push_back(candidate);
 				}
 			}
 		}
+	}
+
+	Common::sort(candidates.begin(), candidates.end(), ExpireCandidateLess());
 
-		if (!best_type)
+	for (Common::Array<ExpireCandidate>::const_iterator i = candidates.begin(); i != candidates.end(); ++i) {
+		ResTypeData &typeData = _types[i->type];
+		typeData._numExpired++;
+		typeData._expiredSize += typeData[i->idx]._size;
+		nukeResource(i->type, i->idx);
+
+		if (size + _allocatedSize <= _minHeapThreshold)
 			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+	}
 
 	increaseResourceCounters();
 
@@ -68,6 +68,25 @@ enum ResTypeMode {
 	kSoundResTypeMode = 2		///< Resource comes from data files, but may change
 };
 
+/**
+ * The policy used to pick resources to expire when the heap threshold is
+ * exceeded. In both cases only unlocked, unused resources which can be
+ * reloaded from the data files are considered.
+ */
+enum ResExpirePolicy {
+	kExpireLRU = 0,			///< Expire the least recently used resources first
+	kExpireSizeWeighted = 1	///< Weigh the resource age by its size, so large old resources go first
+};
+
+enum {
+	/**
+	 * Number of power-of-two size classes used for accounting loaded
+	 * resources. The last class holds everything of 2^(kResSizeClasses - 2)
+	 * bytes and up.
+	 */
+	kResSizeClasses = 24
+};
+
 /**
  * The 'resource manager' class. Currently doesn't really deserve to be called
  * a 'class', at least until somebody gets around to OOfying this more.
@@ -164,6 +183,19 @@ public:
 		 */
 		uint32 _tag;
 
+		/**
+		 * Number of currently loaded resources of this type and their
+		 * total size.
+		 */
+		uint32 _numLoaded;
+		uint32 _loadedSize;
+
+		/**
+		 * Number of resources of this type expired so far and their total size.
+		 */
+		uint32 _numExpired;
+		uint32 _expiredSize;
+
 	public:
 		ResTypeData();
 		~ResTypeData();
@@ -175,6 +207,13 @@ protected:
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
+	ResExpirePolicy _expirePolicy;
+	uint32 _peakAllocatedSize;
+	uint32 _numExpireRuns;
+
+	/** Number of loaded resources per power-of-two size class. */
+	uint32 _sizeClassCount[kResSizeClasses];
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
@@ -224,10 +263,28 @@ public:
 
 	void resourceStats();
 
+	void setExpirePolicy(ResExpirePolicy policy) { _expirePolicy = policy; }
+	ResExpirePolicy getExpirePolicy() const { return _expirePolicy; }
+
+	uint32 getAllocatedSize() const { return _allocatedSize; }
+	uint32 getPeakAllocatedSize() const { return _peakAllocatedSize; }
+	uint32 getMinHeapThreshold() const { return _minHeapThreshold; }
+	uint32 getMaxHeapThreshold() const { return _maxHeapThreshold; }
+	uint32 getNumExpireRuns() const { return _numExpireRuns; }
+
+	/**
+	 * Returns the number of loaded resources whose size falls into the given
+	 * size class, i.e. is at least 2^(sizeClass - 1) and less than 2^sizeClass
+	 * bytes.
+	 */
+	uint32 getSizeClassCount(int sizeClass) const { return _sizeClassCount[sizeClass]; }
+
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	static int getSizeClass(uint32 size);
 };
 
 } // End of namespace Scumm
@@ -1647,6 +1647,10 @@ void ScummEngine_v71he::saveOrLoad(Serializer *s) {
 	};
 
 	s->saveLoadArrayOf(_wiz->_polygons, ARRAYSIZE(_wiz->_polygons), sizeof(_wiz->_polygons[0]), polygonEntries);
+
+	// The images were reloaded and may have been modified in the savegame
+	if (s->isLoading())
+		_wiz->purgeWizCache();
 }
 
 void ScummEngine_v90he::saveOrLoad(Serializer *s) {
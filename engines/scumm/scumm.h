@@ -745,6 +745,7 @@ protected:
 	int readSoundResource(ResId idx);
 	int readSoundResourceSmallHeader(ResId idx);
 	bool isResourceInUse(ResType type, ResId idx) const;
+	virtual void resourceNuked(ResType type, ResId idx);
 
 	virtual void setupRoomSubBlocks();
 	virtual void resetRoomSubBlocks();
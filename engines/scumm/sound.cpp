@@ -622,35 +622,47 @@ void Sound::startTalkSound(uint32 offset, uint32 b, int mode, Audio::SoundHandle
 
 	if (!_soundsPaused && _mixer->isReady()) {
 		Audio::AudioStream *input = NULL;
+		Audio::SeekableAudioStream *compressed = NULL;
 
-		switch (_soundMode) {
-		case kMP3Mode:
+		// Sound effects are played over and over, so their compressed
+		// samples are only decoded once. Speech isn't worth the memory.
+		const bool cacheSfx = (mode == 1 && _soundMode != kVOCMode);
+		if (cacheSfx)
+			input = _decodedSfx.getStream(_sfxFilename, offset, size);
+
+		if (!input) {
+			switch (_soundMode) {
+			case kMP3Mode:
 #ifdef USE_MAD
-			{
-			assert(size > 0);
-			input = Audio::makeMP3Stream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+				{
+				assert(size > 0);
+				compressed = Audio::makeMP3Stream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+				}
 #endif
-			break;
-		case kVorbisMode:
+				break;
+			case kVorbisMode:
 #ifdef USE_VORBIS
-			{
-			assert(size > 0);
-			input = Audio::makeVorbisStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+				{
+				assert(size > 0);
+				compressed = Audio::makeVorbisStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+				}
 #endif
-			break;
-		case kFLACMode:
+				break;
+			case kFLACMode:
 #ifdef USE_FLAC
-			{
-			assert(size > 0);
-			input = Audio::makeFLACStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+				{
+				assert(size > 0);
+				compressed = Audio::makeFLACStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+				}
 #endif
-			break;
-		default:
-			input = Audio::makeVOCStream(file.release(), Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
-			break;
+				break;
+			default:
+				input = Audio::makeVOCStream(file.release(), Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
+				break;
+			}
+
+			if (compressed)
+				input = cacheSfx ? _decodedSfx.addStream(_sfxFilename, offset, size, compressed) : compressed;
 		}
 
 		if (!input) {
@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "audio/audiostream.h"
+#include "audio/decoded_cache.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 #include "scumm/saveload.h"
@@ -74,6 +75,7 @@ protected:
 	SoundMode _soundMode;
 	MP3OffsetTable *_offsetTable;	// For compressed audio
 	int _numSoundEffects;		// For compressed audio
+	Audio::DecodedSoundCache _decodedSfx;	// For compressed audio
 
 	uint32 _talk_sound_a1, _talk_sound_a2, _talk_sound_b1, _talk_sound_b2;
 	byte _talk_sound_mode, _talk_sound_channel;
@@ -101,6 +101,13 @@ MoviePlayer::MoviePlayer(SwordEngine *vm, Text *textMan, ResMan *resMan, Audio::
 	_bgSoundStream = NULL;
 	_decoderType = decoderType;
 	_decoder = decoder;
+	_decodeAhead = 0;
+
+	// The PSX frames are slow to decode, so they're decoded ahead while
+	// waiting for the previous ones to end. This isn't done on the timer,
+	// which the music shares.
+	if (decoderType == kVideoDecoderPSX)
+		_decoder = _decodeAhead = new Video::DecodeAheadVideoDecoder(decoder, 4, Video::DecodeAheadVideoDecoder::kDecodeOnIdle);
 
 	_c1Color = _c2Color = _c3Color = _c4Color = 255;
 	_black = 0;
@@ -419,7 +426,10 @@ bool MoviePlayer::playVideo() {
 			if ((event.type == Common::EVENT_KEYDOWN && event.kbd.keycode == Common::KEYCODE_ESCAPE) || event.type == Common::EVENT_LBUTTONUP)
 				skipped = true;
 
-		_vm->_system->delayMillis(10);
+		if (_decodeAhead)
+			_decodeAhead->decodeAhead(10);
+		else
+			_vm->_system->delayMillis(10);
 	}
 
 	if (_decoderType == kVideoDecoderPSX) {
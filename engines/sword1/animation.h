@@ -23,6 +23,7 @@
 #ifndef SWORD1_ANIMATION_H
 #define SWORD1_ANIMATION_H
 
+#include "video/decode_ahead.h"
 #include "video/dxa_decoder.h"
 #include "video/video_decoder.h"
 
@@ -88,6 +89,7 @@ protected:
 	DecoderType _decoderType;
 
 	Video::VideoDecoder *_decoder;
+	Video::DecodeAheadVideoDecoder *_decodeAhead; ///< _decoder, if it decodes frames ahead.
 	Audio::SoundHandle *_bgSoundHandle;
 	Audio::AudioStream *_bgSoundStream;
 
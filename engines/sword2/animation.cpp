@@ -56,6 +56,13 @@ MoviePlayer::MoviePlayer(Sword2Engine *vm, Audio::Mixer *snd, OSystem *system, A
 	_bgSoundStream = NULL;
 	_decoderType = decoderType;
 	_decoder = decoder;
+	_decodeAhead = 0;
+
+	// The PSX frames are slow to decode, so they're decoded ahead while
+	// waiting for the previous ones to end. This isn't done on the timer,
+	// which the music shares.
+	if (decoderType == kVideoDecoderPSX)
+		_decoder = _decodeAhead = new Video::DecodeAheadVideoDecoder(decoder, 4, Video::DecodeAheadVideoDecoder::kDecodeOnIdle);
 
 	_white = 255;
 	_black = 0;
@@ -375,7 +382,10 @@ bool MoviePlayer::playVideo() {
 			if ((event.type == Common::EVENT_KEYDOWN && event.kbd.keycode == Common::KEYCODE_ESCAPE) || event.type == Common::EVENT_LBUTTONUP)
 				return false;
 
-		_vm->_system->delayMillis(10);
+		if (_decodeAhead)
+			_decodeAhead->decodeAhead(10);
+		else
+			_vm->_system->delayMillis(10);
 	}
 
 	return !_vm->shouldQuit();
@@ -25,6 +25,7 @@
 #ifndef SWORD2_ANIMATION_H
 #define SWORD2_ANIMATION_H
 
+#include "video/decode_ahead.h"
 #include "video/dxa_decoder.h"
 #include "video/video_decoder.h"
 #include "audio/mixer.h"
@@ -87,6 +88,7 @@ protected:
 	DecoderType _decoderType;
 
 	Video::VideoDecoder *_decoder;
+	Video::DecodeAheadVideoDecoder *_decodeAhead; ///< _decoder, if it decodes frames ahead.
 	Audio::SoundHandle *_bgSoundHandle;
 	Audio::AudioStream *_bgSoundStream;
 
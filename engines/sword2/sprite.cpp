@@ -24,6 +24,8 @@
 
 #include "common/endian.h"
 
+#include "graphics/conversion.h"
+
 #include "sword2/sword2.h"
 #include "sword2/defs.h"
 #include "sword2/screen.h"
@@ -396,7 +398,6 @@ int32 Screen::createSurface(SpriteInfo *s, byte **sprite) {
 
 void Screen::drawSurface(SpriteInfo *s, byte *surface, Common::Rect *clipRect) {
 	Common::Rect rd, rs;
-	uint16 x, y;
 	byte *src, *dst;
 
 	rs.left = 0;
@@ -440,15 +441,7 @@ void Screen::drawSurface(SpriteInfo *s, byte *surface, Common::Rect *clipRect) {
 	dst = _buffer + _screenWide * rd.top + rd.left;
 
 	// Surfaces are always transparent.
-
-	for (y = 0; y < rd.height(); y++) {
-		for (x = 0; x < rd.width(); x++) {
-			if (src[x])
-				dst[x] = src[x];
-		}
-		src += s->w;
-		dst += _screenWide;
-	}
+	Graphics::keyBlit(dst, src, _screenWide, s->w, rd.width(), rd.height(), 1, 0);
 
 	updateRect(&rd);
 }
@@ -817,14 +810,7 @@ int32 Screen::drawSprite(SpriteInfo *s) {
 		}
 	} else {
 		if (s->type & RDSPR_TRANS) {
-			for (i = 0; i < rs.height(); i++) {
-				for (j = 0; j < rs.width(); j++) {
-					if (src[j])
-						dst[j] = src[j];
-				}
-				src += srcPitch;
-				dst += _screenWide;
-			}
+			Graphics::keyBlit(dst, src, _screenWide, srcPitch, rs.width(), rs.height(), 1, 0);
 		} else {
 			for (i = 0; i < rs.height(); i++) {
 				memcpy(dst, src, rs.width());
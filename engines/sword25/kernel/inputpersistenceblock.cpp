@@ -36,14 +36,14 @@
 namespace Sword25 {
 
 InputPersistenceBlock::InputPersistenceBlock(const void *data, uint dataLength, int version) :
-	_data(static_cast<const byte *>(data), dataLength),
+	_dataEnd(static_cast<const byte *>(data) + dataLength),
+	_iter(static_cast<const byte *>(data)),
 	_errorState(NONE),
 	_version(version) {
-	_iter = _data.begin();
 }
 
 InputPersistenceBlock::~InputPersistenceBlock() {
-	if (_iter != _data.end())
+	if (_iter != _dataEnd)
 		warning("Persistence block was not read to the end.");
 }
 
@@ -118,8 +118,24 @@ void InputPersistenceBlock::readByteArray(Common::Array<byte> &value) {
 	}
 }
 
+void InputPersistenceBlock::readByteArray(const byte *&data, uint &size) {
+	data = 0;
+	size = 0;
+
+	if (checkMarker(BLOCK_MARKER)) {
+		uint blockSize;
+		read(blockSize);
+
+		if (checkBlockSize(blockSize)) {
+			data = _iter;
+			size = blockSize;
+			_iter += blockSize;
+		}
+	}
+}
+
 bool InputPersistenceBlock::checkBlockSize(int size) {
-	if (_data.end() - _iter >= size) {
+	if (_dataEnd - _iter >= size) {
 		return true;
 	} else {
 		_errorState = END_OF_DATA;
@@ -46,6 +46,10 @@ public:
 		OUT_OF_SYNC
 	};
 
+	/**
+	 * Creates a reader over the given data. The data is not copied, so it
+	 * must stay valid for the lifetime of the block.
+	 */
 	InputPersistenceBlock(const void *data, uint dataLength, int version);
 	virtual ~InputPersistenceBlock();
 
@@ -57,6 +61,12 @@ public:
 	void readString(Common::String &value);
 	void readByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Reads a byte array without copying it. On return, data points into the
+	 * block's buffer and stays valid as long as that buffer does.
+	 */
+	void readByteArray(const byte *&data, uint &size);
+
 	bool isGood() const {
 		return _errorState == NONE;
 	}
@@ -70,8 +80,8 @@ private:
 	bool checkMarker(byte marker);
 	bool checkBlockSize(int size);
 
-	Common::Array<byte> _data;
-	Common::Array<byte>::const_iterator _iter;
+	const byte *_dataEnd;
+	const byte *_iter;
 	ErrorState _errorState;
 
 	int _version;
@@ -33,6 +33,17 @@
 
 namespace {
 const uint INITIAL_BUFFER_SIZE = 1024 * 64;
+
+uint roundUpToPowerOfTwo(uint size) {
+	uint capacity = INITIAL_BUFFER_SIZE;
+	while (capacity < size) {
+		// Doubling past 2^31 wraps around to 0, so allocate what is needed
+		if (capacity > (uint)-1 / 2)
+			return size;
+		capacity <<= 1;
+	}
+	return capacity;
+}
 }
 
 namespace Sword25 {
@@ -85,6 +96,23 @@ void OutputPersistenceBlock::writeByteArray(Common::Array<byte> &value) {
 	rawWrite(&value[0], value.size());
 }
 
+uint OutputPersistenceBlock::beginByteArray() {
+	writeMarker(BLOCK_MARKER);
+
+	// Reserve room for the size, it is filled in by endByteArray()
+	write((uint)0);
+	return _data.size() - sizeof(uint32);
+}
+
+void OutputPersistenceBlock::appendByteArray(const void *dataPtr, size_t size) {
+	rawWrite(dataPtr, size);
+}
+
+void OutputPersistenceBlock::endByteArray(uint handle) {
+	assert(handle + sizeof(uint32) <= _data.size());
+	WRITE_LE_UINT32(&_data[handle], _data.size() - handle - sizeof(uint32));
+}
+
 void OutputPersistenceBlock::writeMarker(byte marker) {
 	_data.push_back(marker);
 }
@@ -92,6 +120,9 @@ void OutputPersistenceBlock::writeMarker(byte marker) {
 void OutputPersistenceBlock::rawWrite(const void *dataPtr, size_t size) {
 	if (size > 0) {
 		uint oldSize = _data.size();
+		// Common::Array::resize() only allocates exactly what is asked for,
+		// so grow geometrically to avoid reallocating on every write.
+		_data.reserve(roundUpToPowerOfTwo(oldSize + size));
 		_data.resize(oldSize + size);
 		memcpy(&_data[oldSize], dataPtr, size);
 	}
@@ -48,6 +48,16 @@ public:
 	void writeString(const Common::String &string);
 	void writeByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Starts a byte array whose contents are supplied piecewise through
+	 * appendByteArray(), so that large blobs (e.g. the persisted Lua state)
+	 * can be written without first being collected in a separate buffer.
+	 * The returned handle must be passed to endByteArray().
+	 */
+	uint beginByteArray();
+	void appendByteArray(const void *dataPtr, size_t size);
+	void endByteArray(uint handle);
+
 	const void *getData() const {
 		return &_data[0];
 	}
@@ -31,7 +31,9 @@
 
 #include "common/fs.h"
 #include "common/savefile.h"
+#include "common/substream.h"
 #include "common/zlib.h"
+#include "sword25/sword25.h"	// for kDebugPersistence
 #include "sword25/kernel/kernel.h"
 #include "sword25/kernel/persistenceservice.h"
 #include "sword25/kernel/inputpersistenceblock.h"
@@ -294,6 +296,7 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	}
 
 	// Alle notwendigen Module persistieren.
+	uint32 persistStartTime = g_system->getMillis();
 	OutputPersistenceBlock writer;
 	bool success = true;
 	success &= Kernel::getInstance()->getScript()->persist(writer);
@@ -304,6 +307,7 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	if (!success) {
 		error("Unable to persist modules for savegame file \"%s\".", filename.c_str());
 	}
+	uint32 writeStartTime = g_system->getMillis();
 
 	// Write the save game data uncompressed, since the final saved game will be
 	// compressed anyway.
@@ -315,6 +319,7 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	file->writeString(sBuffer);
 	file->writeByte(0);
 	file->write(writer.getData(), writer.getDataSize());
+	uint32 writeEndTime = g_system->getMillis();
 
 	// Get the screenshot
 	Common::SeekableReadStream *thumbnail = Kernel::getInstance()->getGfx()->getThumbnail();
@@ -335,6 +340,9 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	file->finalize();
 	delete file;
 
+	debugC(kDebugPersistence, "Saved %u bytes of game data to \"%s\": persisting took %u ms, writing took %u ms",
+	       writer.getDataSize(), filename.c_str(), writeStartTime - persistStartTime, writeEndTime - writeStartTime);
+
 	// Savegameinformationen fr diesen Slot aktualisieren.
 	_impl->readSlotSavegameInformation(slotID);
 
@@ -373,39 +381,36 @@ bool PersistenceService::loadGame(uint slotID) {
 	}
 #endif
 
-	byte *compressedDataBuffer = new byte[curSavegameInfo.gamedataLength];
-	byte *uncompressedDataBuffer = new byte[curSavegameInfo.gamedataUncompressedLength];
+	uint32 readStartTime = g_system->getMillis();
 	Common::String filename = generateSavegameFilename(slotID);
 	file = sfm->openForLoading(filename);
 
-	file->seek(curSavegameInfo.gamedataOffset);
-	file->read(reinterpret_cast<char *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength);
-	if (file->err()) {
-		error("Unable to load the gamedata from the savegame file \"%s\".", filename.c_str());
-		delete[] compressedDataBuffer;
-		delete[] uncompressedDataBuffer;
-		return false;
+	// The game data is read through a sub stream, so that it can be
+	// decompressed on the fly without holding the compressed data in memory.
+	Common::SeekableReadStream *gamedataStream = new Common::SeekableSubReadStream(file,
+			curSavegameInfo.gamedataOffset, curSavegameInfo.gamedataOffset + curSavegameInfo.gamedataLength);
+
+	if (curSavegameInfo.gamedataUncompressedLength > curSavegameInfo.gamedataLength) {
+		// Older saved game, where the game data was compressed again.
+		gamedataStream = Common::wrapCompressedReadStream(gamedataStream);
 	}
+	// Otherwise this is a newer saved game with uncompressed game data,
+	// which is read as-is.
 
-	// Uncompress game data, if needed.
-	unsigned long uncompressedBufferSize = curSavegameInfo.gamedataUncompressedLength;
+	byte *gamedataBuffer = new byte[curSavegameInfo.gamedataUncompressedLength];
+	uint32 bytesRead = gamedataStream->read(gamedataBuffer, curSavegameInfo.gamedataUncompressedLength);
+	bool readError = gamedataStream->err() || bytesRead != curSavegameInfo.gamedataUncompressedLength;
+	delete gamedataStream;
 
-	if (uncompressedBufferSize > curSavegameInfo.gamedataLength) {
-		// Older saved game, where the game data was compressed again.
-		if (!Common::uncompress(reinterpret_cast<byte *>(&uncompressedDataBuffer[0]), &uncompressedBufferSize,
-					   reinterpret_cast<byte *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength)) {
-			error("Unable to decompress the gamedata from savegame file \"%s\".", filename.c_str());
-			delete[] uncompressedDataBuffer;
-			delete[] compressedDataBuffer;
-			delete file;
-			return false;
-		}
-	} else {
-		// Newer saved game with uncompressed game data, copy it as-is.
-		memcpy(uncompressedDataBuffer, compressedDataBuffer, uncompressedBufferSize);
+	if (readError) {
+		error("Unable to load the gamedata from the savegame file \"%s\".", filename.c_str());
+		delete[] gamedataBuffer;
+		delete file;
+		return false;
 	}
 
-	InputPersistenceBlock reader(&uncompressedDataBuffer[0], curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.version);
+	uint32 unpersistStartTime = g_system->getMillis();
+	InputPersistenceBlock reader(gamedataBuffer, curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.version);
 
 	// Einzelne Engine-Module depersistieren.
 	bool success = true;
@@ -416,8 +421,7 @@ bool PersistenceService::loadGame(uint slotID) {
 	success &= Kernel::getInstance()->getSfx()->unpersist(reader);
 	success &= Kernel::getInstance()->getInput()->unpersist(reader);
 
-	delete[] compressedDataBuffer;
-	delete[] uncompressedDataBuffer;
+	delete[] gamedataBuffer;
 	delete file;
 
 	if (!success) {
@@ -425,6 +429,9 @@ bool PersistenceService::loadGame(uint slotID) {
 		return false;
 	}
 
+	debugC(kDebugPersistence, "Loaded %u bytes of game data from \"%s\": reading took %u ms, unpersisting took %u ms",
+	       curSavegameInfo.gamedataUncompressedLength, filename.c_str(), unpersistStartTime - readStartTime, g_system->getMillis() - unpersistStartTime);
+
 	return true;
 }
 
@@ -387,11 +387,8 @@ bool pushPermanentsTable(lua_State *L, PERMANENT_TABLE_TYPE tableType) {
 
 namespace {
 int chunkwriter(lua_State *L, const void *p, size_t sz, void *ud) {
-	Common::Array<byte> & chunkData = *reinterpret_cast<Common::Array<byte> * >(ud);
-	const byte *buffer = reinterpret_cast<const byte *>(p);
-
-	while (sz--)
-		chunkData.push_back(*buffer++);
+	OutputPersistenceBlock &writer = *reinterpret_cast<OutputPersistenceBlock *>(ud);
+	writer.appendByteArray(p, sz);
 
 	return 1;
 }
@@ -409,12 +406,11 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	pushPermanentsTable(_state, PTT_PERSIST);
 	lua_getglobal(_state, "_G");
 
-	// Lua persists and stores the data in a Common::Array
-	Common::Array<byte> chunkData;
-	pluto_persist(_state, chunkwriter, &chunkData);
-
-	// Persistenzdaten in den Writer schreiben.
-	writer.writeByteArray(chunkData);
+	// Lua persists and streams the data straight into the writer, without
+	// collecting it in an intermediate buffer first
+	uint chunkHandle = writer.beginByteArray();
+	pluto_persist(_state, chunkwriter, &writer);
+	writer.endByteArray(chunkHandle);
 
 	// Die beiden Tabellen vom Stack nehmen.
 	lua_pop(_state, 2);
@@ -425,7 +421,7 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 namespace {
 
 struct ChunkreaderData {
-	void   *BufferPtr;
+	const void *BufferPtr;
 	size_t  Size;
 	bool    BufferReturned;
 };
@@ -509,14 +505,15 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	};
 	clearGlobalTable(_state, clearExceptionsSecondPass);
 
-	// Persisted Lua data
-	Common::Array<byte> chunkData;
-	reader.readByteArray(chunkData);
+	// Persisted Lua data. It is read in place from the reader's buffer.
+	const byte *chunkData;
+	uint chunkSize;
+	reader.readByteArray(chunkData, chunkSize);
 
 	// Chunk-Reader initialisation. It is used with pluto_unpersist to restore read data
 	ChunkreaderData cd;
-	cd.BufferPtr = &chunkData[0];
-	cd.Size = chunkData.size();
+	cd.BufferPtr = chunkData;
+	cd.Size = chunkSize;
 	cd.BufferReturned = false;
 
 	pluto_unpersist(_state, chunkreader, &cd);
@@ -55,7 +55,8 @@ enum {
 enum {
 	kDebugScript = 1 << 0,
 	kDebugSound = 1 << 1,
-	kDebugResource = 1 << 2
+	kDebugResource = 1 << 2,
+	kDebugPersistence = 1 << 3
 };
 
 enum GameFlags {
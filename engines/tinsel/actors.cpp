@@ -369,7 +369,7 @@ void ActorEvent(CORO_PARAM, int ano, TINSEL_EVENT tEvent, bool bWait, int myEsca
 	ATP_INIT atp;
 	int	index;
 	CORO_BEGIN_CONTEXT;
-		PPROCESS pProc;
+		Common::PPROCESS pProc;
 	CORO_END_CONTEXT(_ctx);
 
 	CORO_BEGIN_CODE(_ctx);
@@ -474,8 +474,8 @@ void StartTaggedActors(SCNHANDLE ah, int numActors, bool bRunScript) {
 			// Run actor's script for this scene
 			if (bRunScript) {
 				// Send in reverse order - they get swapped round in the scheduler
-				ActorEvent(nullContext, taggedActors[i].id, SHOWEVENT, false, 0);
-				ActorEvent(nullContext, taggedActors[i].id, STARTUP, false, 0);
+				ActorEvent(Common::nullContext, taggedActors[i].id, SHOWEVENT, false, 0);
+				ActorEvent(Common::nullContext, taggedActors[i].id, STARTUP, false, 0);
 			}
 		}
 	}
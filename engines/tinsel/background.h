@@ -26,7 +26,7 @@
 
 #include "common/frac.h"
 #include "common/rect.h"
-#include "tinsel/coroutine.h"
+#include "common/coroutines.h"
 #include "tinsel/dw.h"	// for SCNHANDLE
 #include "tinsel/palette.h"	// palette definitions
 
@@ -265,7 +265,7 @@ void StartupBackground(CORO_PARAM, SCNHANDLE hFilm) {
 	if (g_pBG[0] == NULL)
 		ControlStartOff();
 
-	if (TinselV2 && (coroParam != nullContext))
+	if (TinselV2 && (coroParam != Common::nullContext))
 		CORO_GIVE_WAY;
 
 	CORO_END_CODE;
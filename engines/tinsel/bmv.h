@@ -29,7 +29,7 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h"
 
-#include "tinsel/coroutine.h"
+#include "common/coroutines.h"
 #include "tinsel/object.h"
 #include "tinsel/palette.h"
 
@@ -24,6 +24,7 @@
 #include "tinsel/debugger.h"
 #include "tinsel/dialogs.h"
 #include "tinsel/pcode.h"
+#include "tinsel/sched.h"
 #include "tinsel/scene.h"
 #include "tinsel/sound.h"
 #include "tinsel/music.h"
@@ -67,6 +68,7 @@ Console::Console() : GUI::Debugger() {
 	DCmd_Register("music",		WRAP_METHOD(Console, cmd_music));
 	DCmd_Register("sound",		WRAP_METHOD(Console, cmd_sound));
 	DCmd_Register("string",		WRAP_METHOD(Console, cmd_string));
+	DCmd_Register("procs",		WRAP_METHOD(Console, cmd_procs));
 }
 
 Console::~Console() {
@@ -161,4 +163,30 @@ bool Console::cmd_string(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmd_procs(int argc, const char **argv) {
+	if (argc > 2) {
+		DebugPrintf("%s [on|off]\n", argv[0]);
+		DebugPrintf("Lists the active processes with their run counts and run times.\n");
+		DebugPrintf("'on' and 'off' enable or disable measuring the run times.\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		g_scheduler->setTimingEnabled(!scumm_stricmp(argv[1], "on"));
+		DebugPrintf("Process timing is %s\n", g_scheduler->isTimingEnabled() ? "on" : "off");
+		return true;
+	}
+
+	DebugPrintf("%d processes in use, at most %d at once\n",
+		g_scheduler->getNumProcesses(), g_scheduler->getMaxProcesses());
+	for (const Common::PROCESS *pProc = g_scheduler->getFirstActiveProcess(); pProc; pProc = pProc->pNext) {
+		DebugPrintf("pid %8x: %6u runs", pProc->pid, pProc->runCount);
+		if (g_scheduler->isTimingEnabled())
+			DebugPrintf(", %8u us", pProc->runTime);
+		DebugPrintf("\n");
+	}
+
+	return true;
+}
+
 } // End of namespace Tinsel
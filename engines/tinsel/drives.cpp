@@ -54,7 +54,7 @@ void CdCD(CORO_PARAM) {
 			//        context without converting the whole calling stack to CORO'd
 			//        functions. If these functions really get called while a CD
 			//        change is requested, this needs to be resolved.
-			if (coroParam == nullContext)
+			if (coroParam == Common::nullContext)
 				error("CdCD needs context");
 			CORO_SLEEP(1);
 		} else
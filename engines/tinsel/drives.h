@@ -26,7 +26,7 @@
 
 #include "common/stream.h"
 #include "tinsel/dw.h"
-#include "tinsel/coroutine.h"
+#include "common/coroutines.h"
 
 namespace Tinsel {
 
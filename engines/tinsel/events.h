@@ -25,7 +25,7 @@
 #define TINSEL_EVENTS_H
 
 #include "tinsel/dw.h"
-#include "tinsel/coroutine.h"
+#include "common/coroutines.h"
 #include "common/rect.h"
 
 namespace Tinsel {
@@ -9,7 +9,6 @@ MODULE_OBJS := \
 	bmv.o \
 	cliprect.o \
 	config.o \
-	coroutine.o \
 	cursor.o \
 	debugger.o \
 	detection.o \
@@ -301,7 +301,7 @@ static void FreeInterpretContextPi(INT_CONTEXT *pic) {
  * Ensures that interpret contexts don't get lost when an Interpret()
  * call doesn't complete.
  */
-void FreeInterpretContextPr(PROCESS *pProc) {
+void FreeInterpretContextPr(Common::PROCESS *pProc) {
 	INT_CONTEXT *pic;
 	int	i;
 
@@ -433,7 +433,7 @@ void RegisterGlobals(int num) {
 
 	if (TinselV2) {
 		// read initial values
-		CdCD(nullContext);
+		CdCD(Common::nullContext);
 
 		Common::File f;
 		if (!f.open(GLOBALS_FILENAME))
@@ -839,7 +839,7 @@ void Interpret(CORO_PARAM, INT_CONTEXT *ic) {
  * Associates an interpret context with the
  * process that will run it.
  */
-void AttachInterpret(INT_CONTEXT *pic, PROCESS *pProc) {
+void AttachInterpret(INT_CONTEXT *pic, Common::PROCESS *pProc) {
 	// Attach the process which is using this context
 	pic->pProc = pProc;
 }
@@ -869,9 +869,9 @@ static uint32 UniqueWaitNumber() {
 /**
  * WaitInterpret
  */
-void WaitInterpret(CORO_PARAM, PPROCESS pWaitProc, bool *result) {
+void WaitInterpret(CORO_PARAM, Common::PPROCESS pWaitProc, bool *result) {
 	int i;
-	PPROCESS currentProcess = g_scheduler->getCurrentProcess();
+	Common::PPROCESS currentProcess = g_scheduler->getCurrentProcess();
 	assert(currentProcess);
 	assert(currentProcess != pWaitProc);
 	if (result) *result = false;
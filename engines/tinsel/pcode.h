@@ -56,7 +56,7 @@ struct WorkaroundEntry;
 struct INT_CONTEXT {
 
 	// Elements for interpret context management
-	PROCESS *pProc;			///< processes owning this context
+	Common::PROCESS *pProc;		///< processes owning this context
 	GSORT	GSort;			///< sort of this context
 
 	// Previously parameters to Interpret()
@@ -114,9 +114,9 @@ void SaveInterpretContexts(INT_CONTEXT *sICInfo);
 void RegisterGlobals(int num);
 void FreeGlobals();
 
-void AttachInterpret(INT_CONTEXT *pic, PROCESS *pProc);
+void AttachInterpret(INT_CONTEXT *pic, Common::PROCESS *pProc);
 
-void WaitInterpret(CORO_PARAM, PPROCESS pWaitProc, bool *result);
+void WaitInterpret(CORO_PARAM, Common::PPROCESS pWaitProc, bool *result);
 
 #define NUM_INTERPRET	(NUM_PROCESS - 20)
 #define MAX_INTERPRET	(MAX_PROCESSES - 20)
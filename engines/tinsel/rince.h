@@ -24,6 +24,7 @@
 #ifndef TINSEL_RINCE_H	// prevent multiple includes
 #define TINSEL_RINCE_H
 
+#include "common/coroutines.h"	// for PROCESS
 #include "tinsel/anim.h"	// for ANIM
 #include "tinsel/scene.h"	// for TFTYPE
 #include "tinsel/tinsel.h"
@@ -31,7 +32,6 @@
 namespace Tinsel {
 
 struct OBJECT;
-struct PROCESS;
 
 enum NPS {NOT_IN, GOING_UP, GOING_DOWN, LEAVING, ENTERING};
 
@@ -110,7 +110,7 @@ struct MOVER {
 	/* NOTE: If effect polys can overlap, this needs improving */
 	bool		bInEffect;
 
-	PROCESS		*pProc;
+	Common::PROCESS		*pProc;
 
 	// Discworld 2 specific fields
 	int32		zOverride;
@@ -32,7 +32,7 @@
 #include "tinsel/background.h"
 #include "tinsel/bmv.h"
 #include "tinsel/config.h"
-#include "tinsel/coroutine.h"
+#include "common/coroutines.h"
 #include "tinsel/cursor.h"
 #include "tinsel/drives.h"
 #include "tinsel/dw.h"
@@ -2975,12 +2975,12 @@ static void StandTag(int actor, HPOLYGON hp) {
 				&& hFilm != TF_LEFT && hFilm != TF_RIGHT)
 			hFilm = 0;
 
-		Stand(nullContext, actor, pnodex, pnodey, hFilm);
+		Stand(Common::nullContext, actor, pnodex, pnodey, hFilm);
 
 	} else if (hFilm && (actor == LEAD_ACTOR || actor == GetLeadId()))
-		Stand(nullContext, actor, pnodex, pnodey, hFilm);
+		Stand(Common::nullContext, actor, pnodex, pnodey, hFilm);
 	else
-		Stand(nullContext, actor, pnodex, pnodey, 0);
+		Stand(Common::nullContext, actor, pnodex, pnodey, 0);
 }
 
 
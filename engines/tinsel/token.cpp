@@ -31,7 +31,7 @@ namespace Tinsel {
 //----------------- LOCAL GLOBAL DATA --------------------
 
 struct Token {
-	PROCESS		*proc;
+	Common::PROCESS		*proc;
 };
 
 static Token g_tokens[NUMTOKENS];	// FIXME: Avoid non-const global vars
@@ -40,7 +40,7 @@ static Token g_tokens[NUMTOKENS];	// FIXME: Avoid non-const global vars
 /**
  * Release all tokens held by this process, and kill the process.
  */
-static void TerminateProcess(PROCESS *tProc) {
+static void TerminateProcess(Common::PROCESS *tProc) {
 
 	// Release tokens held by the process
 	for (int i = 0; i < NUMTOKENS; i++) {
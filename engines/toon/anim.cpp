@@ -23,6 +23,8 @@
 #include "common/debug.h"
 #include "common/rect.h"
 
+#include "graphics/conversion.h"
+
 #include "toon/anim.h"
 #include "toon/toon.h"
 #include "toon/tools.h"
@@ -184,19 +186,10 @@ void Animation::drawFrame(Graphics::Surface &surface, int32 frame, int32 xx, int
 		return;
 
 	int32 destPitch = surface.pitch;
-	uint8 *srcRow = _frames[frame]._data + offsX + (_frames[frame]._x2 - _frames[frame]._x1) * offsY;
+	int32 srcPitch = _frames[frame]._x2 - _frames[frame]._x1;
+	uint8 *srcRow = _frames[frame]._data + offsX + srcPitch * offsY;
 	uint8 *curRow = (uint8 *)surface.pixels + (yy + _frames[frame]._y1 + _y1 + offsY) * destPitch + (xx + _x1 + _frames[frame]._x1 + offsX);
-	for (int32 y = 0; y < rectY; y++) {
-		uint8 *cur = curRow;
-		uint8 *c = srcRow + y * (_frames[frame]._x2 - _frames[frame]._x1);
-		for (int32 x = 0; x < rectX; x++) {
-			if (*c)
-				*cur = *c;
-			c++;
-			cur++;
-		}
-		curRow += destPitch;
-	}
+	Graphics::keyBlit(curRow, srcRow, destPitch, srcPitch, rectX, rectY, 1, 0);
 }
 
 void Animation::drawFrameWithMask(Graphics::Surface &surface, int32 frame, int32 xx, int32 yy, int32 zz, Picture *mask) {
@@ -228,8 +221,27 @@ void Animation::drawFrameWithMaskAndScale(Graphics::Surface &surface, int32 fram
 	uint8 *c = _frames[frame]._data;
 	uint8 *curRow = (uint8 *)surface.pixels;
 	uint8 *curRowMask = mask->getDataPtr();
+	bool shadow = (strstr(_name, "SHADOW") != 0);
+
+	if (scale == 1024) {
+		// Not scaled at all, which is the common case
+		Common::Rect rect(xx1, yy1, xx2, yy2);
+		rect.clip(Common::Rect(1280, 400));
+		if (rect.isEmpty())
+			return;
+
+		const uint8 *src = c + (rect.top - yy1) * w + (rect.left - xx1);
+		uint8 *dst = curRow + rect.top * destPitch + rect.left;
+		const uint8 *dstMask = curRowMask + rect.top * destPitchMask + rect.left;
+
+		if (shadow)
+			Graphics::shadowBlitMasked(dst, src, dstMask, destPitch, w, destPitchMask, rect.width(), rect.height(), zz, 0, _vm->getShadowLUT());
+		else
+			Graphics::keyBlitMasked(dst, src, dstMask, destPitch, w, destPitchMask, rect.width(), rect.height(), zz, 1, 0);
+		return;
+	}
 
-	if (strstr(_name, "SHADOW")) {
+	if (shadow) {
 		for (int y = yy1; y < yy2; y++) {
 			for (int x = xx1; x < xx2; x++) {
 				if (x < 0 || x >= 1280 || y < 0 || y >= 400)
@@ -71,6 +71,8 @@ void MidiPlayer::play(Common::ReadStream &stream, int size, bool loop) {
 		_parser = MidiParser::createParser_SMF();
 		_parser->setMidiDriver(this);
 		_parser->setTimerRate(_driver->getBaseTempo());
+		// Emulated drivers play the notes between their timer callbacks
+		_parser->property(MidiParser::mpDelayEvents, 1);
 
 		_parser->loadMusic(_midiData, size);
 		_parser->setTrack(0);
@@ -22,6 +22,9 @@
 #include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 
+#include "common/endian.h"
+#include "common/textconsole.h"
+
 namespace Graphics {
 
 // TODO: YUV to RGB conversion function
@@ -146,4 +149,137 @@ bool crossBlit(byte *dst, const byte *src, int dstpitch, int srcpitch,
 	return true;
 }
 
+// The 8 bit blits look at four pixels at once. A word of pixels XORed with
+// the key in all bytes has a zero byte for every transparent pixel.
+
+static inline uint32 repeatByte(byte value) {
+	return value * 0x01010101;
+}
+
+static inline bool hasZeroByte(uint32 value) {
+	return ((value - 0x01010101) & ~value & 0x80808080) != 0;
+}
+
+static void keyBlit8(byte *dst, const byte *src, int dstPitch, int srcPitch, int w, int h, byte key) {
+	const uint32 keyWord = repeatByte(key);
+
+	while (h-- > 0) {
+		int x = 0;
+
+		for (; x + 4 <= w; x += 4) {
+			const uint32 pixels = READ_UINT32(src + x);
+			const uint32 keyed = pixels ^ keyWord;
+
+			if (!hasZeroByte(keyed)) {
+				// No transparent pixel
+				WRITE_UINT32(dst + x, pixels);
+			} else if (keyed != 0) {
+				// Some, but not all pixels are transparent
+				for (int i = x; i < x + 4; i++) {
+					if (src[i] != key)
+						dst[i] = src[i];
+				}
+			}
+		}
+
+		for (; x < w; x++) {
+			if (src[x] != key)
+				dst[x] = src[x];
+		}
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+template<typename Pixel>
+static void keyBlitLogic(byte *dst, const byte *src, int dstPitch, int srcPitch, int w, int h, Pixel key) {
+	while (h-- > 0) {
+		Pixel *dstRow = (Pixel *)dst;
+		const Pixel *srcRow = (const Pixel *)src;
+
+		for (int x = 0; x < w; x++) {
+			if (srcRow[x] != key)
+				dstRow[x] = srcRow[x];
+		}
+
+		dst += dstPitch;
+		src += srcPitch;
+	}
+}
+
+template<typename Pixel>
+static void keyBlitMaskedLogic(byte *dst, const byte *src, const byte *mask, int dstPitch, int srcPitch, int maskPitch,
+		int w, int h, int depth, Pixel key) {
+	while (h-- > 0) {
+		Pixel *dstRow = (Pixel *)dst;
+		const Pixel *srcRow = (const Pixel *)src;
+
+		// The depth mask rarely follows the shape of the sprite, so the
+		// pixels are selected without a branch
+		for (int x = 0; x < w; x++) {
+			const Pixel select = (Pixel)0 - (Pixel)(srcRow[x] != key && mask[x] >= depth);
+			dstRow[x] = (srcRow[x] & select) | (dstRow[x] & ~select);
+		}
+
+		dst += dstPitch;
+		src += srcPitch;
+		mask += maskPitch;
+	}
+}
+
+void keyBlit(byte *dst, const byte *src, int dstPitch, int srcPitch,
+		int w, int h, uint bytesPerPixel, uint32 key) {
+	switch (bytesPerPixel) {
+	case 1:
+		keyBlit8(dst, src, dstPitch, srcPitch, w, h, (byte)key);
+		break;
+	case 2:
+		keyBlitLogic<uint16>(dst, src, dstPitch, srcPitch, w, h, (uint16)key);
+		break;
+	case 4:
+		keyBlitLogic<uint32>(dst, src, dstPitch, srcPitch, w, h, key);
+		break;
+	default:
+		error("keyBlit: Unsupported bytes per pixel %d", bytesPerPixel);
+	}
+}
+
+void keyBlitMasked(byte *dst, const byte *src, const byte *mask, int dstPitch, int srcPitch, int maskPitch,
+		int w, int h, int depth, uint bytesPerPixel, uint32 key) {
+	switch (bytesPerPixel) {
+	case 1:
+		keyBlitMaskedLogic<byte>(dst, src, mask, dstPitch, srcPitch, maskPitch, w, h, depth, (byte)key);
+		break;
+	case 2:
+		keyBlitMaskedLogic<uint16>(dst, src, mask, dstPitch, srcPitch, maskPitch, w, h, depth, (uint16)key);
+		break;
+	case 4:
+		keyBlitMaskedLogic<uint32>(dst, src, mask, dstPitch, srcPitch, maskPitch, w, h, depth, key);
+		break;
+	default:
+		error("keyBlitMasked: Unsupported bytes per pixel %d", bytesPerPixel);
+	}
+}
+
+void shadowBlit(byte *dst, const byte *src, int dstPitch, int srcPitch,
+		int w, int h, byte key, const byte *shadowMap) {
+	shadowBlitMasked(dst, src, 0, dstPitch, srcPitch, 0, w, h, 0, key, shadowMap);
+}
+
+void shadowBlitMasked(byte *dst, const byte *src, const byte *mask, int dstPitch, int srcPitch, int maskPitch,
+		int w, int h, int depth, byte key, const byte *shadowMap) {
+	while (h-- > 0) {
+		for (int x = 0; x < w; x++) {
+			if (src[x] != key && (!mask || mask[x] >= depth))
+				dst[x] = shadowMap[dst[x]];
+		}
+
+		dst += dstPitch;
+		src += srcPitch;
+		if (mask)
+			mask += maskPitch;
+	}
+}
+
 } // End of namespace Graphics
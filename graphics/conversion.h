@@ -69,6 +69,64 @@ inline static void RGB2YUV(byte r, byte g, byte b, byte &y, byte &u, byte &v) {
 bool crossBlit(byte *dst, const byte *src, int dstpitch, int srcpitch,
 						int w, int h, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
 
+/**
+ * @name Keyed blits
+ *
+ * Blit functions for sprites with a transparent color, the key. All of them
+ * take the following parameters:
+ *
+ * @param dst		the buffer which will receive the graphics data
+ * @param src		the buffer containing the sprite
+ * @param dstPitch	width in bytes of one full line of the dest buffer
+ * @param srcPitch	width in bytes of one full line of the source buffer
+ * @param w			the width of the area to blit, in pixels
+ * @param h			the height of the area to blit
+ * @param key		the color of the transparent pixels in the source
+ *
+ * The pixels are in native byte order, like the ones of Graphics::Surface.
+ * Clipping is left to the caller.
+ */
+//@{
+
+/**
+ * Copies all pixels of the source, which aren't transparent.
+ *
+ * @param bytesPerPixel	the bytes per pixel of source and dest, 1, 2 or 4
+ */
+void keyBlit(byte *dst, const byte *src, int dstPitch, int srcPitch,
+		int w, int h, uint bytesPerPixel, uint32 key);
+
+/**
+ * Copies the pixels of the source, which aren't transparent, where the
+ * depth mask is at least the given depth. This is what engines use to
+ * draw actors behind parts of the background.
+ *
+ * @param mask		the depth mask, one byte per pixel
+ * @param maskPitch	width in bytes of one full line of the mask
+ * @param depth		the depth of the sprite
+ * @param bytesPerPixel	the bytes per pixel of source and dest, 1, 2 or 4
+ */
+void keyBlitMasked(byte *dst, const byte *src, const byte *mask, int dstPitch, int srcPitch, int maskPitch,
+		int w, int h, int depth, uint bytesPerPixel, uint32 key);
+
+/**
+ * Darkens the 8 bit dest where the source isn't transparent, by mapping the
+ * dest through the given shadow table.
+ *
+ * @param shadowMap	the table with 256 entries
+ */
+void shadowBlit(byte *dst, const byte *src, int dstPitch, int srcPitch,
+		int w, int h, byte key, const byte *shadowMap);
+
+/**
+ * Like shadowBlit(), but only where the depth mask is at least the given
+ * depth. See keyBlitMasked().
+ */
+void shadowBlitMasked(byte *dst, const byte *src, const byte *mask, int dstPitch, int srcPitch, int maskPitch,
+		int w, int h, int depth, byte key, const byte *shadowMap);
+
+//@}
+
 } // End of namespace Graphics
 
 #endif // GRAPHICS_CONVERSION_H
@@ -28,6 +28,7 @@
 #include "common/endian.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
+#include "common/util.h"
 
 namespace Graphics {
 
@@ -45,7 +46,8 @@ static const uint8 _zigZagOrder[64] = {
 
 JPEGDecoder::JPEGDecoder() : ImageDecoder(),
 	_stream(NULL), _w(0), _h(0), _numComp(0), _components(NULL), _numScanComp(0),
-	_scanComp(NULL), _currentComp(NULL), _rgbSurface(0) {
+	_scanComp(NULL), _currentComp(NULL), _rgbSurface(0),
+	_outputPixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) {
 
 	// Initialize the quantization tables
 	for (int i = 0; i < JPEG_MAX_QUANT_TABLES; i++)
@@ -57,6 +59,7 @@ JPEGDecoder::JPEGDecoder() : ImageDecoder(),
 		_huff[i].values = NULL;
 		_huff[i].sizes = NULL;
 		_huff[i].codes = NULL;
+		memset(_huff[i].lookup, 0, sizeof(_huff[i].lookup));
 	}
 }
 
@@ -72,9 +75,9 @@ const Surface *JPEGDecoder::getSurface() const {
 	if (_rgbSurface)
 		return _rgbSurface;
 
-	// Create an RGBA8888 surface
+	// Create a surface in the output format (RGBA8888 by default)
 	_rgbSurface = new Graphics::Surface();
-	_rgbSurface->create(_w, _h, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	_rgbSurface->create(_w, _h, _outputPixelFormat);
 
 	// Get our component surfaces
 	const Graphics::Surface *yComponent = getComponent(1);
@@ -86,6 +89,22 @@ const Surface *JPEGDecoder::getSurface() const {
 	return _rgbSurface;
 }
 
+void JPEGDecoder::setOutputPixelFormat(const PixelFormat &format) {
+	assert(format.bytesPerPixel == 2 || format.bytesPerPixel == 4);
+
+	if (format == _outputPixelFormat)
+		return;
+
+	_outputPixelFormat = format;
+
+	// Convert again on the next getSurface() call
+	if (_rgbSurface) {
+		_rgbSurface->free();
+		delete _rgbSurface;
+		_rgbSurface = 0;
+	}
+}
+
 void JPEGDecoder::destroy() {
 	// Reset member variables
 	_stream = NULL;
@@ -120,6 +139,7 @@ void JPEGDecoder::destroy() {
 	if (_rgbSurface) {
 		_rgbSurface->free();
 		delete _rgbSurface;
+		_rgbSurface = 0;
 	}
 }
 
@@ -336,6 +356,23 @@ bool JPEGDecoder::readDHT() {
 			curCode++;
 			cur++;
 		}
+
+		// Fill the lookup table with all the short enough codes, once for
+		// each combination of the bits that follow them
+		memset(_huff[tableNum].lookup, 0, sizeof(_huff[tableNum].lookup));
+		for (cur = 0; cur < _huff[tableNum].count; cur++) {
+			uint8 codeSize = _huff[tableNum].sizes[cur];
+			uint16 code = _huff[tableNum].codes[cur];
+
+			// Skip codes that are too long, or invalid in a broken table
+			if (codeSize > JPEG_HUFF_LOOKUP_BITS || (code >> codeSize) != 0)
+				continue;
+
+			uint8 freeBits = JPEG_HUFF_LOOKUP_BITS - codeSize;
+			uint16 entry = (codeSize << 8) | _huff[tableNum].values[cur];
+			for (uint16 i = 0; i < (1 << freeBits); i++)
+				_huff[tableNum].lookup[(code << freeBits) | i] = entry;
+		}
 	}
 
 	return true;
@@ -418,7 +455,9 @@ bool JPEGDecoder::readSOS() {
 	}
 
 	// Entropy coded sequence starts, initialize Huffman decoder
+	_bitsData = 0;
 	_bitsNumber = 0;
+	_bitsBytes = 0;
 
 	// Read all the scan MCUs
 	uint16 xMCU = _w / (_maxFactorH * 8);
@@ -449,15 +488,18 @@ bool JPEGDecoder::readSOS() {
 
 				if (interval == 0) {
 					interval = _restartInterval;
-					_bitsNumber = 0;
+					resetBits();
 
 					for (byte i = 0; i < _numScanComp; i++)
-						_scanComp[i]->DCpredictor = 0;					
+						_scanComp[i]->DCpredictor = 0;
 				}
 			}
 		}
 	}
 
+	// Give back the entropy coded bytes that were read ahead
+	finishBits();
+
 	// Trim Component surfaces back to image height and width
 	// Note: Code using jpeg must use surface.pitch correctly...
 	for (uint16 c = 0; c < _numScanComp; c++) {
@@ -546,6 +588,15 @@ bool JPEGDecoder::readMCU(uint16 xMCU, uint16 yMCU) {
 
 // IDCT based on public domain code from http://halicery.com/jpeg/idct.html
 void JPEGDecoder::idct1D8x8(int32 src[8], int32 dest[64], int32 ps, int32 half) {
+	// Most rows and columns have no AC coefficients, which makes all the
+	// outputs equal to the scaled DC coefficient
+	if (!(src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7])) {
+		int32 dc = ((src[0] << 9) + half) >> ps;
+		for (int i = 0; i < 8; i++)
+			dest[i * 8] = dc;
+		return;
+	}
+
 	int p, n;
 
 	src[0] <<= 9;
@@ -615,15 +666,9 @@ bool JPEGDecoder::readDataUnit(uint16 x, uint16 y) {
 	idct2D8x8(block);
 
 	// Level shift to make the values unsigned
-	for (int i = 0; i < 64; i++) {
-		block[i] = block[i] + 128;
-
-		if (block[i] < 0)
-			block[i] = 0;
-
-		if (block[i] > 255)
-			block[i] = 255;
-	}
+	byte pixels[64];
+	for (int i = 0; i < 64; i++)
+		pixels[i] = CLIP<int32>(block[i] + 128, 0, 255);
 
 	// Paint the component surface
 	uint8 scalingV = _maxFactorV / _currentComp->factorV;
@@ -633,14 +678,22 @@ bool JPEGDecoder::readDataUnit(uint16 x, uint16 y) {
 	x <<= 3;
 	y <<= 3;
 
+	const uint16 pitch = _currentComp->surface.pitch;
+	byte *line = (byte *)_currentComp->surface.getBasePtr(x * scalingH, y * scalingV);
+
 	for (uint8 j = 0; j < 8; j++) {
-		for (uint16 sV = 0; sV < scalingV; sV++) {
-			// Get the beginning of the block line
-			byte *ptr = (byte *)_currentComp->surface.getBasePtr(x * scalingH, (y + j) * scalingV + sV);
+		const byte *src = pixels + j * 8;
 
+		for (uint16 sV = 0; sV < scalingV; sV++, line += pitch) {
+			if (scalingH == 1) {
+				memcpy(line, src, 8);
+				continue;
+			}
+
+			byte *ptr = line;
 			for (uint8 i = 0; i < 8; i++) {
 				for (uint16 sH = 0; sH < scalingH; sH++) {
-					*ptr = (byte)(block[j * 8 + i]);
+					*ptr = src[i];
 					ptr++;
 				}
 			}
@@ -692,13 +745,14 @@ void JPEGDecoder::readAC(int16 *out) {
 }
 
 int16 JPEGDecoder::readSignedBits(uint8 numBits) {
-	uint16 ret = 0;
 	if (numBits > 16)
 		error("requested %d bits", numBits); //XXX
 
+	if (numBits == 0)
+		return 0;
+
 	// MSB=0 for negatives, 1 for positives
-	for (int i = 0; i < numBits; i++)
-		ret = (ret << 1) + readBit();
+	uint16 ret = readBits(numBits);
 
 	// Extend sign bits (PAG109)
 	if (!(ret >> (numBits - 1))) {
@@ -708,8 +762,22 @@ int16 JPEGDecoder::readSignedBits(uint8 numBits) {
 	return ret;
 }
 
-// TODO: optimize?
 uint8 JPEGDecoder::readHuff(uint8 table) {
+	// Look the code up directly while there are enough bits buffered. This
+	// only falls back to the code search for long codes and near markers.
+	if (_bitsNumber < JPEG_HUFF_LOOKUP_BITS)
+		fillBits(false);
+
+	if (_bitsNumber >= JPEG_HUFF_LOOKUP_BITS) {
+		uint16 index = (_bitsData >> (_bitsNumber - JPEG_HUFF_LOOKUP_BITS)) & ((1 << JPEG_HUFF_LOOKUP_BITS) - 1);
+		uint16 entry = _huff[table].lookup[index];
+
+		if (entry) {
+			_bitsNumber -= entry >> 8;
+			return entry & 0xFF;
+		}
+	}
+
 	bool foundCode = false;
 	uint8 val = 0;
 
@@ -740,33 +808,79 @@ uint8 JPEGDecoder::readHuff(uint8 table) {
 }
 
 uint8 JPEGDecoder::readBit() {
-	// Read a whole byte if necessary
-	if (_bitsNumber == 0) {
-		_bitsData = _stream->readByte();
-		_bitsNumber = 8;
+	return readBits(1);
+}
+
+uint16 JPEGDecoder::readBits(uint8 numBits) {
+	if (_bitsNumber < numBits) {
+		fillBits(false);
+
+		// Read into markers only when their bits are really needed
+		while (_bitsNumber < numBits)
+			fillBits(true);
+	}
+
+	_bitsNumber -= numBits;
+
+	return (_bitsData >> _bitsNumber) & ((1 << numBits) - 1);
+}
+
+void JPEGDecoder::fillBits(bool force) {
+	// Add whole bytes until the buffer is full. When forced, add exactly
+	// one byte, even if that means reading into a marker. The stream
+	// position is only queried once, and followed from there.
+	uint32 nextPos = _stream->pos();
+	while (_bitsNumber <= 24) {
+		uint32 pos = nextPos++;
+		uint8 data = _stream->readByte();
 
 		// Detect markers
-		if (_bitsData == 0xFF) {
+		if (data == 0xFF) {
 			uint8 byte2 = _stream->readByte();
+			nextPos++;
 
 			// A stuffed 0 validates the previous byte
 			if (byte2 != 0) {
-				if (byte2 == 0xDC) {
+				if (byte2 >= 0xD0 && byte2 <= 0xD7) {
+					debug(7, "RST%d marker detected", byte2 & 7);
+					data = _stream->readByte();
+					nextPos++;
+				} else if (!force) {
+					// Stop in front of the marker, the scan may end here
+					_stream->seek(pos);
+					return;
+				} else if (byte2 == 0xDC) {
 					// DNL marker: Define Number of Lines
 					// TODO: terminate scan
 					warning("DNL marker detected: terminate scan");
-				} else if (byte2 >= 0xD0 && byte2 <= 0xD7) {
-					debug(7, "RST%d marker detected", byte2 & 7);
-					_bitsData = _stream->readByte();
 				} else {
 					warning("Error: marker 0x%02X read in entropy data", byte2);
 				}
 			}
 		}
+
+		_bitsData = (_bitsData << 8) | data;
+		_bitsNumber += 8;
+		_bitsBytePos[_bitsBytes++ & 3] = pos;
+
+		if (force)
+			return;
 	}
-	_bitsNumber--;
+}
+
+void JPEGDecoder::resetBits() {
+	// Drop the rest of the current byte, the next interval starts on a
+	// byte boundary
+	_bitsNumber &= ~7;
+}
 
-	return (_bitsData & (1 << _bitsNumber)) ? 1 : 0;
+void JPEGDecoder::finishBits() {
+	// Seek back to the first byte that was buffered but not used at all
+	uint8 unused = _bitsNumber / 8;
+	if (unused)
+		_stream->seek(_bitsBytePos[(_bitsBytes - unused) & 3]);
+
+	_bitsNumber = 0;
 }
 
 const Surface *JPEGDecoder::getComponent(uint c) const {
@@ -23,6 +23,7 @@
 #ifndef GRAPHICS_JPEG_H
 #define GRAPHICS_JPEG_H
 
+#include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "graphics/decoders/image_decoder.h"
 
@@ -32,10 +33,9 @@ class SeekableReadStream;
 
 namespace Graphics {
 
-struct PixelFormat;
-
 #define JPEG_MAX_QUANT_TABLES 4
 #define JPEG_MAX_HUFF_TABLES 2
+#define JPEG_HUFF_LOOKUP_BITS 9
 
 class JPEGDecoder : public ImageDecoder {
 public:
@@ -52,6 +52,13 @@ public:
 	uint16 getHeight() const { return _h; }
 	const Surface *getComponent(uint c) const;
 
+	/**
+	 * Set the pixel format getSurface() converts the image to. This saves
+	 * callers converting the default RGBA8888 surface a second time.
+	 * Only 2 and 4 bytes per pixel formats are supported.
+	 */
+	void setOutputPixelFormat(const PixelFormat &format);
+
 private:
 	Common::SeekableReadStream *_stream;
 	uint16 _w, _h;
@@ -61,6 +68,7 @@ private:
 	// a getSurface() call while still upholding the
 	// const requirement in other ImageDecoders
 	mutable Graphics::Surface *_rgbSurface;
+	PixelFormat _outputPixelFormat;
 
 	// Image components
 	uint8 _numComp;
@@ -100,6 +108,11 @@ private:
 		uint8 *values;
 		uint8 *sizes;
 		uint16 *codes;
+
+		// Length (high byte) and value (low byte) of the codes of up to
+		// JPEG_HUFF_LOOKUP_BITS bits, indexed by the next bits of the
+		// stream. An entry of 0 means the code is longer.
+		uint16 lookup[1 << JPEG_HUFF_LOOKUP_BITS];
 	} _huff[2 * JPEG_MAX_HUFF_TABLES];
 
 	// Marker read functions
@@ -120,9 +133,20 @@ private:
 	// Huffman decoding
 	uint8 readHuff(uint8 table);
 	uint8 readBit();
-	uint8 _bitsData;
+	uint16 readBits(uint8 numBits);
+
+	// Entropy coded data buffering
+	void fillBits(bool force);
+	void resetBits();
+	void finishBits();
+	uint32 _bitsData;
 	uint8 _bitsNumber;
 
+	// Stream positions of the last bytes added to _bitsData, so that the
+	// stream can be rewound past the bytes that were not used
+	uint32 _bitsBytePos[4];
+	uint8 _bitsBytes;
+
 	// Inverse Discrete Cosine Transformation
 	static void idct1D8x8(int32 src[8], int32 dest[64], int32 ps, int32 half);
 	static void idct2D8x8(int32 block[64]);
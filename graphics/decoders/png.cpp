@@ -120,6 +120,12 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	uint32 chunkLength = 0, chunkType = 0;
 	_stream = &stream;
 
+	// Reset the state of previous reads
+	_compressedBuffer = 0;
+	_compressedBufferSize = 0;
+	_transparentColorSpecified = false;
+	_paletteEntries = 0;
+
 	// First, check the PNG signature
 	if (_stream->readUint32BE() != MKTAG(0x89, 'P', 'N', 'G')) {
 		delete _stream;
@@ -140,24 +146,17 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		case kChunkIHDR:
 			readHeaderChunk();
 			break;
-		case kChunkIDAT:
-			if (_compressedBufferSize == 0) {
-				_compressedBufferSize += chunkLength;
-				_compressedBuffer = (byte *)malloc(_compressedBufferSize);
-				_stream->read(_compressedBuffer, chunkLength);
-			} else {
-				// Expand the buffer
-				uint32 prevSize = _compressedBufferSize;
-				_compressedBufferSize += chunkLength;
-				byte *tmp = new byte[prevSize];
-				memcpy(tmp, _compressedBuffer, prevSize);
-				free(_compressedBuffer);
-				_compressedBuffer = (byte *)malloc(_compressedBufferSize);
-				memcpy(_compressedBuffer, tmp, prevSize);
-				delete[] tmp;
-				_stream->read(_compressedBuffer + prevSize, chunkLength);
-			}
+		case kChunkIDAT: {
+			// Append the chunk to the compressed data
+			uint32 prevSize = _compressedBufferSize;
+			_compressedBufferSize += chunkLength;
+			byte *compressedBuffer = (byte *)realloc(_compressedBuffer, _compressedBufferSize);
+			if (!compressedBuffer)
+				error("Could not allocate %u bytes for the PNG image data", _compressedBufferSize);
+			_compressedBuffer = compressedBuffer;
+			_stream->read(_compressedBuffer + prevSize, chunkLength);
 			break;
+		}
 		case kChunkPLTE:	// only available in indexed PNGs
 			if (_header.colorType != kIndexed)
 				error("A palette chunk has been found in a non-indexed PNG file");
@@ -187,7 +186,8 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// We no longer need the file stream, thus close it here
 	_stream = 0;
 
-	// Unpack the compressed buffer
+	// Unpack the compressed buffer. The data is inflated while the scan lines
+	// are read from it, so the whole uncompressed image is never in memory.
 	Common::MemoryReadStream *compData = new Common::MemoryReadStream(_compressedBuffer, _compressedBufferSize, DisposeAfterUse::YES);
 	_imageData = Common::wrapCompressedReadStream(compData);
 
@@ -210,79 +210,58 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
  * Taken from lodePNG, with a slight patch:
  * http://www.atalasoft.com/cs/blogs/stevehawley/archive/2010/02/23/libpng-you-re-doing-it-wrong.aspx
  */
-byte PNGDecoder::paethPredictor(int16 a, int16 b, int16 c) {
-  int16 pa = ABS<int16>(b - c);
-  int16 pb = ABS<int16>(a - c);
-  int16 pc = ABS<int16>(a + b - c - c);
-
-  if (pa <= MIN<int16>(pb, pc))
-	  return (byte)a;
-  else if (pb <= pc)
-	  return (byte)b;
-  else
-	  return (byte)c;
+inline byte PNGDecoder::paethPredictor(int16 a, int16 b, int16 c) {
+	int16 pa = ABS<int16>(b - c);
+	int16 pb = ABS<int16>(a - c);
+	int16 pc = ABS<int16>(a + b - c - c);
+
+	// Written as selects, which compilers turn into conditional moves
+	byte bc = (pb <= pc) ? (byte)b : (byte)c;
+	return (pa <= pb && pa <= pc) ? (byte)a : bc;
 }
 
 /**
- * Unfilters a filtered PNG scan line.
+ * Unfilters a filtered PNG scan line in place.
  * PNG filters are defined in: http://www.w3.org/TR/PNG/#9Filters
  * Note that filters are always applied to bytes
  *
- * Taken from lodePNG
+ * The previous line must be all zeroes for the first line of the image,
+ * which is what the filters assume there, so the loops below need no
+ * special cases. Each loop only depends on bytes it has already written,
+ * so the compiler is free to vectorize the Up filter.
+ *
+ * Based on lodePNG
  */
-void PNGDecoder::unfilterScanLine(byte *dest, const byte *scanLine, const byte *prevLine, uint16 byteWidth, byte filterType, uint16 length) {
+void PNGDecoder::unfilterScanLine(byte *line, const byte *prevLine, uint16 byteWidth, byte filterType, uint16 length) {
 	uint16 i;
 
 	switch (filterType) {
 	case kFilterNone:		// no change
-		for (i = 0; i < length; i++)
-			dest[i] = scanLine[i];
 		break;
 	case kFilterSub:		// add the bytes to the left
-		for (i = 0; i < byteWidth; i++)
-			dest[i] = scanLine[i];
 		for (i = byteWidth; i < length; i++)
-			dest[i] = scanLine[i] + dest[i - byteWidth];
+			line[i] += line[i - byteWidth];
 		break;
 	case kFilterUp:			// add the bytes of the above scanline
-		if (prevLine) {
-			for (i = 0; i < length; i++)
-				dest[i] = scanLine[i] + prevLine[i];
-		} else {
-			for (i = 0; i < length; i++)
-				dest[i] = scanLine[i];
-		}
+		for (i = 0; i < length; i++)
+			line[i] += prevLine[i];
 		break;
 	case kFilterAverage:	// average value of the left and top left
-		if (prevLine) {
-			for (i = 0; i < byteWidth; i++)
-				dest[i] = scanLine[i] + prevLine[i] / 2;
-			for (i = byteWidth; i < length; i++)
-				dest[i] = scanLine[i] + ((dest[i - byteWidth] + prevLine[i]) / 2);
-		} else {
-			for (i = 0; i < byteWidth; i++)
-				dest[i] = scanLine[i];
-			for (i = byteWidth; i < length; i++)
-				dest[i] = scanLine[i] + dest[i - byteWidth] / 2;
-		}
+		for (i = 0; i < byteWidth; i++)
+			line[i] += prevLine[i] >> 1;
+		for (i = byteWidth; i < length; i++)
+			line[i] += (line[i - byteWidth] + prevLine[i]) >> 1;
 		break;
 	case kFilterPaeth:		// Paeth filter: http://www.w3.org/TR/PNG/#9Filter-type-4-Paeth
-		if (prevLine) {
-			for(i = 0; i < byteWidth; i++)
-				dest[i] = (scanLine[i] + prevLine[i]); // paethPredictor(0, prevLine[i], 0) is always prevLine[i]
-			for(i = byteWidth; i < length; i++)
-				dest[i] = (scanLine[i] + paethPredictor(dest[i - byteWidth], prevLine[i], prevLine[i - byteWidth]));
-		} else {
-			for(i = 0; i < byteWidth; i++)
-				dest[i] = scanLine[i];
-			for(i = byteWidth; i < length; i++)
-				dest[i] = (scanLine[i] + dest[i - byteWidth]); // paethPredictor(dest[i - byteWidth], 0, 0) is always dest[i - byteWidth]
-		}
+		// paethPredictor(0, prevLine[i], 0) is always prevLine[i]
+		for (i = 0; i < byteWidth; i++)
+			line[i] += prevLine[i];
+		for (i = byteWidth; i < length; i++)
+			line[i] += paethPredictor(line[i - byteWidth], prevLine[i], prevLine[i - byteWidth]);
 		break;
 	default:
 		error("Unknown line filter");
 	}
-
 }
 
 int PNGDecoder::getBytesPerPixel() const {
@@ -292,37 +271,46 @@ int PNGDecoder::getBytesPerPixel() const {
 void PNGDecoder::constructImage() {
 	assert (_header.bitDepth != 0);
 
-	int bytesPerPixel = getBytesPerPixel();
-	int pitch = bytesPerPixel * _header.width;
-	byte *unfilteredSurface = new byte[pitch * _header.height];
-	byte *dest = unfilteredSurface;
-	uint16 scanLineWidth = (_header.width * getNumColorChannels() * _header.bitDepth + 7) / 8;
-	byte *scanLine = new byte[scanLineWidth];
-	byte *prevLine = 0;
-
-	switch(_header.interlaceType) {
-	case kNonInterlaced:
-		for (uint16 y = 0; y < _header.height; y++) {
-			byte filterType = _imageData->readByte();
-			_imageData->read(scanLine, scanLineWidth);
-			unfilterScanLine(dest, scanLine, prevLine, bytesPerPixel, filterType, scanLineWidth);
-			prevLine = dest;
-			dest += pitch;
-		}
-		break;
-	case kInterlaced:
+	if (_header.interlaceType == kInterlaced) {
 		// Theoretically, this shouldn't be needed, as interlacing is only
 		// useful for web images. Interlaced PNG images require more complex
 		// handling, so unless having support for such images is needed, there
 		// is no reason to add support for them.
 		error("TODO: Support for interlaced PNG images");
-		break;
 	}
 
-	delete[] scanLine;
+	_outputSurface = new Graphics::Surface();
+	_outputSurface->create(_header.width, _header.height, findPixelFormat());
+
+	int bytesPerPixel = getBytesPerPixel();
 
-	constructOutput(unfilteredSurface);
-	delete[] unfilteredSurface;
+	if (_header.colorType == kTrueColor || _header.colorType == kTrueColorWithAlpha) {
+		if (bytesPerPixel != 3 && bytesPerPixel != 4)
+			error("Unsupported truecolor PNG format");
+	} else if (_header.colorType == kGrayScale || _header.colorType == kGrayScaleWithAlpha) {
+		if (bytesPerPixel != 1 && bytesPerPixel != 2)
+			error("Unsupported grayscale PNG format");
+	}
+
+	// Only the current and the previous scan lines are kept around. The
+	// previous line starts out zeroed, as the filters expect for the first
+	// line.
+	uint16 scanLineWidth = (_header.width * getNumColorChannels() * _header.bitDepth + 7) / 8;
+	byte *lines = new byte[scanLineWidth * 2];
+	memset(lines, 0, scanLineWidth * 2);
+
+	byte *scanLine = lines;
+	byte *prevLine = lines + scanLineWidth;
+
+	for (uint16 y = 0; y < _header.height; y++) {
+		byte filterType = _imageData->readByte();
+		_imageData->read(scanLine, scanLineWidth);
+		unfilterScanLine(scanLine, prevLine, bytesPerPixel, filterType, scanLineWidth);
+		constructOutputLine(scanLine, y);
+		SWAP(scanLine, prevLine);
+	}
+
+	delete[] lines;
 }
 
 Graphics::PixelFormat PNGDecoder::findPixelFormat() const {
@@ -347,91 +335,89 @@ Graphics::PixelFormat PNGDecoder::findPixelFormat() const {
 	return Graphics::PixelFormat();
 }
 
-void PNGDecoder::constructOutput(const byte *surface) {
-	_outputSurface = new Graphics::Surface();
-	_outputSurface->create(_header.width, _header.height, findPixelFormat());
-
-	const byte *src = surface;
+void PNGDecoder::constructOutputLine(const byte *src, uint16 y) {
+	const Graphics::PixelFormat &format = _outputSurface->format;
 	byte a = 0xFF;
-	int bytesPerPixel = getBytesPerPixel();
 
-	if (_header.colorType != kIndexed) {
-		if (_header.colorType == kTrueColor || 
-			_header.colorType == kTrueColorWithAlpha) {
-			if (bytesPerPixel != 3 && bytesPerPixel != 4)
-				error("Unsupported truecolor PNG format");
-		} else if (_header.colorType == kGrayScale ||
-				   _header.colorType == kGrayScaleWithAlpha) {
-			if (bytesPerPixel != 1 && bytesPerPixel != 2)
-				error("Unsupported grayscale PNG format");
-		}
+	if (_header.colorType == kGrayScale && _header.bitDepth < 8) {
+		uint32 *dst = (uint32 *)_outputSurface->getBasePtr(0, y);
+		const byte maxValue = (1 << _header.bitDepth) - 1;
+
+		// Unpack the samples, and scale them up to 8 bits
+		for (uint16 j = 0; j < _outputSurface->w; j++) {
+			uint32 bit = j * _header.bitDepth;
+			byte sample = (src[bit / 8] >> (8 - _header.bitDepth - bit % 8)) & maxValue;
+			byte gray = sample * 0xFF / maxValue;
 
-		for (uint16 i = 0; i < _outputSurface->h; i++) {
-			for (uint16 j = 0; j < _outputSurface->w; j++) {
-				uint32 result = 0;
-
-				switch (bytesPerPixel) {
-				case 1:	// Grayscale
-					if (_transparentColorSpecified)
-						a = (src[0] == _transparentColor[0]) ? 0 : 0xFF;
-					result = _outputSurface->format.ARGBToColor(a, src[0], src[0], src[0]);
-					break;
-				case 2: // Grayscale + alpha
-					result = _outputSurface->format.ARGBToColor(src[1], src[0], src[0], src[0]);
-					break;
-				case 3: // RGB
-					if (_transparentColorSpecified) {
-						bool isTransparentColor = (src[0] == _transparentColor[0] &&
-												   src[1] == _transparentColor[1] &&
-												   src[2] == _transparentColor[2]);
-						a = isTransparentColor ? 0 : 0xFF;
-					}
-
-					result = _outputSurface->format.ARGBToColor(a, src[0], src[1], src[2]);
-					break;
-				case 4: // RGBA
-					result = _outputSurface->format.ARGBToColor(src[3], src[0], src[1], src[2]);
-					break;
+			if (_transparentColorSpecified)
+				a = (sample == _transparentColor[0]) ? 0 : 0xFF;
+			*dst++ = format.ARGBToColor(a, gray, gray, gray);
+		}
+	} else if (_header.colorType != kIndexed) {
+		uint32 *dst = (uint32 *)_outputSurface->getBasePtr(0, y);
+
+		switch (getBytesPerPixel()) {
+		case 1:	// Grayscale
+			for (uint16 j = 0; j < _outputSurface->w; j++, src++) {
+				if (_transparentColorSpecified)
+					a = (src[0] == _transparentColor[0]) ? 0 : 0xFF;
+				*dst++ = format.ARGBToColor(a, src[0], src[0], src[0]);
+			}
+			break;
+		case 2: // Grayscale + alpha
+			for (uint16 j = 0; j < _outputSurface->w; j++, src += 2)
+				*dst++ = format.ARGBToColor(src[1], src[0], src[0], src[0]);
+			break;
+		case 3: // RGB
+			for (uint16 j = 0; j < _outputSurface->w; j++, src += 3) {
+				if (_transparentColorSpecified) {
+					bool isTransparentColor = (src[0] == _transparentColor[0] &&
+											   src[1] == _transparentColor[1] &&
+											   src[2] == _transparentColor[2]);
+					a = isTransparentColor ? 0 : 0xFF;
 				}
 
-				*((uint32 *)_outputSurface->getBasePtr(j, i)) = result;
-				src += bytesPerPixel;
+				*dst++ = format.ARGBToColor(a, src[0], src[1], src[2]);
 			}
+			break;
+		case 4: // RGBA
+			// The output format is RGBA8888, whose colors are the RGBA
+			// bytes of the image read as a big endian value
+			for (uint16 j = 0; j < _outputSurface->w; j++, src += 4)
+				*dst++ = READ_BE_UINT32(src);
+			break;
 		}
 	} else {
 		uint32 mask = (0xff >> (8 - _header.bitDepth)) << (8 - _header.bitDepth);
+		byte *dst = (byte *)_outputSurface->getBasePtr(0, y);
 
-		// Convert the indexed surface to the target pixel format
-		for (uint16 i = 0; i < _outputSurface->h; i++) {
-			int data = 0;
-			int bitCount = 8;
-			const byte *src1 = src;
+		// Convert the indexed line to the target pixel format
+		int data = 0;
+		int bitCount = 8;
 
-			for (uint16 j = 0; j < _outputSurface->w; j++) {
-				if (bitCount == 8) {
-					data = *src;
-					src++;
-				}
+		for (uint16 j = 0; j < _outputSurface->w; j++) {
+			if (bitCount == 8) {
+				data = *src;
+				src++;
+			}
 
-				byte index = (data & mask) >> (8 - _header.bitDepth);
-				data = (data << _header.bitDepth) & 0xff;
-				bitCount -= _header.bitDepth;
+			byte index = (data & mask) >> (8 - _header.bitDepth);
+			data = (data << _header.bitDepth) & 0xff;
+			bitCount -= _header.bitDepth;
 
-				if (bitCount == 0)
-					bitCount = 8;
+			if (bitCount == 0)
+				bitCount = 8;
 
-				if (_transparentColorSpecified) {
-					byte r = _palette[index * 3 + 0];
-					byte g = _palette[index * 3 + 1];
-					byte b = _palette[index * 3 + 2];
-					a = _paletteTransparency[index];
-					*((uint32 *)_outputSurface->getBasePtr(j, i)) = _outputSurface->format.ARGBToColor(a, r, g, b);
-				} else {
-					*((byte *)_outputSurface->getBasePtr(j, i)) = index;
-				}
+			if (_transparentColorSpecified) {
+				byte r = _palette[index * 3 + 0];
+				byte g = _palette[index * 3 + 1];
+				byte b = _palette[index * 3 + 2];
+				a = _paletteTransparency[index];
+				*((uint32 *)dst) = format.ARGBToColor(a, r, g, b);
+				dst += 4;
+			} else {
+				*dst++ = index;
 			}
-
-			src = src1 + _outputSurface->w;
 		}
 	}
 }
@@ -105,7 +105,7 @@ private:
 	void readTransparencyChunk(uint32 chunkLength);
 
 	void constructImage();
-	void unfilterScanLine(byte *dest, const byte *scanLine, const byte *prevLine, uint16 byteWidth, byte filterType, uint16 length);
+	void unfilterScanLine(byte *line, const byte *prevLine, uint16 byteWidth, byte filterType, uint16 length);
 	byte paethPredictor(int16 a, int16 b, int16 c);
 
 	// The original file stream
@@ -127,7 +127,7 @@ private:
 	Graphics::Surface *_outputSurface;
 	Graphics::PixelFormat findPixelFormat() const;
 	int getBytesPerPixel() const;
-	void constructOutput(const byte *surface);
+	void constructOutputLine(const byte *src, uint16 y);
 };
 
 } // End of namespace Graphics
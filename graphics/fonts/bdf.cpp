@@ -30,10 +30,13 @@
 namespace Graphics {
 
 BdfFont::BdfFont(const BdfFontData &data, DisposeAfterUse::Flag dispose)
-	: _data(data), _dispose(dispose) {
+	: _data(data), _dispose(dispose), _atlas(0), _atlasOffsets(0) {
 }
 
 BdfFont::~BdfFont() {
+	delete[] _atlas;
+	delete[] _atlasOffsets;
+
 	if (_dispose == DisposeAfterUse::YES) {
 		for (int i = 0; i < _data.numCharacters; ++i)
 			delete[] _data.bitmaps[i];
@@ -67,20 +70,20 @@ int BdfFont::getCharWidth(byte chr) const {
 
 template<typename PixelType>
 void drawCharIntern(byte *ptr, uint pitch, const byte *src, int h, int width, int minX, int maxX, const PixelType color) {
-	byte data = 0;
+	src += minX;
+	const int count = maxX - minX + 1;
+
 	while (h--) {
 		PixelType *dst = (PixelType *)ptr;
 
-		for (int x = 0; x < width; ++x) {
-			if (!(x % 8))
-				data = *src++;
-
-			if (x >= minX && x <= maxX && (data & 0x80))
-				dst[x] = color;
-
-			data <<= 1;
+		// The masks keep the background where the bits are clear, so that
+		// no pixel needs a branch. They are sign extended to the pixel size.
+		for (int x = 0; x < count; ++x) {
+			const PixelType mask = (PixelType)(int8)src[x];
+			dst[x] = (dst[x] & ~mask) | (color & mask);
 		}
 
+		src += width;
 		ptr += pitch;
 	}
 }
@@ -95,6 +98,37 @@ int BdfFont::mapToIndex(byte ch) const {
 	return _data.defaultCharacter - _data.firstCharacter;
 }
 
+void BdfFont::createAtlas() const {
+	// The offset of each character, and the total size at the end
+	_atlasOffsets = new int[_data.numCharacters + 1];
+
+	int offset = 0;
+	for (int i = 0; i < _data.numCharacters; ++i) {
+		_atlasOffsets[i] = offset;
+		if (_data.bitmaps[i])
+			offset += _data.boxes ? _data.boxes[i].width * _data.boxes[i].height : _data.defaultBox.width * _data.defaultBox.height;
+	}
+
+	_atlasOffsets[_data.numCharacters] = offset;
+	_atlas = new byte[offset];
+
+	for (int i = 0; i < _data.numCharacters; ++i) {
+		if (!_data.bitmaps[i])
+			continue;
+
+		const BdfBoundingBox &box = _data.boxes ? _data.boxes[i] : _data.defaultBox;
+		const int bytesPerRow = (box.width + 7) / 8;
+		const byte *src = _data.bitmaps[i];
+		byte *dst = _atlas + _atlasOffsets[i];
+
+		for (int y = 0; y < box.height; ++y) {
+			for (int x = 0; x < box.width; ++x)
+				*dst++ = (src[x >> 3] & (0x80 >> (x & 7))) ? 0xFF : 0;
+			src += bytesPerRow;
+		}
+	}
+}
+
 void BdfFont::drawChar(Surface *dst, byte chr, const int tx, const int ty, const uint32 color) const {
 	assert(dst != 0);
 
@@ -126,14 +160,16 @@ void BdfFont::drawChar(Surface *dst, byte chr, const int tx, const int ty, const
 	int y = ty + _data.ascent - yOffset - height;
 	int x = tx + xOffset;
 
-	const byte *src = _data.bitmaps[idx];
+	if (!_atlas)
+		createAtlas();
 
-	const int bytesPerRow = (width + 7) / 8;
-	const int originalWidth = width;
+	// The masks of each character are stored row after row, without padding
+	const int atlasWidth = width;
+	const byte *src = _atlas + _atlasOffsets[idx];
 
 	// Make sure we do not draw outside the surface
 	if (y < 0) {
-		src -= y * bytesPerRow;
+		src -= y * atlasWidth;
 		height += y;
 		y = 0;
 	}
@@ -162,9 +198,9 @@ void BdfFont::drawChar(Surface *dst, byte chr, const int tx, const int ty, const
 	byte *ptr = (byte *)dst->getBasePtr(x, y);
 
 	if (dst->format.bytesPerPixel == 1)
-		drawCharIntern<byte>(ptr, dst->pitch, src, height, originalWidth, xStart, xEnd, color);
+		drawCharIntern<byte>(ptr, dst->pitch, src, height, atlasWidth, xStart, xEnd, color);
 	else if (dst->format.bytesPerPixel == 2)
-		drawCharIntern<uint16>(ptr, dst->pitch, src, height, originalWidth, xStart, xEnd, color);
+		drawCharIntern<uint16>(ptr, dst->pitch, src, height, atlasWidth, xStart, xEnd, color);
 }
 
 namespace {
@@ -69,9 +69,16 @@ public:
 	static BdfFont *loadFromCache(Common::SeekableReadStream &stream);
 private:
 	int mapToIndex(byte ch) const;
+	void createAtlas() const;
 
 	const BdfFontData _data;
 	const DisposeAfterUse::Flag _dispose;
+
+	// The character bitmaps with each bit expanded to a byte mask, so that
+	// drawing needs no bit tests. It is created when the first character is
+	// drawn and is shared by all colors and pixel formats.
+	mutable byte *_atlas;
+	mutable int *_atlasOffsets;
 };
 
 #define DEFINE_FONT(n) \
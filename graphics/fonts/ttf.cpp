@@ -33,7 +33,7 @@
 
 #include "common/singleton.h"
 #include "common/stream.h"
-#include "common/hashmap.h"
+#include "common/textconsole.h"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -123,14 +123,18 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
+		Glyph() : xOffset(0), yOffset(0), advance(0) {}
+
 		Surface image;
 		int xOffset, yOffset;
 		int advance;
 	};
 
 	bool cacheGlyph(Glyph &glyph, FT_UInt &slot, uint chr);
-	typedef Common::HashMap<byte, Glyph> GlyphCache;
-	GlyphCache _glyphs;
+
+	// Indexed by character, as the glyphs are looked up for every character
+	// drawn or measured
+	Glyph _glyphs[256];
 
 	FT_UInt _glyphSlots[256];
 
@@ -140,7 +144,7 @@ private:
 
 TTFFont::TTFFont()
     : _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
-      _descent(0), _glyphs(), _glyphSlots(), _monochrome(false), _hasKerning(false) {
+      _descent(0), _glyphSlots(), _monochrome(false), _hasKerning(false) {
 }
 
 TTFFont::~TTFFont() {
@@ -150,11 +154,11 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	for (uint i = 0; i < 256; ++i)
+		_glyphs[i].image.free();
 }
 
 bool TTFFont::load(Common::SeekableReadStream &stream, int size, bool monochrome, const uint32 *mapping) {
@@ -231,7 +235,7 @@ bool TTFFont::load(Common::SeekableReadStream &stream, int size, bool monochrome
 		}
 	}
 
-	_initialized = (_glyphs.size() != 0);
+	_initialized = true;
 	return _initialized;
 }
 
@@ -244,11 +248,7 @@ int TTFFont::getMaxCharWidth() const {
 }
 
 int TTFFont::getCharWidth(byte chr) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return 0;
-	else
-		return glyphEntry->_value.advance;
+	return _glyphs[chr].advance;
 }
 
 int TTFFont::getKerningOffset(byte left, byte right) const {
@@ -305,11 +305,7 @@ void renderGlyph(uint8 *dstPos, const int dstPitch, const uint8 *srcPos, const i
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, byte chr, int x, int y, uint32 color) const {
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return;
-
-	const Glyph &glyph = glyphEntry->_value;
+	const Glyph &glyph = _glyphs[chr];
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -84,6 +84,8 @@
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/mutex.h"
 #include "common/singleton.h"
 
 #include "graphics/surface.h"
@@ -95,17 +97,19 @@ public:
 	YUVToRGBLookup(Graphics::PixelFormat format);
 	~YUVToRGBLookup();
 
-	int16 *_colorTab;
+	Graphics::PixelFormat _format;
+	uint32 *_colorTab;
 	uint32 *_rgbToPix;
 };
 
-YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format) {
-	_colorTab = new int16[4 * 256]; // 2048 bytes
+YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format) : _format(format) {
+	// Each entry holds two offsets into _rgbToPix, one per 16-bit half, so
+	// that the green offsets of both chroma samples are added at once. The
+	// sums of the low halves stay below 65536 and do not carry over.
+	_colorTab = new uint32[2 * 256]; // 2048 bytes
 
-	int16 *Cr_r_tab = &_colorTab[0 * 256];
-	int16 *Cr_g_tab = &_colorTab[1 * 256];
-	int16 *Cb_g_tab = &_colorTab[2 * 256];
-	int16 *Cb_b_tab = &_colorTab[3 * 256];
+	uint32 *Cr_tab = &_colorTab[0 * 256];
+	uint32 *Cb_tab = &_colorTab[1 * 256];
 
 	_rgbToPix = new uint32[3 * 768]; // 9216 bytes
 
@@ -123,10 +127,13 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format) {
 		// would be done here. See the Berkeley mpeg_play sources.
 
 		CR = CB = (i - 128);
-		Cr_r_tab[i] = (int16) ( (0.419 / 0.299) * CR) + 0 * 768 + 256;
-		Cr_g_tab[i] = (int16) (-(0.299 / 0.419) * CR) + 1 * 768 + 256;
-		Cb_g_tab[i] = (int16) (-(0.114 / 0.331) * CB);
-		Cb_b_tab[i] = (int16) ( (0.587 / 0.331) * CB) + 2 * 768 + 256;
+		int16 Cr_r = (int16) ( (0.419 / 0.299) * CR) + 0 * 768 + 256;
+		int16 Cr_g = (int16) (-(0.299 / 0.419) * CR) + 1 * 768 + 256;
+		int16 Cb_g = (int16) (-(0.114 / 0.331) * CB);
+		int16 Cb_b = (int16) ( (0.587 / 0.331) * CB) + 2 * 768 + 256;
+
+		Cr_tab[i] = (uint16)Cr_r | ((uint32)(uint16)Cr_g << 16);
+		Cb_tab[i] = (uint16)Cb_b | ((uint32)(uint16)Cb_g << 16);
 	}
 
 	// Set up entries 0-255 in rgb-to-pixel value tables.
@@ -162,26 +169,31 @@ private:
 	YUVToRGBManager();
 	~YUVToRGBManager();
 
-	Graphics::PixelFormat _lastFormat;
-	YUVToRGBLookup *_lookup;
+	// The lookups are kept until shutdown, as videos and images converted
+	// to different formats may be decoded alternately, and on different
+	// threads when they are decoded ahead.
+	Common::Array<YUVToRGBLookup *> _lookups;
+	Common::Mutex _lookupsMutex;
 };
 
 YUVToRGBManager::YUVToRGBManager() {
-	_lookup = 0;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
-	delete _lookup;
+	for (uint i = 0; i < _lookups.size(); i++)
+		delete _lookups[i];
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format) {
-	if (_lastFormat == format)
-		return _lookup;
+	Common::StackLock lock(_lookupsMutex);
+
+	for (uint i = 0; i < _lookups.size(); i++)
+		if (_lookups[i]->_format == format)
+			return _lookups[i];
 
-	delete _lookup;
-	_lookup = new YUVToRGBLookup(format);
-	_lastFormat = format;
-	return _lookup;
+	YUVToRGBLookup *lookup = new YUVToRGBLookup(format);
+	_lookups.push_back(lookup);
+	return lookup;
 }
 
 } // End of namespace Graphics
@@ -198,22 +210,26 @@ namespace Graphics {
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
+// The green offset wraps around in the high half when Cb_g is negative
+#define GET_OFFSETS(u, v) \
+	uint32 cr = Cr_tab[(v)]; \
+	uint32 cb = Cb_tab[(u)]; \
+	uint16 cr_r  = (uint16)cr; \
+	uint16 crb_g = (uint16)((cr + cb) >> 16); \
+	uint16 cb_b  = (uint16)cb
+
 template<typename PixelInt>
 void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->_colorTab;
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
+	const uint32 *Cr_tab = lookup->_colorTab;
+	const uint32 *Cb_tab = Cr_tab + 256;
 	const uint32 *rgbToPix = lookup->_rgbToPix;
 
 	for (int h = 0; h < yHeight; h++) {
 		for (int w = 0; w < yWidth; w++) {
 			register const uint32 *L;
 
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
+			GET_OFFSETS(*uSrc, *vSrc);
 			++uSrc;
 			++vSrc;
 
@@ -250,19 +266,15 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	int halfWidth = yWidth >> 1;
 
 	// Keep the tables in pointers here to avoid a dereference on each pixel
-	const int16 *Cr_r_tab = lookup->_colorTab;
-	const int16 *Cr_g_tab = Cr_r_tab + 256;
-	const int16 *Cb_g_tab = Cr_g_tab + 256;
-	const int16 *Cb_b_tab = Cb_g_tab + 256;
+	const uint32 *Cr_tab = lookup->_colorTab;
+	const uint32 *Cb_tab = Cr_tab + 256;
 	const uint32 *rgbToPix = lookup->_rgbToPix;
 
 	for (int h = 0; h < halfHeight; h++) {
 		for (int w = 0; w < halfWidth; w++) {
 			register const uint32 *L;
 
-			int16 cr_r  = Cr_r_tab[*vSrc];
-			int16 crb_g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
-			int16 cb_b  = Cb_b_tab[*uSrc];
+			GET_OFFSETS(*uSrc, *vSrc);
 			++uSrc;
 			++vSrc;
 
@@ -276,7 +288,7 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
 		vSrc += uvPitch - halfWidth;
@@ -24,6 +24,8 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "common/debug-channels.h"
+#include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #include "engines/engine.h"
@@ -64,6 +66,8 @@ Debugger::Debugger() {
 	DCmd_Register("debugflag_list",		WRAP_METHOD(Debugger, Cmd_DebugFlagsList));
 	DCmd_Register("debugflag_enable",	WRAP_METHOD(Debugger, Cmd_DebugFlagEnable));
 	DCmd_Register("debugflag_disable",	WRAP_METHOD(Debugger, Cmd_DebugFlagDisable));
+
+	DCmd_Register("profile",			WRAP_METHOD(Debugger, Cmd_Profile));
 }
 
 Debugger::~Debugger() {
@@ -537,6 +541,43 @@ bool Debugger::Cmd_DebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::Cmd_Profile(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		ProfileMan.enable(true);
+		DebugPrintf("Profiler enabled\n");
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		ProfileMan.enable(false);
+		DebugPrintf("Profiler disabled\n");
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		ProfileMan.reset();
+	} else if (argc == 3 && !strcmp(argv[1], "dump")) {
+		Common::DumpFile file;
+		if (!file.open(argv[2]) || !ProfileMan.writeTrace(file))
+			DebugPrintf("Failed to write the trace to '%s'\n", argv[2]);
+		else
+			DebugPrintf("Trace written to '%s'\n", argv[2]);
+	} else if (argc == 1) {
+		// The zones are copied under the profiler lock, as other threads
+		// may enter them while they are printed
+		Common::Array<Common::ProfileZoneStats> zones;
+		ProfileMan.getZones(zones);
+		if (zones.empty()) {
+			DebugPrintf("No profile zones were entered%s\n", Common::Profiler::isEnabled() ? "" : ", the profiler is disabled");
+			return true;
+		}
+
+		DebugPrintf("Zone                              Count   Total ms    Avg us    Max us\n");
+		for (uint i = 0; i < zones.size(); i++) {
+			const Common::ProfileZoneStats &zone = zones[i];
+			DebugPrintf("%-32s %6u %10.2f %9u %9u\n", zone.name.c_str(), zone.count,
+					zone.totalTime / 1000.0, (uint32)(zone.totalTime / zone.count), zone.maxTime);
+		}
+	} else {
+		DebugPrintf("profile [on | off | reset | dump <file>]\n");
+	}
+	return true;
+}
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -0,0 +1,73 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decode_ahead.h"
+
+#include "helper.h"
+#include "test/common/system.h"
+
+class DecodeAheadAudioTestSuite : public CxxTest::TestSuite {
+public:
+	void test_decode_ahead() {
+		TestSystem *system = getTestSystem();
+		TestTimerManager *timers = system->getTestTimerManager();
+
+		int16 *sine;
+		CountingAudioStream *source = new CountingAudioStream(createSineStream<int16>(8000, 1, &sine, false, false));
+		Audio::DecodeAheadAudioStream *stream = new Audio::DecodeAheadAudioStream(source, 1024);
+		TS_ASSERT_EQUALS(timers->getTimerCount(), 1U);
+
+		// The ring buffer gets filled on the timer
+		timers->handleTimers();
+		TS_ASSERT_EQUALS(source->getSamplesRead(), 1024U);
+
+		int16 buffer[1500];
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, 1000), 1000);
+		TS_ASSERT_EQUALS(stream->getLateSamples(), 0U);
+
+		// Samples which weren't decoded ahead are decoded right away
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer + 1000, 500), 500);
+		TS_ASSERT_EQUALS(stream->getLateSamples(), 476U);
+		TS_ASSERT_EQUALS(memcmp(buffer, sine, sizeof(buffer)), 0);
+
+		// The timer goes away with the last stream
+		delete stream;
+		TS_ASSERT_EQUALS(timers->getTimerCount(), 0U);
+
+		delete[] sine;
+	}
+
+	void test_one_stream_per_tick() {
+		TestSystem *system = getTestSystem();
+		TestTimerManager *timers = system->getTestTimerManager();
+
+		CountingAudioStream *source1 = new CountingAudioStream(createSineStream<int16>(8000, 1, 0, false, false));
+		CountingAudioStream *source2 = new CountingAudioStream(createSineStream<int16>(8000, 1, 0, false, false));
+		Audio::DecodeAheadAudioStream *stream1 = new Audio::DecodeAheadAudioStream(source1, 1024);
+		Audio::DecodeAheadAudioStream *stream2 = new Audio::DecodeAheadAudioStream(source2, 1024);
+		TS_ASSERT_EQUALS(timers->getTimerCount(), 1U);
+
+		// Each tick fills the stream with the fewest samples ready
+		timers->handleTimers();
+		TS_ASSERT_EQUALS(source1->getSamplesRead() + source2->getSamplesRead(), 1024U);
+		timers->handleTimers();
+		TS_ASSERT_EQUALS(source1->getSamplesRead(), 1024U);
+		TS_ASSERT_EQUALS(source2->getSamplesRead(), 1024U);
+
+		int16 buffer[512];
+		stream2->readBuffer(buffer, 512);
+		timers->handleTimers();
+		TS_ASSERT_EQUALS(source1->getSamplesRead(), 1024U);
+		TS_ASSERT_EQUALS(source2->getSamplesRead(), 1536U);
+
+		delete stream1;
+		TS_ASSERT_EQUALS(timers->getTimerCount(), 1U);
+		delete stream2;
+		TS_ASSERT_EQUALS(timers->getTimerCount(), 0U);
+
+		// And comes back with the next one
+		Audio::DecodeAheadAudioStream *stream3 = new Audio::DecodeAheadAudioStream(createSineStream<int16>(8000, 1, 0, false, false), 1024);
+		TS_ASSERT_EQUALS(timers->getTimerCount(), 1U);
+		delete stream3;
+		TS_ASSERT_EQUALS(timers->getTimerCount(), 0U);
+	}
+};
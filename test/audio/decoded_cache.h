@@ -0,0 +1,105 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoded_cache.h"
+
+#include "helper.h"
+#include "test/common/system.h"
+
+class DecodedSoundCacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_hit_and_miss() {
+		// The cache is guarded by a mutex
+		getTestSystem();
+
+		Audio::DecodedSoundCache cache(40000, 20000);
+		int16 *sine;
+		Audio::SeekableAudioStream *stream = createSineStream<int16>(8000, 1, &sine, false, false);
+
+		TS_ASSERT(!cache.getStream("sfx", 0, 100));
+		TS_ASSERT_EQUALS(cache.getMisses(), 1U);
+
+		checkSamples(cache.addStream("sfx", 0, 100, stream), sine, 8000);
+		TS_ASSERT_EQUALS(cache.getSize(), 16000U);
+
+		// Another sound in the same archive
+		TS_ASSERT(!cache.getStream("sfx", 100, 100));
+
+		// Each stream plays its own copy
+		Audio::SeekableAudioStream *first = cache.getStream("sfx", 0, 100);
+		checkSamples(cache.getStream("sfx", 0, 100), sine, 8000);
+		checkSamples(first, sine, 8000);
+		TS_ASSERT_EQUALS(cache.getHits(), 2U);
+		TS_ASSERT_EQUALS(cache.getMisses(), 2U);
+
+		delete[] sine;
+	}
+
+	void test_least_recently_used() {
+		getTestSystem();
+
+		Audio::DecodedSoundCache cache(40000, 20000);
+		int16 *sine;
+
+		delete cache.addStream("sfx", 0, 1, createSineStream<int16>(8000, 1, 0, false, false));
+		delete cache.addStream("sfx", 1, 1, createSineStream<int16>(8000, 1, 0, false, false));
+		TS_ASSERT_EQUALS(cache.getSize(), 32000U);
+
+		// The second sound is played least recently now, so it makes room
+		// for the third
+		delete cache.getStream("sfx", 0, 1);
+		Audio::SeekableAudioStream *stream = createSineStream<int16>(8000, 1, &sine, false, false);
+		checkSamples(cache.addStream("sfx", 2, 1, stream), sine, 8000);
+
+		TS_ASSERT_EQUALS(cache.getSize(), 32000U);
+		TS_ASSERT(!cache.getStream("sfx", 1, 1));
+		checkSamples(cache.getStream("sfx", 0, 1), sine, 8000);
+		checkSamples(cache.getStream("sfx", 2, 1), sine, 8000);
+
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0U);
+		TS_ASSERT(!cache.getStream("sfx", 0, 1));
+
+		delete[] sine;
+	}
+
+	void test_too_long() {
+		getTestSystem();
+
+		Audio::DecodedSoundCache cache(40000, 20000);
+		int16 *sine;
+
+		// The length tells the sound is too long, so it isn't decoded
+		CountingAudioStream *stream = new CountingAudioStream(createSineStream<int16>(8000, 2, &sine, false, false));
+		TS_ASSERT_EQUALS(cache.addStream("music", 0, 1, stream), stream);
+		TS_ASSERT_EQUALS(stream->getSamplesRead(), 0U);
+		checkSamples(stream, sine, 16000);
+
+		// Without a length, the sound is decoded until it is too long, and
+		// rewound then
+		stream = new CountingAudioStream(createSineStream<int16>(8000, 2, 0, false, false), false);
+		TS_ASSERT_EQUALS(cache.addStream("music", 0, 1, stream), stream);
+		TS_ASSERT_DIFFERS(stream->getSamplesRead(), 0U);
+		checkSamples(stream, sine, 16000);
+
+		TS_ASSERT_EQUALS(cache.getSize(), 0U);
+		TS_ASSERT(!cache.getStream("music", 0, 1));
+
+		delete[] sine;
+	}
+
+private:
+	/** Checks the samples played by a stream, and deletes it. */
+	void checkSamples(Audio::AudioStream *stream, const int16 *expected, int count) {
+		TS_ASSERT(stream);
+		if (!stream)
+			return;
+
+		int16 *buffer = new int16[count + 1];
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, count + 1), count);
+		TS_ASSERT_EQUALS(memcmp(buffer, expected, count * sizeof(int16)), 0);
+		TS_ASSERT(stream->endOfData());
+
+		delete[] buffer;
+		delete stream;
+	}
+};
@@ -0,0 +1,160 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/midiparser.h"
+#include "audio/softsynth/emumidi.h"
+
+#include "common/array.h"
+
+#include "test/common/system.h"
+
+namespace {
+
+/**
+ * An emulated driver which generates silence at 10 kHz, 40 samples per
+ * timer tick, and records the sample at which each command arrives.
+ */
+class TestEmulatedMidiDriver : public MidiDriver_Emulated {
+public:
+	struct Command {
+		uint32 b;
+		uint32 sample;
+	};
+
+	TestEmulatedMidiDriver() : MidiDriver_Emulated(0), _generated(0) {}
+
+	void close() {}
+	void send(uint32 b) {
+		Command command = { b, _generated };
+		_commands.push_back(command);
+	}
+
+	MidiChannel *allocateChannel() { return 0; }
+	MidiChannel *getPercussionChannel() { return 0; }
+
+	bool isStereo() const { return false; }
+	int getRate() const { return 10000; }
+
+	/** Returns the samples at which the note on commands arrived. */
+	Common::Array<uint32> getNoteOnSamples() const {
+		Common::Array<uint32> samples;
+		for (uint i = 0; i < _commands.size(); i++) {
+			if ((_commands[i].b & 0xF0) == 0x90)
+				samples.push_back(_commands[i].sample);
+		}
+		return samples;
+	}
+
+	Common::Array<Command> _commands;
+
+protected:
+	void generateSamples(int16 *buf, int len) {
+		memset(buf, 0, len * sizeof(int16));
+		_generated += len;
+	}
+
+private:
+	uint32 _generated;
+};
+
+/** Sends one command right away and two delayed ones on the first tick. */
+static void sendTestCommands(void *param) {
+	TestEmulatedMidiDriver *driver = (TestEmulatedMidiDriver *)param;
+	if (!driver->_commands.empty())
+		return;
+
+	driver->send(0x7F3C90);
+	driver->sendDelayed(0x7F3D90, 1000);
+	driver->sendDelayed(0x7F3E90, 2500);
+}
+
+static void readTestSamples(MidiDriver_Emulated &driver, int samples) {
+	int16 buffer[64];
+	while (samples > 0) {
+		const int step = MIN<int>(samples, ARRAYSIZE(buffer));
+		driver.readBuffer(buffer, step);
+		samples -= step;
+	}
+}
+
+} // End of anonymous namespace
+
+class EmulatedMidiDriverTestSuite : public CxxTest::TestSuite {
+public:
+	void test_delayed_commands() {
+		// The delayed command queue is guarded by a mutex
+		getTestSystem();
+
+		TestEmulatedMidiDriver driver;
+		driver.setTimerCallback(&driver, &sendTestCommands);
+		driver.open();
+		readTestSamples(driver, 200);
+
+		// 1 ms and 2.5 ms after the tick at sample 0
+		Common::Array<uint32> samples = driver.getNoteOnSamples();
+		TS_ASSERT_EQUALS(samples.size(), 3U);
+		TS_ASSERT_EQUALS(samples[0], 0U);
+		TS_ASSERT_EQUALS(samples[1], 10U);
+		TS_ASSERT_EQUALS(samples[2], 25U);
+	}
+
+	void test_no_lock_without_delayed_commands() {
+		TestSystem *system = getTestSystem();
+
+		TestEmulatedMidiDriver driver;
+		driver.open();
+
+		const uint lockCount = system->getLockCount();
+		readTestSamples(driver, 2000);
+		TS_ASSERT_EQUALS(system->getLockCount(), lockCount);
+
+		driver.sendDelayed(0x7F3C90, 0);
+		readTestSamples(driver, 2000);
+		TS_ASSERT_DIFFERS(system->getLockCount(), lockCount);
+	}
+
+	void test_parser_quantized() {
+		// Without the property, the notes at 5.2 ms and 10.4 ms are sent
+		// on the ticks at 4 ms and 8 ms
+		checkParser(false, 40, 80);
+	}
+
+	void test_parser_delayed() {
+		checkParser(true, 52, 104);
+	}
+
+private:
+	void checkParser(bool delayEvents, uint32 first, uint32 second) {
+		getTestSystem();
+
+		// A format 0 SMF with 96 ticks per quarter note at the default
+		// 120 bpm, so each tick is 5208 us. Two notes, one tick apart.
+		static const byte smf[] = {
+			'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96,
+			'M', 'T', 'r', 'k', 0, 0, 0, 16,
+			1, 0x90, 60, 100,
+			1, 0x90, 62, 100,
+			96, 0x80, 60, 0,
+			0, 0x80, 62, 0,
+			0, 0xFF, 0x2F, 0
+		};
+
+		TestEmulatedMidiDriver driver;
+		MidiParser *parser = MidiParser::createParser_SMF();
+		parser->property(MidiParser::mpDelayEvents, delayEvents);
+		parser->setMidiDriver(&driver);
+		parser->setTimerRate(driver.getBaseTempo());
+		TS_ASSERT(parser->loadMusic(const_cast<byte *>(smf), sizeof(smf)));
+
+		driver.setTimerCallback(parser, &MidiParser::timerCallback);
+		driver.open();
+		readTestSamples(driver, 200);
+
+		Common::Array<uint32> samples = driver.getNoteOnSamples();
+		TS_ASSERT_EQUALS(samples.size(), 2U);
+		TS_ASSERT_EQUALS(samples[0], first);
+		TS_ASSERT_EQUALS(samples[1], second);
+
+		driver.setTimerCallback(0, 0);
+		delete parser;
+	}
+};
@@ -65,4 +65,35 @@ static Audio::SeekableAudioStream *createSineStream(const int sampleRate, const
 	return s;
 }
 
+/**
+ * A wrapper around another stream, which counts the samples read from it
+ * and may hide its length.
+ */
+class CountingAudioStream : public Audio::SeekableAudioStream {
+public:
+	CountingAudioStream(Audio::SeekableAudioStream *stream, bool knownLength = true) :
+		_stream(stream), _knownLength(knownLength), _samplesRead(0) {}
+	~CountingAudioStream() { delete _stream; }
+
+	int readBuffer(int16 *buffer, const int numSamples) {
+		int samples = _stream->readBuffer(buffer, numSamples);
+		if (samples > 0)
+			_samplesRead += samples;
+		return samples;
+	}
+
+	bool isStereo() const { return _stream->isStereo(); }
+	int getRate() const { return _stream->getRate(); }
+	bool endOfData() const { return _stream->endOfData(); }
+	bool seek(const Audio::Timestamp &where) { return _stream->seek(where); }
+	Audio::Timestamp getLength() const { return _knownLength ? _stream->getLength() : Audio::Timestamp(0, getRate()); }
+
+	uint32 getSamplesRead() const { return _samplesRead; }
+
+private:
+	Audio::SeekableAudioStream *_stream;
+	bool _knownLength;
+	uint32 _samplesRead;
+};
+
 #endif
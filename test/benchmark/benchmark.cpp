@@ -0,0 +1,45 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// The benchmarks are timed with clock()
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "test/benchmark/helper.h"
+
+#include <stdio.h>
+#include <time.h>
+
+uint32 getBenchmarkMicros() {
+	return (uint32)((uint64)clock() * 1000000 / CLOCKS_PER_SEC);
+}
+
+void printBenchmark(const char *name, uint32 referenceMicros, uint32 optimizedMicros) {
+	printf("\n%-36s reference %8u us, optimized %8u us", name, referenceMicros, optimizedMicros);
+	if (optimizedMicros)
+		printf(" (%.2fx)", (double)referenceMicros / optimizedMicros);
+	fflush(stdout);
+}
+
+void printBenchmark(const char *name, uint32 micros) {
+	printf("\n%-36s %8u us", name, micros);
+	fflush(stdout);
+}
@@ -0,0 +1,209 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/bink_decoder.h"
+
+#include "test/benchmark/helper.h"
+
+namespace {
+
+/**
+ * Gives access to the IDCT of the Bink decoder.
+ */
+class BenchmarkBinkDecoder : public Video::BinkDecoder {
+public:
+	void idctPut(byte *dest, uint32 pitch, int16 *block) {
+		DecodeContext ctx;
+		ctx.dest = dest;
+		ctx.pitch = pitch;
+		IDCTPut(ctx, block);
+	}
+
+	void idctAdd(byte *dest, uint32 pitch, int16 *block) {
+		DecodeContext ctx;
+		ctx.dest = dest;
+		ctx.pitch = pitch;
+		IDCTAdd(ctx, block);
+	}
+};
+
+#define A1  2896 /* (1/sqrt(2))<<12 */
+#define A2  2217
+#define A3  3784
+#define A4 -5352
+
+#define IDCT_TRANSFORM(dest,s0,s1,s2,s3,s4,s5,s6,s7,d0,d1,d2,d3,d4,d5,d6,d7,munge,src) {\
+    const int a0 = (src)[s0] + (src)[s4]; \
+    const int a1 = (src)[s0] - (src)[s4]; \
+    const int a2 = (src)[s2] + (src)[s6]; \
+    const int a3 = (A1*((src)[s2] - (src)[s6])) >> 11; \
+    const int a4 = (src)[s5] + (src)[s3]; \
+    const int a5 = (src)[s5] - (src)[s3]; \
+    const int a6 = (src)[s1] + (src)[s7]; \
+    const int a7 = (src)[s1] - (src)[s7]; \
+    const int b0 = a4 + a6; \
+    const int b1 = (A3*(a5 + a7)) >> 11; \
+    const int b2 = ((A4*a5) >> 11) - b0 + b1; \
+    const int b3 = (A1*(a6 - a4) >> 11) - b2; \
+    const int b4 = ((A2*a7) >> 11) + b3 - b1; \
+    (dest)[d0] = munge(a0+a2   +b0); \
+    (dest)[d1] = munge(a1+a3-a2+b2); \
+    (dest)[d2] = munge(a1-a3+a2+b3); \
+    (dest)[d3] = munge(a0-a2   -b4); \
+    (dest)[d4] = munge(a0-a2   +b4); \
+    (dest)[d5] = munge(a1-a3+a2-b3); \
+    (dest)[d6] = munge(a1+a3-a2-b2); \
+    (dest)[d7] = munge(a0+a2   -b0); \
+}
+
+#define MUNGE_NONE(x) (x)
+#define IDCT_COL(dest,src) IDCT_TRANSFORM(dest,0,8,16,24,32,40,48,56,0,8,16,24,32,40,48,56,MUNGE_NONE,src)
+
+#define MUNGE_ROW(x) (((x) + 0x7F)>>8)
+#define IDCT_ROW(dest,src) IDCT_TRANSFORM(dest,0,1,2,3,4,5,6,7,0,1,2,3,4,5,6,7,MUNGE_ROW,src)
+
+/**
+ * The Bink IDCT as it was before the row shortcut: only columns without AC
+ * coefficients are shortcut, and IDCTAdd() transforms the whole block before
+ * adding it.
+ */
+class ReferenceBinkIDCT {
+public:
+	static void idctPut(byte *dest, uint32 pitch, int16 *block) {
+		int16 temp[64];
+		for (int i = 0; i < 8; i++)
+			idctCol(&temp[i], &block[i]);
+		for (int i = 0; i < 8; i++) {
+			IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
+		}
+	}
+
+	static void idctAdd(byte *dest, uint32 pitch, int16 *block) {
+		idct(block);
+		for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+			for (int j = 0; j < 8; j++)
+				dest[j] += block[j];
+	}
+
+private:
+	static void idctCol(int16 *dest, const int16 *src) {
+		if ((src[8] | src[16] | src[24] | src[32] | src[40] | src[48] | src[56]) == 0) {
+			dest[ 0] =
+			dest[ 8] =
+			dest[16] =
+			dest[24] =
+			dest[32] =
+			dest[40] =
+			dest[48] =
+			dest[56] = src[0];
+		} else {
+			IDCT_COL(dest, src);
+		}
+	}
+
+	static void idct(int16 *block) {
+		int16 temp[64];
+		for (int i = 0; i < 8; i++)
+			idctCol(&temp[i], &block[i]);
+		for (int i = 0; i < 8; i++) {
+			IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
+		}
+	}
+};
+
+#undef IDCT_ROW
+#undef MUNGE_ROW
+#undef IDCT_COL
+#undef MUNGE_NONE
+#undef IDCT_TRANSFORM
+#undef A4
+#undef A3
+#undef A2
+#undef A1
+
+} // End of anonymous namespace
+
+class BinkBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Transforms sparse blocks like the ones of Bink intra and residue
+	 * blocks: a DC value, and a few low frequency coefficients in three
+	 * quarters of them.
+	 */
+	void test_idct() {
+		const int kBlockCount = 1 << 14;
+		const int kIterations = 16;
+
+		int16 *blocks = new int16[kBlockCount * 64];
+		memset(blocks, 0, kBlockCount * 64 * sizeof(int16));
+
+		uint32 state = 1;
+		for (int i = 0; i < kBlockCount; i++) {
+			int16 *block = blocks + i * 64;
+			state = state * 1103515245 + 12345;
+			block[0] = (int16)((state >> 8) % 4096) - 2048;
+
+			state = state * 1103515245 + 12345;
+			const int count = ((state >> 8) % 4) ? (state >> 12) % 6 : 0;
+			for (int j = 0; j < count; j++) {
+				state = state * 1103515245 + 12345;
+				const int row = (state >> 8) % 3;
+				const int col = (state >> 12) % 3;
+				block[row * 8 + col] = (int16)((state >> 16) % 512) - 256;
+			}
+		}
+
+		BenchmarkBinkDecoder decoder;
+		const uint32 kPitch = 8;
+		byte *referenceDest = new byte[kBlockCount * 64];
+		byte *dest = new byte[kBlockCount * 64];
+		int16 block[64];
+
+		// IDCTPut()
+		uint32 start = getBenchmarkMicros();
+		for (int n = 0; n < kIterations; n++) {
+			for (int i = 0; i < kBlockCount; i++) {
+				memcpy(block, blocks + i * 64, sizeof(block));
+				ReferenceBinkIDCT::idctPut(referenceDest + i * 64, kPitch, block);
+			}
+		}
+		uint32 referenceTime = getBenchmarkMicros() - start;
+
+		start = getBenchmarkMicros();
+		for (int n = 0; n < kIterations; n++) {
+			for (int i = 0; i < kBlockCount; i++) {
+				memcpy(block, blocks + i * 64, sizeof(block));
+				decoder.idctPut(dest + i * 64, kPitch, block);
+			}
+		}
+		uint32 time = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(memcmp(dest, referenceDest, kBlockCount * 64), 0);
+		printBenchmark("Bink IDCTPut, 256K blocks", referenceTime, time);
+
+		// IDCTAdd(), on top of the output of IDCTPut()
+		start = getBenchmarkMicros();
+		for (int n = 0; n < kIterations; n++) {
+			for (int i = 0; i < kBlockCount; i++) {
+				memcpy(block, blocks + ((i + 1) % kBlockCount) * 64, sizeof(block));
+				ReferenceBinkIDCT::idctAdd(referenceDest + i * 64, kPitch, block);
+			}
+		}
+		referenceTime = getBenchmarkMicros() - start;
+
+		start = getBenchmarkMicros();
+		for (int n = 0; n < kIterations; n++) {
+			for (int i = 0; i < kBlockCount; i++) {
+				memcpy(block, blocks + ((i + 1) % kBlockCount) * 64, sizeof(block));
+				decoder.idctAdd(dest + i * 64, kPitch, block);
+			}
+		}
+		time = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(memcmp(dest, referenceDest, kBlockCount * 64), 0);
+		printBenchmark("Bink IDCTAdd, 256K blocks", referenceTime, time);
+
+		delete[] dest;
+		delete[] referenceDest;
+		delete[] blocks;
+	}
+};
@@ -0,0 +1,73 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+
+#include "test/benchmark/helper.h"
+
+class KeyBlitBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/** Blits a 200x150 sprite 1000 times. */
+	void test_key_blit_8bit_sparse() {
+		checkKeyBlit<byte>("keyBlit, 1000x 200x150 8 bit, 1/16 keyed", 16, false);
+	}
+
+	void test_key_blit_8bit_dense() {
+		checkKeyBlit<byte>("keyBlit, 1000x 200x150 8 bit, 1/2 keyed", 2, false);
+	}
+
+	void test_key_blit_16bit() {
+		checkKeyBlit<uint16>("keyBlit, 1000x 200x150 16 bit, 1/16 keyed", 16, false);
+	}
+
+	void test_key_blit_masked_8bit() {
+		checkKeyBlit<byte>("keyBlitMasked, 1000x 200x150 8 bit, noise", 16, true, false);
+	}
+
+	void test_key_blit_masked_8bit_blocks() {
+		checkKeyBlit<byte>("keyBlitMasked, 1000x 200x150 8 bit, blocks", 16, true, true);
+	}
+
+private:
+	template<typename Pixel>
+	void checkKeyBlit(const char *name, uint transparentRate, bool masked, bool blockMask = false) {
+		const int kIterations = 1000;
+		const int width = 200, height = 150;
+		const int srcPitch = width * sizeof(Pixel), dstPitch = 640 * sizeof(Pixel);
+
+		// Transparent runs at the sides of the sprite, like most sprites have
+		Common::Array<byte> sprite, mask, blitted;
+		sprite.resize(srcPitch * height);
+		uint32 state = 1;
+		for (int i = 0; i < srcPitch * height; i += sizeof(Pixel)) {
+			state = state * 1103515245 + 12345;
+			memset(&sprite[i], ((state >> 24) % transparentRate) ? (byte)((state >> 16) | 1) : 0, sizeof(Pixel));
+		}
+		for (int y = 0; y < height; y++) {
+			memset(&sprite[y * srcPitch], 0, (y % 40) * sizeof(Pixel));
+			memset(&sprite[(y + 1) * srcPitch - (y % 30) * sizeof(Pixel)], 0, (y % 30) * sizeof(Pixel));
+		}
+		mask.resize(640 * height);
+		for (int i = 0; i < 640 * height; i++) {
+			state = state * 1103515245 + 12345;
+			mask[i] = state >> 16;
+		}
+		if (blockMask) {
+			// Parts of the background in front of the sprite in 16x16 blocks
+			for (int y = 0; y < height; y++)
+				for (int x = 0; x < 640; x++)
+					mask[y * 640 + x] = ((x / 16 + y / 16) % 3) ? 255 : 0;
+		}
+		blitted.resize(dstPitch * height);
+
+		const uint32 start = getBenchmarkMicros();
+		for (int i = 0; i < kIterations; i++) {
+			if (masked)
+				Graphics::keyBlitMasked(blitted.begin(), sprite.begin(), mask.begin(), dstPitch, srcPitch, 640, width, height, 128, sizeof(Pixel), 0);
+			else
+				Graphics::keyBlit(blitted.begin(), sprite.begin(), dstPitch, srcPitch, width, height, sizeof(Pixel), 0);
+		}
+		const uint32 time = getBenchmarkMicros() - start;
+
+		printBenchmark(name, time);
+	}
+};
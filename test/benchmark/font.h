@@ -0,0 +1,46 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/font.h"
+#include "graphics/fontman.h"
+
+#include "test/benchmark/helper.h"
+
+class FontBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Draws 40 lines of 100 characters of the 6x12 GUI font over a 640x480
+	 * surface.
+	 */
+	void test_bdf_16bit() {
+		checkDrawString("BDF font, 100x 40 lines to 16 bit", Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_bdf_8bit() {
+		checkDrawString("BDF font, 100x 40 lines to 8 bit", Graphics::PixelFormat::createFormatCLUT8());
+	}
+
+private:
+	void checkDrawString(const char *name, const Graphics::PixelFormat &format) {
+		const int kIterations = 100;
+
+		const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kGUIFont);
+
+		Common::String text;
+		for (int i = 0; i < 100; i++)
+			text += (char)(32 + (i * 37) % 95);
+
+		Graphics::Surface surface;
+		surface.create(640, 480, format);
+		memset(surface.pixels, 0, surface.pitch * surface.h);
+
+		const uint32 start = getBenchmarkMicros();
+		for (int i = 0; i < kIterations; i++)
+			for (int y = 0; y < 40; y++)
+				font->drawString(&surface, text, 0, y * 12, 640, i + y);
+		const uint32 time = getBenchmarkMicros() - start;
+
+		surface.free();
+
+		printBenchmark(name, time);
+	}
+};
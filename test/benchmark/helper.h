@@ -0,0 +1,25 @@
+#ifndef TEST_BENCHMARK_HELPER_H
+#define TEST_BENCHMARK_HELPER_H
+
+#include "common/scummsys.h"
+
+/**
+ * Returns the processor time used so far, in microseconds. This is defined
+ * in benchmark.cpp, outside of the benchmark suites, as these may not use
+ * the system time functions.
+ */
+uint32 getBenchmarkMicros();
+
+/**
+ * Prints the time taken by the reference and the optimized implementation of
+ * an operation.
+ */
+void printBenchmark(const char *name, uint32 referenceMicros, uint32 optimizedMicros);
+
+/**
+ * Prints the time taken by an operation which has no reference
+ * implementation, to compare between builds.
+ */
+void printBenchmark(const char *name, uint32 micros);
+
+#endif
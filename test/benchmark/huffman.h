@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/bitstream.h"
+#include "common/huffman.h"
+#include "common/list.h"
+#include "common/memstream.h"
+
+#include "video/binkdata.h"
+
+#include "test/benchmark/helper.h"
+
+namespace {
+
+/**
+ * The Huffman decoder as it was before it got lookup tables: it reads one
+ * bit at a time and scans the codes of each length.
+ */
+class ReferenceHuffman {
+public:
+	ReferenceHuffman(uint32 codeCount, const uint32 *codes, const uint8 *lengths) {
+		for (uint32 i = 0; i < codeCount; i++) {
+			if (lengths[i] > _codes.size())
+				_codes.resize(lengths[i]);
+			_codes[lengths[i] - 1].push_back(Code(codes[i], i));
+		}
+	}
+
+	template<class BITSTREAM>
+	uint32 getSymbol(BITSTREAM &bits) const {
+		uint32 code = 0;
+
+		for (uint32 i = 0; i < _codes.size(); i++) {
+			bits.addBit(code, i);
+
+			for (CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
+				if (code == cCode->code)
+					return cCode->symbol;
+		}
+
+		return 0xFFFFFFFF;
+	}
+
+private:
+	struct Code {
+		uint32 code;
+		uint32 symbol;
+
+		Code(uint32 c, uint32 s) : code(c), symbol(s) {}
+	};
+
+	typedef Common::List<Code> CodeList;
+	Common::Array<CodeList> _codes;
+};
+
+} // End of anonymous namespace
+
+class HuffmanBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Decodes a synthetic Bink-like stream: 32-bit little endian LSB-first
+	 * values, holding runs of symbols from each of the 16 Bink codebooks.
+	 */
+	void test_bink_stream() {
+		const uint32 kSymbolCount = 1 << 21;
+		const uint32 kRunLength = 64;
+
+		// Draw symbols with probabilities matching their code lengths, which
+		// is what the Bink encoder aims at
+		uint32 *trees = new uint32[kSymbolCount];
+		uint32 *symbols = new uint32[kSymbolCount];
+		uint32 state = 1;
+		uint32 bitCount = 0;
+		for (uint32 i = 0; i < kSymbolCount; i++) {
+			const uint32 tree = (i / kRunLength) % 16;
+			uint32 symbol;
+			do {
+				state = state * 1103515245 + 12345;
+				symbol = (state >> 12) & 15;
+				state = state * 1103515245 + 12345;
+			} while (((state >> 8) & 0xFF) >= (256u >> (Video::binkHuffmanLengths[tree][symbol] - 1)));
+
+			trees[i] = tree;
+			symbols[i] = symbol;
+			bitCount += Video::binkHuffmanLengths[tree][symbol];
+		}
+
+		const uint32 size = ((bitCount + 31) / 32) * 4;
+		byte *data = new byte[size];
+		memset(data, 0, size);
+
+		uint32 bit = 0;
+		for (uint32 i = 0; i < kSymbolCount; i++) {
+			const uint32 code = Video::binkHuffmanCodes[trees[i]][symbols[i]];
+			for (uint8 j = 0; j < Video::binkHuffmanLengths[trees[i]][symbols[i]]; j++, bit++)
+				if ((code >> j) & 1)
+					data[bit / 8] |= 1 << (bit % 8);
+		}
+
+		Common::Huffman *huffman[16];
+		ReferenceHuffman *reference[16];
+		for (int i = 0; i < 16; i++) {
+			huffman[i] = new Common::Huffman(Video::binkHuffmanLengths[i][15], 16, Video::binkHuffmanCodes[i], Video::binkHuffmanLengths[i]);
+			reference[i] = new ReferenceHuffman(16, Video::binkHuffmanCodes[i], Video::binkHuffmanLengths[i]);
+		}
+
+		uint32 *decoded = new uint32[kSymbolCount];
+
+		Common::MemoryReadStream referenceStream(data, size);
+		Common::BitStream32LELSB referenceBits(referenceStream);
+		uint32 start = getBenchmarkMicros();
+		for (uint32 i = 0; i < kSymbolCount; i++)
+			decoded[i] = reference[trees[i]]->getSymbol(referenceBits);
+		const uint32 referenceTime = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(memcmp(decoded, symbols, kSymbolCount * sizeof(uint32)), 0);
+
+		memset(decoded, 0, kSymbolCount * sizeof(uint32));
+		Common::MemoryReadStream stream(data, size);
+		Common::BitStream32LELSB bits(stream);
+		start = getBenchmarkMicros();
+		for (uint32 i = 0; i < kSymbolCount; i++)
+			decoded[i] = huffman[trees[i]]->getSymbol(bits);
+		const uint32 time = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(memcmp(decoded, symbols, kSymbolCount * sizeof(uint32)), 0);
+
+		printBenchmark("Huffman, 2M Bink symbols", referenceTime, time);
+
+		for (int i = 0; i < 16; i++) {
+			delete huffman[i];
+			delete reference[i];
+		}
+		delete[] decoded;
+		delete[] data;
+		delete[] symbols;
+		delete[] trees;
+	}
+};
@@ -0,0 +1,31 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "graphics/decoders/jpeg.h"
+
+#include "test/benchmark/helper.h"
+#include "test/graphics/helper.h"
+
+class JPEGBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Decodes the 32x16 test image with subsampled chroma 20000 times, which
+	 * also times reading the headers and building the Huffman lookups.
+	 */
+	void test_decode() {
+		const int kIterations = 20000;
+
+		Graphics::JPEGDecoder decoder;
+		const uint32 start = getBenchmarkMicros();
+		for (int i = 0; i < kIterations; i++) {
+			Common::MemoryReadStream stream(testJPEG420, sizeof(testJPEG420));
+			TS_ASSERT(decoder.loadStream(stream));
+		}
+		const uint32 time = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(getSurfaceMD5(*decoder.getComponent(1)), "d22b5f2c48ef490938d2b7fef5383488");
+
+		printBenchmark("JPEG, 20000x 32x16 4:2:0 decodes", time);
+	}
+};
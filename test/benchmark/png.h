@@ -0,0 +1,40 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "graphics/decoders/png.h"
+
+#include "test/benchmark/helper.h"
+#include "test/graphics/helper.h"
+
+class PNGBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Decodes the 5x5 test images 50000 times, which mostly times reading the
+	 * chunks and inflating. Their scan lines use all the filter types.
+	 */
+	void test_true_color_alpha() {
+		checkDecode("PNG, 50000x 5x5 RGBA decodes", testPNGRGBA, sizeof(testPNGRGBA));
+	}
+
+	void test_indexed() {
+		checkDecode("PNG, 50000x 5x5 indexed decodes", testPNGIndexed, sizeof(testPNGIndexed));
+	}
+
+private:
+	void checkDecode(const char *name, const byte *data, uint32 size) {
+		const int kIterations = 50000;
+
+		Graphics::PNGDecoder decoder;
+		const uint32 start = getBenchmarkMicros();
+		for (int i = 0; i < kIterations; i++) {
+			Common::MemoryReadStream stream(data, size);
+			TS_ASSERT(decoder.loadStream(stream));
+		}
+		const uint32 time = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(decoder.getSurface()->w, 5);
+
+		printBenchmark(name, time);
+	}
+};
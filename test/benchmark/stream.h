@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/substream.h"
+
+#include "test/benchmark/helper.h"
+
+namespace {
+
+/** Reads words one at a time, like the loaders did before the array readers. */
+template<typename T, T (Common::ReadStream::*READ)()>
+static void readTestWords(Common::ReadStream &stream, T *dst, uint32 count) {
+	for (uint32 i = 0; i < count; i++)
+		dst[i] = (stream.*READ)();
+}
+
+} // End of anonymous namespace
+
+class StreamBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/**
+	 * Reads 4M little endian 16-bit words from a memory stream, one at a
+	 * time and with readUint16LEArray().
+	 */
+	void test_uint16_le() {
+		checkWords<uint16, &Common::ReadStream::readUint16LE, &Common::ReadStream::readUint16LEArray>("readUint16LE vs array", false);
+	}
+
+	/** The same for big endian 16-bit words, which are swapped on x86. */
+	void test_uint16_be() {
+		checkWords<uint16, &Common::ReadStream::readUint16BE, &Common::ReadStream::readUint16BEArray>("readUint16BE vs array", false);
+	}
+
+	/** The same for big endian 32-bit words, like Kyra's static tables. */
+	void test_uint32_be() {
+		checkWords<uint32, &Common::ReadStream::readUint32BE, &Common::ReadStream::readUint32BEArray>("readUint32BE vs array", false);
+	}
+
+	/**
+	 * The same through a sub stream, as loaders get for files in archives,
+	 * where each read() goes through two virtual calls.
+	 */
+	void test_uint32_be_substream() {
+		checkWords<uint32, &Common::ReadStream::readUint32BE, &Common::ReadStream::readUint32BEArray>("readUint32BE vs array, sub stream", true);
+	}
+
+	/**
+	 * Parses 1M SCI1-style map entries of a 16-bit resource number and a
+	 * 24-bit offset, reading each field and parsing them from peekBuffer().
+	 */
+	void test_peek_buffer() {
+		const uint32 kEntries = 1 << 20, kEntrySize = 5, kIterations = 4;
+
+		byte *data = new byte[kEntries * kEntrySize];
+		uint32 state = 1;
+		for (uint32 i = 0; i < kEntries * kEntrySize; i++) {
+			state = state * 1103515245 + 12345;
+			data[i] = state >> 16;
+		}
+
+		Common::MemoryReadStream stream(data, kEntries * kEntrySize);
+		uint32 referenceSum = 0, sum = 0;
+
+		uint32 start = getBenchmarkMicros();
+		for (uint32 i = 0; i < kIterations; i++) {
+			stream.seek(0);
+			for (uint32 e = 0; e < kEntries; e++) {
+				const uint16 number = stream.readUint16LE();
+				const uint32 offset = stream.readUint16LE() | (stream.readByte() << 16);
+				referenceSum += number ^ offset;
+			}
+		}
+		const uint32 referenceTime = getBenchmarkMicros() - start;
+
+		start = getBenchmarkMicros();
+		for (uint32 i = 0; i < kIterations; i++) {
+			stream.seek(0);
+			const byte *entries = stream.peekBuffer(kEntries * kEntrySize);
+			TS_ASSERT(entries);
+			if (!entries)
+				break;
+
+			for (uint32 e = 0; e < kEntries; e++, entries += kEntrySize)
+				sum += READ_LE_UINT16(entries) ^ (READ_LE_UINT16(entries + 2) | (entries[4] << 16));
+			stream.skip(kEntries * kEntrySize);
+		}
+		const uint32 time = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(sum, referenceSum);
+		TS_ASSERT(stream.eos() || stream.pos() == stream.size());
+
+		printBenchmark("SCI map entries, read vs peekBuffer", referenceTime, time);
+
+		delete[] data;
+	}
+
+private:
+	template<typename T, T (Common::ReadStream::*READ)(), uint32 (Common::ReadStream::*READ_ARRAY)(T *, uint32)>
+	void checkWords(const char *name, bool useSubStream) {
+		const uint32 kCount = 1 << 22, kIterations = 4;
+
+		byte *data = new byte[kCount * sizeof(T)];
+		uint32 state = 1;
+		for (uint32 i = 0; i < kCount * sizeof(T); i++) {
+			state = state * 1103515245 + 12345;
+			data[i] = state >> 16;
+		}
+
+		Common::MemoryReadStream memoryStream(data, kCount * sizeof(T));
+		Common::SeekableSubReadStream subStream(&memoryStream, 0, kCount * sizeof(T));
+		Common::SeekableReadStream &stream = useSubStream ? (Common::SeekableReadStream &)subStream : (Common::SeekableReadStream &)memoryStream;
+
+		T *reference = new T[kCount];
+		T *words = new T[kCount];
+
+		uint32 start = getBenchmarkMicros();
+		for (uint32 i = 0; i < kIterations; i++) {
+			stream.seek(0);
+			readTestWords<T, READ>(stream, reference, kCount);
+		}
+		const uint32 referenceTime = getBenchmarkMicros() - start;
+
+		start = getBenchmarkMicros();
+		for (uint32 i = 0; i < kIterations; i++) {
+			stream.seek(0);
+			TS_ASSERT_EQUALS((stream.*READ_ARRAY)(words, kCount), kCount);
+		}
+		const uint32 time = getBenchmarkMicros() - start;
+
+		TS_ASSERT_EQUALS(memcmp(words, reference, kCount * sizeof(T)), 0);
+
+		printBenchmark(name, referenceTime, time);
+
+		delete[] words;
+		delete[] reference;
+		delete[] data;
+	}
+};
@@ -0,0 +1,67 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/yuv_to_rgb.h"
+
+#include "test/benchmark/helper.h"
+#include "test/common/system.h"
+
+class YUVToRGBBenchmarkSuite : public CxxTest::TestSuite {
+public:
+	/** Converts 1280x720 frames of noise. */
+	void test_yuv444_16bit() {
+		checkConversion("YUV444, 100x 1280x720 to 565", false, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_yuv444_32bit() {
+		checkConversion("YUV444, 100x 1280x720 to 8888", false, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+
+	void test_yuv420_16bit() {
+		checkConversion("YUV420, 100x 1280x720 to 565", true, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_yuv420_32bit() {
+		checkConversion("YUV420, 100x 1280x720 to 8888", true, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+
+private:
+	void checkConversion(const char *name, bool subsampled, const Graphics::PixelFormat &format) {
+		const int kIterations = 100;
+		const int width = 1280, height = 720;
+		const int uvWidth = subsampled ? width / 2 : width;
+		const int uvHeight = subsampled ? height / 2 : height;
+
+		getTestSystem();
+
+		Common::Array<byte> ySrc, uSrc, vSrc;
+		ySrc.resize(width * height);
+		uSrc.resize(uvWidth * uvHeight);
+		vSrc.resize(uvWidth * uvHeight);
+		uint32 state = 1;
+		for (uint i = 0; i < ySrc.size(); i++) {
+			state = state * 1103515245 + 12345;
+			ySrc[i] = state >> 16;
+		}
+		for (uint i = 0; i < uSrc.size(); i++) {
+			state = state * 1103515245 + 12345;
+			uSrc[i] = state >> 16;
+			vSrc[i] = state >> 24;
+		}
+
+		Graphics::Surface converted;
+		converted.create(width, height, format);
+
+		const uint32 start = getBenchmarkMicros();
+		for (int i = 0; i < kIterations; i++) {
+			if (subsampled)
+				Graphics::convertYUV420ToRGB(&converted, ySrc.begin(), uSrc.begin(), vSrc.begin(), width, height, width, uvWidth);
+			else
+				Graphics::convertYUV444ToRGB(&converted, ySrc.begin(), uSrc.begin(), vSrc.begin(), width, height, width, uvWidth);
+		}
+		const uint32 time = getBenchmarkMicros() - start;
+
+		converted.free();
+
+		printBenchmark(name, time);
+	}
+};
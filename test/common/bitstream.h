@@ -0,0 +1,137 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/bitstream.h"
+#include "common/memstream.h"
+
+namespace {
+
+/**
+ * Read the same data with a BitStreamImpl and a BitStreamMemoryImpl of the
+ * same layout, in a pseudo-random mix of reads, peeks and skips, and check
+ * that both agree.
+ */
+template<class MEMORY_STREAM, class STREAM>
+bool compareStreams(const byte *data, uint32 size) {
+	Common::MemoryReadStream stream(data, size);
+	STREAM reference(stream);
+	MEMORY_STREAM bits(data, size);
+
+	if (bits.size() != reference.size())
+		return false;
+
+	uint32 state = 7;
+	while (true) {
+		state = state * 1103515245 + 12345;
+		const uint8 n = (state >> 16) % 33;
+
+		// Keep a safety margin, BitStreamImpl's peekBits() may not read
+		// across the last value.
+		if (reference.pos() + n + 32 > reference.size())
+			break;
+
+		switch ((state >> 24) % 4) {
+		case 0:
+			if (bits.getBits(n) != reference.getBits(n))
+				return false;
+			break;
+		case 1:
+			if (bits.peekBits(n) != reference.peekBits(n))
+				return false;
+			break;
+		case 2:
+			bits.skip(n);
+			reference.skip(n);
+			break;
+		default:
+			if (bits.getBit() != reference.getBit())
+				return false;
+			break;
+		}
+
+		if (bits.pos() != reference.pos())
+			return false;
+	}
+
+	return true;
+}
+
+} // End of anonymous namespace
+
+class BitStreamTestSuite : public CxxTest::TestSuite {
+public:
+	void test_get_bits() {
+		const byte contents[] = { 0x53, 0xA6, 0x01, 0xFF };
+
+		Common::BitStreamMemory8MSB msb(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(msb.getBits(4), 0x5u);
+		TS_ASSERT_EQUALS(msb.getBits(8), 0x3Au);
+		TS_ASSERT_EQUALS(msb.getBit(), 0u);
+		TS_ASSERT_EQUALS(msb.pos(), 13u);
+
+		Common::BitStreamMemory8LSB lsb(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(lsb.getBits(4), 0x3u);
+		TS_ASSERT_EQUALS(lsb.getBits(8), 0x65u);
+		TS_ASSERT_EQUALS(lsb.getBit(), 0u);
+		TS_ASSERT_EQUALS(lsb.pos(), 13u);
+
+		Common::BitStreamMemory16LEMSB msb16(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(msb16.getBits(16), 0xA653u);
+		TS_ASSERT_EQUALS(msb16.getBits(16), 0xFF01u);
+		TS_ASSERT(msb16.eos());
+
+		Common::BitStreamMemory32BELSB lsb32(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(lsb32.getBits(32), 0x53A601FFu);
+		TS_ASSERT(lsb32.eos());
+	}
+
+	void test_peek_skip_rewind() {
+		const byte contents[] = { 0x12, 0x34, 0x56 };
+
+		Common::BitStreamMemory8MSB bits(contents, sizeof(contents));
+		TS_ASSERT_EQUALS(bits.size(), 24u);
+
+		TS_ASSERT_EQUALS(bits.peekBits(12), 0x123u);
+		TS_ASSERT_EQUALS(bits.pos(), 0u);
+
+		bits.skip(12);
+		TS_ASSERT_EQUALS(bits.getBits(8), 0x45u);
+
+		// Peeking past the end yields zero bits
+		TS_ASSERT_EQUALS(bits.peekBits(8), 0x60u);
+
+		bits.rewind();
+		TS_ASSERT_EQUALS(bits.pos(), 0u);
+		TS_ASSERT_EQUALS(bits.getBits(24), 0x123456u);
+		TS_ASSERT(bits.eos());
+	}
+
+	void test_add_bit() {
+		const byte contents[] = { 0xA0 };
+
+		uint32 x = 0;
+		Common::BitStreamMemory8MSB msb(contents, sizeof(contents));
+		msb.addBit(x, 0);
+		msb.addBit(x, 1);
+		msb.addBit(x, 2);
+		TS_ASSERT_EQUALS(x, 0x5u);
+
+		x = 0;
+		Common::BitStreamMemory8LSB lsb(contents, sizeof(contents));
+		for (uint32 i = 0; i < 8; i++)
+			lsb.addBit(x, i);
+		TS_ASSERT_EQUALS(x, 0xA0u);
+	}
+
+	void test_same_as_stream() {
+		byte contents[256];
+		for (uint32 i = 0; i < sizeof(contents); i++)
+			contents[i] = (i * 97 + 13) ^ (i >> 3);
+
+		TS_ASSERT((compareStreams<Common::BitStreamMemory8MSB, Common::BitStream8MSB>(contents, sizeof(contents))));
+		TS_ASSERT((compareStreams<Common::BitStreamMemory8LSB, Common::BitStream8LSB>(contents, sizeof(contents))));
+		TS_ASSERT((compareStreams<Common::BitStreamMemory16LEMSB, Common::BitStream16LEMSB>(contents, sizeof(contents))));
+		TS_ASSERT((compareStreams<Common::BitStreamMemory16BELSB, Common::BitStream16BELSB>(contents, sizeof(contents))));
+		TS_ASSERT((compareStreams<Common::BitStreamMemory32LELSB, Common::BitStream32LELSB>(contents, sizeof(contents))));
+		TS_ASSERT((compareStreams<Common::BitStreamMemory32BEMSB, Common::BitStream32BEMSB>(contents, sizeof(contents))));
+	}
+};
@@ -0,0 +1,191 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/coroutines.h"
+#include "common/memorypool.h"
+
+namespace {
+
+int s_trace[16];
+int s_traceSize;
+
+void sleeperProcess(CORO_PARAM, const void *param) {
+	CORO_BEGIN_CONTEXT;
+		int i;
+	CORO_END_CONTEXT(_ctx);
+
+	const int id = *(const int *)param;
+
+	CORO_BEGIN_CODE(_ctx);
+
+	for (_ctx->i = 0; _ctx->i < 2; _ctx->i++) {
+		s_trace[s_traceSize++] = id;
+		CORO_SLEEP(id);
+	}
+
+	CORO_END_CODE;
+}
+
+void countSub(CORO_PARAM, int *counter) {
+	CORO_BEGIN_CONTEXT;
+		char padding[200];
+	CORO_END_CONTEXT(_ctx);
+
+	CORO_BEGIN_CODE(_ctx);
+
+	(*counter)++;
+	CORO_SLEEP(1);
+	(*counter)++;
+
+	CORO_END_CODE;
+}
+
+void invokerProcess(CORO_PARAM, const void *param) {
+	CORO_BEGIN_CONTEXT;
+	CORO_END_CONTEXT(_ctx);
+
+	int *counter = *(int *const *)param;
+
+	CORO_BEGIN_CODE(_ctx);
+
+	CORO_INVOKE_1(countSub, counter);
+	CORO_INVOKE_1(countSub, counter);
+
+	CORO_END_CODE;
+}
+
+/** Returns the pool a context was taken from, which is stored in front of it. */
+Common::MemoryPool *getContextPool(Common::CoroContext ctx) {
+	return *(Common::MemoryPool **)((byte *)ctx - 8);
+}
+
+} // End of anonymous namespace
+
+class CoroutinesTestSuite : public CxxTest::TestSuite {
+public:
+	void test_sleep_order() {
+		Common::CoroutineScheduler scheduler(4);
+		scheduler.reset(4);
+		s_traceSize = 0;
+
+		const int one = 1, two = 2;
+		scheduler.createProcess(1, sleeperProcess, &one, sizeof(one));
+		scheduler.createProcess(2, sleeperProcess, &two, sizeof(two));
+		TS_ASSERT_EQUALS(scheduler.getNumProcesses(), 2);
+
+		// Processes are placed at the head of the list when the scheduler
+		// is idle, so the one created last runs first.
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(s_traceSize, 2);
+		TS_ASSERT_EQUALS(s_trace[0], 2);
+		TS_ASSERT_EQUALS(s_trace[1], 1);
+
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(s_traceSize, 3);
+		TS_ASSERT_EQUALS(s_trace[2], 1);
+
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(s_traceSize, 4);
+		TS_ASSERT_EQUALS(s_trace[3], 2);
+
+		// Both processes have finished after sleeping once more
+		scheduler.schedule();
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(scheduler.getNumProcesses(), 0);
+		TS_ASSERT_EQUALS(scheduler.getMaxProcesses(), 2);
+		TS_ASSERT(scheduler.getFirstActiveProcess() == 0);
+	}
+
+	void test_invoke_and_stats() {
+		Common::CoroutineScheduler scheduler(2);
+		scheduler.reset(2);
+
+		int counter = 0;
+		int *counterPtr = &counter;
+		Common::PROCESS *proc = scheduler.createProcess(7, invokerProcess, &counterPtr, sizeof(counterPtr));
+
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(counter, 1);
+		TS_ASSERT_EQUALS(proc->runCount, 1u);
+		TS_ASSERT_EQUALS(scheduler.getFirstActiveProcess(), proc);
+
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(counter, 3);
+		TS_ASSERT_EQUALS(proc->runCount, 2u);
+
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(counter, 4);
+		TS_ASSERT_EQUALS(scheduler.getNumProcesses(), 0);
+	}
+
+	void test_kill_matching() {
+		Common::CoroutineScheduler scheduler(4);
+		scheduler.reset(3);
+
+		const int one = 1;
+		scheduler.createProcess(0x10, sleeperProcess, &one, sizeof(one));
+		scheduler.createProcess(0x11, sleeperProcess, &one, sizeof(one));
+		scheduler.createProcess(0x20, sleeperProcess, &one, sizeof(one));
+
+		s_traceSize = 0;
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(scheduler.killMatchingProcess(0x10, 0xF0), 2);
+		TS_ASSERT_EQUALS(scheduler.getNumProcesses(), 1);
+		TS_ASSERT_EQUALS(scheduler.getFirstActiveProcess()->pid, 0x20);
+	}
+
+	void test_context_pools() {
+		int counter = 0;
+
+		// Without a scheduler, contexts come from the heap
+		Common::CoroContext ctx = 0;
+		countSub(ctx, &counter);
+		TS_ASSERT(ctx != 0);
+		countSub(ctx, &counter);
+		TS_ASSERT(ctx == 0);
+
+		{
+			Common::CoroutineScheduler scheduler(2);
+			TS_ASSERT(scheduler.getContextPool(17) != 0);
+			TS_ASSERT_EQUALS(scheduler.getContextPool(17), scheduler.getContextPool(32));
+			TS_ASSERT_DIFFERS(scheduler.getContextPool(32), scheduler.getContextPool(33));
+			TS_ASSERT(scheduler.getContextPool(513) == 0);
+
+			// Only the processes of the scheduler use its pools
+			countSub(ctx, &counter);
+			TS_ASSERT(getContextPool(ctx) == 0);
+			countSub(ctx, &counter);
+			TS_ASSERT(ctx == 0);
+		}
+
+		countSub(ctx, &counter);
+		countSub(ctx, &counter);
+		TS_ASSERT(ctx == 0);
+		TS_ASSERT_EQUALS(counter, 6);
+	}
+
+	void test_context_pools_of_running_scheduler() {
+		Common::CoroutineScheduler scheduler(2);
+		scheduler.reset(2);
+
+		const int one = 1;
+		Common::PROCESS *proc = scheduler.createProcess(1, sleeperProcess, &one, sizeof(one));
+
+		{
+			// Creating another scheduler doesn't change where the contexts
+			// of the first one come from
+			Common::CoroutineScheduler other(2);
+			s_traceSize = 0;
+			scheduler.schedule();
+
+			Common::MemoryPool *pool = getContextPool(proc->state);
+			TS_ASSERT(pool != 0);
+			TS_ASSERT_EQUALS(scheduler.getContextPool(pool->getChunkSize()), pool);
+			TS_ASSERT_DIFFERS(other.getContextPool(pool->getChunkSize()), pool);
+		}
+
+		scheduler.schedule();
+		scheduler.schedule();
+		TS_ASSERT_EQUALS(s_traceSize, 2);
+		TS_ASSERT_EQUALS(scheduler.getNumProcesses(), 0);
+	}
+};
@@ -0,0 +1,142 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/bitstream.h"
+#include "common/huffman.h"
+#include "common/memstream.h"
+
+namespace {
+
+// A prefix code with lengths from 1 to 12 bits, so that it contains codes
+// both shorter and longer than what the decoder looks up at once.
+const uint32 kCodeCount = 13;
+
+uint8 s_lengths[kCodeCount];
+uint32 s_codesMSB[kCodeCount];
+uint32 s_codesLSB[kCodeCount];
+uint32 s_symbols[kCodeCount];
+
+void initCodes() {
+	for (uint32 i = 0; i < kCodeCount; i++) {
+		s_lengths[i] = MIN<uint8>(i + 1, 12);
+		s_symbols[i] = 100 + i;
+
+		// i ones followed by a zero, and twelve ones for the last code
+		uint32 code = (i == kCodeCount - 1) ? 0xFFF : ((1 << s_lengths[i]) - 2);
+
+		s_codesMSB[i] = code;
+		s_codesLSB[i] = 0;
+		for (uint8 j = 0; j < s_lengths[i]; j++)
+			if (code & (1 << (s_lengths[i] - 1 - j)))
+				s_codesLSB[i] |= 1 << j;
+	}
+}
+
+/** Write the codes of the given code indices as a bit stream. */
+uint32 encode(byte *data, uint32 dataSize, const uint32 *indices, uint32 count, bool msbFirst) {
+	memset(data, 0, dataSize);
+
+	uint32 bit = 0;
+	for (uint32 i = 0; i < count; i++) {
+		const uint32 idx = indices[i];
+		for (uint8 j = 0; j < s_lengths[idx]; j++, bit++) {
+			// Both code forms hold the first bit of the code in the position
+			// the stream will add it to.
+			bool set;
+			if (msbFirst)
+				set = (s_codesMSB[idx] >> (s_lengths[idx] - 1 - j)) & 1;
+			else
+				set = (s_codesLSB[idx] >> j) & 1;
+
+			if (set)
+				data[bit / 8] |= msbFirst ? (0x80 >> (bit % 8)) : (1 << (bit % 8));
+		}
+	}
+
+	return (bit + 7) / 8;
+}
+
+} // End of anonymous namespace
+
+class HuffmanTestSuite : public CxxTest::TestSuite {
+public:
+	void test_msb_stream() {
+		initCodes();
+
+		const uint32 indices[] = { 0, 12, 3, 9, 11, 1, 10, 2, 0, 0, 8, 4, 5, 6, 7, 1, 0 };
+		const uint32 count = ARRAYSIZE(indices);
+
+		byte data[64];
+		uint32 size = encode(data, sizeof(data), indices, count, true);
+
+		Common::MemoryReadStream stream(data, size);
+		Common::BitStream8MSB bits(stream);
+		Common::Huffman huffman(0, kCodeCount, s_codesMSB, s_lengths, s_symbols);
+
+		for (uint32 i = 0; i < count; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bits), s_symbols[indices[i]]);
+
+		// The same, directly on a memory bit stream
+		Common::BitStreamMemory8MSB memoryBits(data, size);
+		for (uint32 i = 0; i < count; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(memoryBits), s_symbols[indices[i]]);
+	}
+
+	void test_lsb_stream() {
+		initCodes();
+
+		const uint32 indices[] = { 11, 0, 12, 2, 7, 1, 1, 9, 3, 10, 0, 4, 5, 8, 6, 0, 1 };
+		const uint32 count = ARRAYSIZE(indices);
+
+		byte data[64];
+		uint32 size = encode(data, sizeof(data), indices, count, false);
+
+		Common::MemoryReadStream stream(data, size);
+		Common::BitStream8LSB bits(stream);
+		Common::Huffman huffman(0, kCodeCount, s_codesLSB, s_lengths, s_symbols);
+
+		for (uint32 i = 0; i < count; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bits), s_symbols[indices[i]]);
+	}
+
+	void test_set_symbols() {
+		initCodes();
+
+		const uint32 indices[] = { 4, 12, 0 };
+		const uint32 count = ARRAYSIZE(indices);
+
+		byte data[8];
+		uint32 size = encode(data, sizeof(data), indices, count, true);
+
+		Common::MemoryReadStream stream(data, size);
+		Common::BitStream8MSB bits(stream);
+		Common::Huffman huffman(0, kCodeCount, s_codesMSB, s_lengths, s_symbols);
+		huffman.setSymbols();
+
+		for (uint32 i = 0; i < count; i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bits), indices[i]);
+	}
+
+	void test_long_stream() {
+		initCodes();
+
+		// A longer stream, read as 32-bit values like Bink does, which
+		// crosses a number of value boundaries.
+		uint32 indices[1000];
+		uint32 state = 1;
+		for (uint32 i = 0; i < ARRAYSIZE(indices); i++) {
+			state = state * 1103515245 + 12345;
+			indices[i] = (state >> 16) % kCodeCount;
+		}
+
+		byte data[2048];
+		uint32 size = encode(data, sizeof(data), indices, ARRAYSIZE(indices), false);
+		size = (size + 3) & ~3;
+
+		Common::MemoryReadStream stream(data, size);
+		Common::BitStream32LELSB bits(stream);
+		Common::Huffman huffman(0, kCodeCount, s_codesLSB, s_lengths, s_symbols);
+
+		for (uint32 i = 0; i < ARRAYSIZE(indices); i++)
+			TS_ASSERT_EQUALS(huffman.getSymbol(bits), s_symbols[indices[i]]);
+	}
+};
@@ -85,6 +85,68 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT(!ms.eos());
 	}
 
+	void test_read_arrays() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		uint16 words[4];
+		uint32 dwords[2];
+
+		TS_ASSERT_EQUALS(ms.readUint16LEArray(words, 2), 2U);
+		TS_ASSERT_EQUALS(words[0], 0x0201);
+		TS_ASSERT_EQUALS(words[1], 0x0403);
+		TS_ASSERT_EQUALS(ms.pos(), 4);
+
+		TS_ASSERT_EQUALS(ms.readUint16BEArray(words, 2), 2U);
+		TS_ASSERT_EQUALS(words[0], 0x0506);
+		TS_ASSERT_EQUALS(words[1], 0x0708);
+		TS_ASSERT_EQUALS(ms.pos(), 8);
+
+		ms.seek(0, SEEK_SET);
+		TS_ASSERT_EQUALS(ms.readUint32LEArray(dwords, 2), 2U);
+		TS_ASSERT_EQUALS(dwords[0], 0x04030201UL);
+		TS_ASSERT_EQUALS(dwords[1], 0x08070605UL);
+
+		ms.seek(0, SEEK_SET);
+		TS_ASSERT_EQUALS(ms.readUint32BEArray(dwords, 2), 2U);
+		TS_ASSERT_EQUALS(dwords[0], 0x01020304UL);
+		TS_ASSERT_EQUALS(dwords[1], 0x05060708UL);
+		TS_ASSERT(!ms.eos());
+
+		// Only complete words are counted at the end of the stream
+		ms.seek(4, SEEK_SET);
+		TS_ASSERT_EQUALS(ms.readUint16BEArray(words, 4), 2U);
+		TS_ASSERT_EQUALS(words[1], 0x0708);
+		TS_ASSERT(ms.eos());
+	}
+
+	void test_read_signed_arrays() {
+		byte contents[] = { 0xFF, 0xFE, 0x80, 0x00, 0x00, 0x01 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		int16 words[3];
+
+		TS_ASSERT_EQUALS(ms.readSint16BEArray(words, 3), 3U);
+		TS_ASSERT_EQUALS(words[0], -2);
+		TS_ASSERT_EQUALS(words[1], -32768);
+		TS_ASSERT_EQUALS(words[2], 1);
+	}
+
+	void test_peek_buffer() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		TS_ASSERT_EQUALS(ms.peekBuffer(7), contents);
+		TS_ASSERT_EQUALS(ms.pos(), 0);
+
+		ms.seek(3, SEEK_SET);
+		TS_ASSERT_EQUALS(ms.peekBuffer(4), contents + 3);
+		TS_ASSERT_EQUALS(ms.peekBuffer(5), (const byte *)0);
+		TS_ASSERT_EQUALS(ms.readByte(), 4);
+
+		// Peeking works through the SeekableReadStream interface as well
+		Common::SeekableReadStream &stream = ms;
+		TS_ASSERT_DIFFERS(stream.peekBuffer(1), (const byte *)0);
+	}
+
 	void test_eos() {
 		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
 		Common::MemoryReadStream ms(contents, sizeof(contents));
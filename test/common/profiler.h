@@ -0,0 +1,159 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/profiler.h"
+#include "common/str.h"
+
+#include "test/common/system.h"
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_zones() {
+		TestSystem *system = getTestSystem();
+		ProfileMan.reset();
+		ProfileMan.enable(true);
+
+		for (int i = 1; i <= 3; i++)
+			enterZone(system, "first", i);
+		enterZone(system, "second", 5);
+
+		ProfileMan.enable(false);
+
+		// Not recorded, as the profiler is disabled
+		enterZone(system, "second", 7);
+
+		Common::Array<Common::ProfileZoneStats> zones;
+		ProfileMan.getZones(zones);
+		TS_ASSERT_EQUALS(zones.size(), 2u);
+		if (zones.size() == 2) {
+			TS_ASSERT_EQUALS(zones[0].name, "second");
+			TS_ASSERT_EQUALS(zones[0].count, 1u);
+			TS_ASSERT_EQUALS(zones[0].totalTime, 5000u);
+
+			TS_ASSERT_EQUALS(zones[1].name, "first");
+			TS_ASSERT_EQUALS(zones[1].count, 3u);
+			TS_ASSERT_EQUALS(zones[1].totalTime, 6000u);
+			TS_ASSERT_EQUALS(zones[1].maxTime, 3000u);
+		}
+
+		ProfileMan.reset();
+		ProfileMan.getZones(zones);
+		TS_ASSERT(zones.empty());
+	}
+
+	void test_recursion() {
+		TestSystem *system = getTestSystem();
+		ProfileMan.reset();
+		ProfileMan.enable(true);
+
+		enterRecursiveZone(system, 3);
+
+		ProfileMan.enable(false);
+
+		// Only the outermost entry is timed
+		Common::Array<Common::ProfileZoneStats> zones;
+		ProfileMan.getZones(zones);
+		TS_ASSERT_EQUALS(zones.size(), 1u);
+		if (zones.size() == 1) {
+			TS_ASSERT_EQUALS(zones[0].count, 1u);
+			TS_ASSERT_EQUALS(zones[0].totalTime, 6000u);
+			TS_ASSERT_EQUALS(zones[0].maxTime, 6000u);
+		}
+
+		ProfileMan.reset();
+	}
+
+	void test_long_total_time() {
+		TestSystem *system = getTestSystem();
+		ProfileMan.reset();
+		ProfileMan.enable(true);
+
+		// 40 minutes each, more than 2^32 microseconds in all
+		for (int i = 0; i < 3; i++)
+			enterZone(system, "first", 40 * 60 * 1000);
+
+		ProfileMan.enable(false);
+
+		Common::Array<Common::ProfileZoneStats> zones;
+		ProfileMan.getZones(zones);
+		TS_ASSERT_EQUALS(zones.size(), 1u);
+		if (zones.size() == 1)
+			TS_ASSERT_EQUALS(zones[0].totalTime, 3 * 40 * 60 * 1000000ULL);
+
+		ProfileMan.reset();
+	}
+
+	void test_zone_reloaded() {
+		TestSystem *system = getTestSystem();
+		ProfileMan.reset();
+		ProfileMan.enable(true);
+
+		enterZone(system, "first", 1);
+
+		// The zone of a plugin which was unloaded and loaded again, which
+		// keeps the statistics of the same name
+		{
+			Common::ProfileZone *zone = new Common::ProfileZone();
+			zone->name = "first";
+			zone->id = -1;
+			{
+				Common::ProfileScope scope(*zone);
+				system->delayMillis(2);
+			}
+			delete zone;
+		}
+
+		ProfileMan.enable(false);
+
+		Common::Array<Common::ProfileZoneStats> zones;
+		ProfileMan.getZones(zones);
+		TS_ASSERT_EQUALS(zones.size(), 1u);
+		if (zones.size() == 1) {
+			TS_ASSERT_EQUALS(zones[0].name, "first");
+			TS_ASSERT_EQUALS(zones[0].count, 2u);
+			TS_ASSERT_EQUALS(zones[0].totalTime, 3000u);
+		}
+
+		ProfileMan.reset();
+	}
+
+	void test_write_trace() {
+		TestSystem *system = getTestSystem();
+		ProfileMan.reset();
+		ProfileMan.enable(true);
+
+		enterZone(system, "first", 2);
+		system->delayMillis(1);
+		enterZone(system, "second", 4);
+
+		ProfileMan.enable(false);
+
+		Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+		TS_ASSERT(ProfileMan.writeTrace(stream));
+
+		Common::String trace((const char *)stream.getData(), stream.size());
+		TS_ASSERT_EQUALS(trace,
+			"{\"traceEvents\":[\n"
+			"{\"name\":\"first\",\"ph\":\"X\",\"ts\":0,\"dur\":2000,\"pid\":1,\"tid\":1},\n"
+			"{\"name\":\"second\",\"ph\":\"X\",\"ts\":3000,\"dur\":4000,\"pid\":1,\"tid\":1}\n"
+			"]}\n");
+
+		ProfileMan.reset();
+	}
+
+private:
+	static void enterZone(TestSystem *system, const char *name, uint32 millis) {
+		static Common::ProfileZone first = { "first", -1 };
+		static Common::ProfileZone second = { "second", -1 };
+
+		Common::ProfileScope scope(!strcmp(name, "first") ? first : second);
+		system->delayMillis(millis);
+	}
+
+	static void enterRecursiveZone(TestSystem *system, int depth) {
+		PROFILE_ZONE("recursive");
+		system->delayMillis(depth);
+		if (depth > 1)
+			enterRecursiveZone(system, depth - 1);
+	}
+};
@@ -0,0 +1,135 @@
+#ifndef TEST_COMMON_SYSTEM_H
+#define TEST_COMMON_SYSTEM_H
+
+#include "common/array.h"
+#include "common/system.h"
+#include "common/timer.h"
+
+#include "graphics/pixelformat.h"
+
+namespace {
+
+/**
+ * A timer manager whose timers only run when the test calls handleTimers(),
+ * so that tests can check the state between two timer calls.
+ */
+class TestTimerManager : public Common::TimerManager {
+public:
+	bool installTimerProc(TimerProc proc, int32 interval, void *refCon, const Common::String &id) {
+		Timer timer = { proc, refCon };
+		_timers.push_back(timer);
+		return true;
+	}
+
+	void removeTimerProc(TimerProc proc) {
+		for (uint i = 0; i < _timers.size(); i++) {
+			if (_timers[i].proc == proc) {
+				_timers.remove_at(i);
+				i--;
+			}
+		}
+	}
+
+	void handleTimers() {
+		for (uint i = 0; i < _timers.size(); i++)
+			_timers[i].proc(_timers[i].refCon);
+	}
+
+	uint getTimerCount() const { return _timers.size(); }
+
+private:
+	struct Timer {
+		TimerProc proc;
+		void *refCon;
+	};
+
+	Common::Array<Timer> _timers;
+};
+
+/**
+ * The OSystem used by the tests of code that needs mutexes, timers or the
+ * time. There is no screen, the mutexes only count how often they have been
+ * locked, and the time only moves on through delayMillis().
+ */
+class TestSystem : public OSystem {
+public:
+	TestSystem() : _millis(0), _lockCount(0) {
+		_timerManager = new TestTimerManager();
+	}
+
+	TestTimerManager *getTestTimerManager() { return (TestTimerManager *)_timerManager; }
+	uint getLockCount() const { return _lockCount; }
+
+	const GraphicsMode *getSupportedGraphicsModes() const {
+		static const GraphicsMode modes[] = { { 0, 0, 0 } };
+		return modes;
+	}
+	int getDefaultGraphicsMode() const { return 0; }
+	bool setGraphicsMode(int mode) { return true; }
+	int getGraphicsMode() const { return 0; }
+#ifdef USE_RGB_COLOR
+	Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const {
+		Common::List<Graphics::PixelFormat> list;
+		list.push_back(Graphics::PixelFormat::createFormatCLUT8());
+		return list;
+	}
+#endif
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	int16 getHeight() { return 0; }
+	int16 getWidth() { return 0; }
+	PaletteManager *getPaletteManager() { return 0; }
+	void copyRectToScreen(const byte *buf, int pitch, int x, int y, int w, int h) {}
+	Graphics::Surface *lockScreen() { return 0; }
+	void unlockScreen() {}
+	void fillScreen(uint32 col) {}
+	void updateScreen() {}
+	void setShakePos(int shakeOffset) {}
+
+	void showOverlay() {}
+	void hideOverlay() {}
+	Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	void clearOverlay() {}
+	void grabOverlay(OverlayColor *buf, int pitch) {}
+	void copyRectToOverlay(const OverlayColor *buf, int pitch, int x, int y, int w, int h) {}
+	int16 getOverlayHeight() { return 0; }
+	int16 getOverlayWidth() { return 0; }
+
+	bool showMouse(bool visible) { return false; }
+	void warpMouse(int x, int y) {}
+	void setMouseCursor(const byte *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, int cursorTargetScale, const Graphics::PixelFormat *format) {}
+
+	uint32 getMillis() { return _millis; }
+	void delayMillis(uint msecs) { _millis += msecs; }
+	void getTimeAndDate(TimeDate &t) const { memset(&t, 0, sizeof(t)); }
+
+	MutexRef createMutex() { return (MutexRef)this; }
+	void lockMutex(MutexRef mutex) { _lockCount++; }
+	void unlockMutex(MutexRef mutex) {}
+	void deleteMutex(MutexRef mutex) {}
+
+	Audio::Mixer *getMixer() { return 0; }
+	void quit() {}
+	void displayMessageOnOSD(const char *msg) {}
+	void logMessage(LogMessageType::Type type, const char *message) {}
+
+private:
+	uint32 _millis;
+	uint _lockCount;
+};
+
+/**
+ * Returns the test system, installing it as g_system on the first call.
+ */
+static TestSystem *getTestSystem() {
+	static TestSystem *system = 0;
+	if (!system) {
+		system = new TestSystem();
+		g_system = system;
+	}
+	return system;
+}
+
+} // End of anonymous namespace
+
+#endif
@@ -0,0 +1,66 @@
+#include <cxxtest/TestSuite.h>
+
+#ifdef ENABLE_SWORD25
+
+// The engines aren't linked into the test runner, so build the persistence
+// blocks right here
+#include "engines/sword25/kernel/inputpersistenceblock.cpp"
+#include "engines/sword25/kernel/outputpersistenceblock.cpp"
+
+#endif
+
+// cxxtestgen doesn't see the preprocessor, so the suite always exists
+class Sword25PersistenceTestSuite : public CxxTest::TestSuite {
+public:
+	void test_round_up() {
+#ifdef ENABLE_SWORD25
+		TS_ASSERT_EQUALS(roundUpToPowerOfTwo(1), 64U * 1024);
+		TS_ASSERT_EQUALS(roundUpToPowerOfTwo(64 * 1024 + 1), 128U * 1024);
+		TS_ASSERT_EQUALS(roundUpToPowerOfTwo(0x80000000), 0x80000000U);
+
+		// Sizes past the largest power of two don't wrap around
+		TS_ASSERT_EQUALS(roundUpToPowerOfTwo(0x80000001), 0x80000001U);
+		TS_ASSERT_EQUALS(roundUpToPowerOfTwo(0xFFFFFFFF), 0xFFFFFFFFU);
+#endif
+	}
+
+	void test_streamed_byte_array() {
+#ifdef ENABLE_SWORD25
+		Sword25::OutputPersistenceBlock output;
+		output.write((uint)42);
+
+		// A byte array written in pieces, larger than the initial buffer
+		byte data[1000];
+		for (uint i = 0; i < sizeof(data); i++)
+			data[i] = i * 7;
+
+		const uint handle = output.beginByteArray();
+		for (uint i = 0; i < 100; i++)
+			output.appendByteArray(data, sizeof(data));
+		output.endByteArray(handle);
+
+		output.writeString("end");
+
+		Sword25::InputPersistenceBlock input(output.getData(), output.getDataSize(), 1);
+
+		uint value;
+		input.read(value);
+		TS_ASSERT_EQUALS(value, 42U);
+
+		// The array is read in place
+		const byte *array;
+		uint size;
+		input.readByteArray(array, size);
+		TS_ASSERT_EQUALS(size, 100 * sizeof(data));
+		TS_ASSERT(array > (const byte *)output.getData());
+		TS_ASSERT(array + size < (const byte *)output.getData() + output.getDataSize());
+		for (uint i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(memcmp(array + i * sizeof(data), data, sizeof(data)), 0);
+
+		Common::String string;
+		input.readString(string);
+		TS_ASSERT_EQUALS(string, "end");
+		TS_ASSERT(input.isGood());
+#endif
+	}
+};
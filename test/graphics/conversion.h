@@ -0,0 +1,114 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/md5.h"
+#include "common/memstream.h"
+
+#include "graphics/conversion.h"
+
+namespace {
+
+/** Fills a buffer with noise. */
+static void fillTestNoise(byte *data, uint size, uint32 seed) {
+	uint32 state = seed;
+	for (uint i = 0; i < size; i++) {
+		state = state * 1103515245 + 12345;
+		data[i] = state >> 16;
+	}
+}
+
+/**
+ * Fills a buffer with pixels of which about one in three is the key, with
+ * the same value in all bytes of each pixel.
+ */
+static void fillTestSprite(byte *sprite, uint size, uint bytesPerPixel, byte key) {
+	uint32 state = 1;
+	for (uint i = 0; i + bytesPerPixel <= size; i += bytesPerPixel) {
+		state = state * 1103515245 + 12345;
+		memset(sprite + i, ((state >> 24) % 3) ? (byte)(state >> 16) : key, bytesPerPixel);
+	}
+}
+
+} // End of anonymous namespace
+
+class KeyBlitTestSuite : public CxxTest::TestSuite {
+public:
+	void test_key_blit() {
+		// The same pixels are drawn with either key
+		checkKeyBlit<byte>(0, false, "03979a73ebaa8be8bc6ebbc3616f8a0a");
+		checkKeyBlit<byte>(0xAB, false, "03979a73ebaa8be8bc6ebbc3616f8a0a");
+		checkKeyBlit<uint16>(0xABAB, false, "552a30471edf506d396f71f9f43c7d55");
+		checkKeyBlit<uint32>(0, false, "ea6f4a9c1f164f72a36e973838298439");
+	}
+
+	void test_key_blit_masked() {
+		checkKeyBlit<byte>(0, true, "6513eae72f01ec578b2ded9f1de0ea56");
+		checkKeyBlit<uint16>(0xABAB, true, "0e1068e446c45d3d340a3b5f88ad5ffc");
+		checkKeyBlit<uint32>(0xABABABAB, true, "8b73363efa071b0ae2f726710046e329");
+	}
+
+	void test_shadow_blit() {
+		byte sprite[37 * 23], mask[41 * 23], expected[43 * 23], blitted[43 * 23];
+		fillTestSprite(sprite, sizeof(sprite), 1, 0);
+		fillTestNoise(mask, sizeof(mask), 2);
+		fillTestNoise(expected, sizeof(expected), 3);
+		memcpy(blitted, expected, sizeof(blitted));
+
+		byte shadowMap[256];
+		for (int i = 0; i < 256; i++)
+			shadowMap[i] = 255 - i;
+
+		// Without a mask, and with one
+		Graphics::shadowBlit(&blitted[3], &sprite[2], 43, 37, 33, 20, 0, shadowMap);
+		Graphics::shadowBlitMasked(&blitted[1], &sprite[0], &mask[1], 43, 37, 41, 35, 23, 100, 0, shadowMap);
+
+		for (int y = 0; y < 20; y++)
+			for (int x = 0; x < 33; x++)
+				if (sprite[y * 37 + x + 2])
+					expected[y * 43 + x + 3] = shadowMap[expected[y * 43 + x + 3]];
+		for (int y = 0; y < 23; y++)
+			for (int x = 0; x < 35; x++)
+				if (sprite[y * 37 + x] && mask[y * 41 + x + 1] >= 100)
+					expected[y * 43 + x + 1] = shadowMap[expected[y * 43 + x + 1]];
+
+		TS_ASSERT_EQUALS(memcmp(expected, blitted, sizeof(blitted)), 0);
+	}
+
+private:
+	/**
+	 * Blits sprites of all widths up to 19 pixels, starting at all offsets
+	 * within a word, to catch the ends of the rows blitted by words, and
+	 * checks the MD5 of all the results.
+	 */
+	template<typename Pixel>
+	void checkKeyBlit(Pixel key, bool masked, const char *md5) {
+		const int srcPitch = 23 * sizeof(Pixel), dstPitch = 29 * sizeof(Pixel), maskPitch = 31;
+		const int height = 7;
+
+		byte sprite[srcPitch * (height + 1)], mask[maskPitch * (height + 1)], background[dstPitch * (height + 1)];
+		fillTestSprite(sprite, sizeof(sprite), sizeof(Pixel), key & 0xFF);
+		fillTestNoise(mask, sizeof(mask), 2);
+		fillTestNoise(background, sizeof(background), 3);
+
+		Common::Array<byte> blitted;
+		for (int width = 1; width < 20; width++) {
+			for (int offset = 0; offset < 4; offset++) {
+				byte dst[sizeof(background)];
+				memcpy(dst, background, sizeof(background));
+
+				const int depth = 64 * offset;
+				const byte *src = sprite + ((offset + 1) % 4) * sizeof(Pixel);
+
+				if (masked)
+					Graphics::keyBlitMasked(dst + offset * sizeof(Pixel), src, mask + offset, dstPitch, srcPitch, maskPitch, width, height, depth, sizeof(Pixel), key);
+				else
+					Graphics::keyBlit(dst + offset * sizeof(Pixel), src, dstPitch, srcPitch, width, height, sizeof(Pixel), key);
+
+				for (uint i = 0; i < sizeof(dst); i++)
+					blitted.push_back(dst[i]);
+			}
+		}
+
+		Common::MemoryReadStream stream(blitted.begin(), blitted.size());
+		TS_ASSERT_EQUALS(Common::computeStreamMD5AsString(stream), md5);
+	}
+};
@@ -0,0 +1,94 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/fonts/bdf.h"
+
+namespace {
+
+// A font of four characters with their own bounding boxes. ' ' is the
+// default character, '"' has no bitmap, and '#' is wider than a byte.
+static const byte testFontSpace[] = { 0xF8, 0x88, 0x88, 0x88, 0x88, 0x88, 0xF8 };
+static const byte testFontExclamation[] = { 0x40, 0xE0, 0xE0, 0x40, 0x40, 0x00, 0x40, 0xA0 };
+static const byte testFontHash[] = { 0x11, 0x00, 0xFF, 0xE0, 0x22, 0x00, 0x22, 0x00, 0xFF, 0xE0, 0x44, 0x00 };
+
+static const byte *const testFontBitmaps[] = { testFontSpace, testFontExclamation, 0, testFontHash };
+static const byte testFontAdvances[] = { 6, 5, 6, 12 };
+static const Graphics::BdfBoundingBox testFontBoxes[] = {
+	{ 5, 7, 0, 0 },
+	{ 3, 8, 1, -1 },
+	{ 5, 7, 0, 0 },
+	{ 11, 6, 0, 1 }
+};
+
+static const Graphics::BdfFontData testFont = {
+	12, // Max advance
+	10, // Height
+	{ 5, 7, 0, 0 }, // Bounding box
+	8, // Ascent
+
+	32, // First character
+	32, // Default character
+	4, // Characters
+
+	testFontBitmaps, // Bitmaps
+	testFontAdvances, // Advances
+	testFontBoxes // Boxes
+};
+
+} // End of anonymous namespace
+
+class BdfFontTestSuite : public CxxTest::TestSuite {
+public:
+	void test_draw() {
+		checkDraw(Graphics::PixelFormat::createFormatCLUT8());
+		checkDraw(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+private:
+	/**
+	 * Draws a string clipped at the left and the right of the surface, and
+	 * characters clipped at the top and the bottom, or outside of it.
+	 */
+	void checkDraw(const Graphics::PixelFormat &format) {
+		// '.' is the background, and the digits are the colors drawn
+		static const char *const expected[] = {
+			"...2...2....................",
+			"1...1......1..11111....1...1",
+			"11111111..111.1...1.11111111",
+			"...1......111.1...1...1...1.",
+			"...1.......1..1...1...1...1.",
+			"11111111...1..1...1.11111111",
+			"..1...........1...1..1.4.1.4",
+			"...........1..11113.44444444",
+			"..........1.1....333..4...4.",
+			"5................333..4...4.",
+			"55................3.44444444",
+			"55................3..4...4.."
+		};
+
+		Graphics::BdfFont font(testFont, DisposeAfterUse::NO);
+
+		Graphics::Surface surface;
+		surface.create(28, 12, format);
+		memset(surface.pixels, 0x55, surface.pitch * surface.h);
+
+		font.drawString(&surface, "#!\"# !", -3, 0, 40, 1, Graphics::kTextAlignLeft, 0, false);
+		font.drawChar(&surface, '#', 2, -6, 2);
+		font.drawChar(&surface, '!', 16, 6, 3);
+		font.drawChar(&surface, '#', 20, 5, 4);
+		font.drawChar(&surface, '!', -2, 8, 5);
+		font.drawChar(&surface, '#', 30, 0, 6);
+		font.drawChar(&surface, '#', 0, 20, 6);
+
+		for (int y = 0; y < surface.h; y++) {
+			Common::String row;
+			for (int x = 0; x < surface.w; x++) {
+				const uint32 color = (format.bytesPerPixel == 1) ? *(const byte *)surface.getBasePtr(x, y) : *(const uint16 *)surface.getBasePtr(x, y);
+				row += (color == 0x55 || color == 0x5555) ? '.' : (char)('0' + color);
+			}
+			TS_ASSERT_EQUALS(row, expected[y]);
+		}
+
+		surface.free();
+	}
+};
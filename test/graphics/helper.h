@@ -0,0 +1,242 @@
+#ifndef TEST_GRAPHICS_HELPER_H
+#define TEST_GRAPHICS_HELPER_H
+
+#include "common/array.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/util.h"
+
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+namespace {
+
+/**
+ * Returns the MD5 of the pixels of a surface, leaving out the padding at the
+ * end of each row.
+ */
+static Common::String getSurfaceMD5(const Graphics::Surface &surface) {
+	Common::Array<byte> pixels;
+	for (int y = 0; y < surface.h; y++) {
+		const byte *row = (const byte *)surface.getBasePtr(0, y);
+		for (int x = 0; x < surface.w * surface.format.bytesPerPixel; x++)
+			pixels.push_back(row[x]);
+	}
+
+	Common::MemoryReadStream stream(pixels.begin(), pixels.size());
+	return Common::computeStreamMD5AsString(stream);
+}
+
+// Baseline JPEG files of noise with the Huffman tables of annex K of the JPEG
+// standard, so that the AC codes go up to 16 bits
+
+/** 32x16, subsampled chroma, a restart marker after each MCU. */
+static const byte testJPEG420[] = {
+	0xFF, 0xD8, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03,
+	0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01,
+	0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02,
+	0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03,
+	0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x20,
+	0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00, 0xFF, 0xC4, 0x00, 0xD2, 0x00, 0x00,
+	0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x10, 0x00, 0x02, 0x01, 0x03,
+	0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7D, 0x00, 0x01, 0x02, 0x11,
+	0x03, 0x12, 0x21, 0x04, 0x13, 0x22, 0x31, 0x05, 0x14, 0x23, 0x32, 0x41, 0x06, 0x15, 0x24, 0x33,
+	0x42, 0x51, 0x07, 0x16, 0x25, 0x34, 0x43, 0x52, 0x61, 0x08, 0x17, 0x26, 0x35, 0x44, 0x53, 0x62,
+	0x71, 0x09, 0x18, 0x27, 0x36, 0x45, 0x54, 0x63, 0x72, 0x81, 0x0A, 0x19, 0x28, 0x37, 0x46, 0x55,
+	0x64, 0x73, 0x82, 0x91, 0x1A, 0x29, 0x38, 0x47, 0x56, 0x65, 0x74, 0x83, 0x92, 0xA1, 0x2A, 0x39,
+	0x48, 0x57, 0x66, 0x75, 0x84, 0x93, 0xA2, 0xB1, 0x3A, 0x49, 0x58, 0x67, 0x76, 0x85, 0x94, 0xA3,
+	0xB2, 0xC1, 0x4A, 0x59, 0x68, 0x77, 0x86, 0x95, 0xA4, 0xB3, 0xC2, 0xD1, 0x5A, 0x69, 0x78, 0x87,
+	0x96, 0xA5, 0xB4, 0xC3, 0xD2, 0xE1, 0x6A, 0x79, 0x88, 0x97, 0xA6, 0xB5, 0xC4, 0xD3, 0xE2, 0xF1,
+	0x7A, 0x89, 0x98, 0xA7, 0xB6, 0xC5, 0xD4, 0xE3, 0xF2, 0x8A, 0x99, 0xA8, 0xB7, 0xC6, 0xD5, 0xE4,
+	0xF3, 0x9A, 0xA9, 0xB8, 0xC7, 0xD6, 0xE5, 0xF4, 0xAA, 0xB9, 0xC8, 0xD7, 0xE6, 0xF5, 0xBA, 0xC9,
+	0xD8, 0xE7, 0xF6, 0xCA, 0xD9, 0xE8, 0xF7, 0xDA, 0xE9, 0xF8, 0xEA, 0xF9, 0xFA, 0xF0, 0xFF, 0xDD,
+	0x00, 0x04, 0x00, 0x01, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00,
+	0x3F, 0x00, 0xF7, 0xE3, 0xE6, 0x5F, 0x57, 0xAB, 0xB7, 0xFA, 0x7B, 0xFE, 0x88, 0x17, 0xDB, 0x4F,
+	0xD5, 0x4F, 0xF9, 0xAA, 0xBB, 0x1F, 0x59, 0xB1, 0xE0, 0xDF, 0xFF, 0x00, 0xDF, 0xF0, 0xF9, 0xFF,
+	0x00, 0xBF, 0xBF, 0xDF, 0x57, 0xCF, 0xCE, 0xA3, 0xE3, 0xBF, 0x4E, 0x5D, 0x6E, 0xCF, 0x97, 0xD7,
+	0xFF, 0x00, 0xFB, 0xFF, 0x00, 0xFB, 0xFE, 0x0F, 0xAC, 0xFC, 0x16, 0x3F, 0xFF, 0xD0, 0xFA, 0x04,
+	0xF8, 0xC3, 0xFF, 0x00, 0x33, 0xA7, 0xF4, 0x47, 0xE1, 0x14, 0x97, 0xA1, 0xF4, 0xFF, 0x00, 0x5E,
+	0x7F, 0xFF, 0x00, 0xDF, 0xFD, 0x59, 0x21, 0x21, 0xEF, 0xFF, 0x00, 0x9B, 0x9F, 0xFC, 0xF4, 0xF9,
+	0x07, 0xE3, 0xFF, 0x00, 0x35, 0xBF, 0xFF, 0x00, 0xEF, 0xEB, 0xFF, 0x00, 0xFE, 0xFF, 0x00, 0x4B,
+	0x1F, 0x87, 0x5F, 0xFC, 0xEC, 0x3F, 0xFF, 0xD9,
+};
+
+/** 16x16, full resolution chroma, no restart markers. */
+static const byte testJPEG444[] = {
+	0xFF, 0xD8, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03,
+	0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01,
+	0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02,
+	0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03,
+	0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10,
+	0x03, 0x01, 0x11, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00, 0xFF, 0xC4, 0x00, 0xD2, 0x00, 0x00,
+	0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x10, 0x00, 0x02, 0x01, 0x03,
+	0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7D, 0x00, 0x01, 0x02, 0x11,
+	0x03, 0x12, 0x21, 0x04, 0x13, 0x22, 0x31, 0x05, 0x14, 0x23, 0x32, 0x41, 0x06, 0x15, 0x24, 0x33,
+	0x42, 0x51, 0x07, 0x16, 0x25, 0x34, 0x43, 0x52, 0x61, 0x08, 0x17, 0x26, 0x35, 0x44, 0x53, 0x62,
+	0x71, 0x09, 0x18, 0x27, 0x36, 0x45, 0x54, 0x63, 0x72, 0x81, 0x0A, 0x19, 0x28, 0x37, 0x46, 0x55,
+	0x64, 0x73, 0x82, 0x91, 0x1A, 0x29, 0x38, 0x47, 0x56, 0x65, 0x74, 0x83, 0x92, 0xA1, 0x2A, 0x39,
+	0x48, 0x57, 0x66, 0x75, 0x84, 0x93, 0xA2, 0xB1, 0x3A, 0x49, 0x58, 0x67, 0x76, 0x85, 0x94, 0xA3,
+	0xB2, 0xC1, 0x4A, 0x59, 0x68, 0x77, 0x86, 0x95, 0xA4, 0xB3, 0xC2, 0xD1, 0x5A, 0x69, 0x78, 0x87,
+	0x96, 0xA5, 0xB4, 0xC3, 0xD2, 0xE1, 0x6A, 0x79, 0x88, 0x97, 0xA6, 0xB5, 0xC4, 0xD3, 0xE2, 0xF1,
+	0x7A, 0x89, 0x98, 0xA7, 0xB6, 0xC5, 0xD4, 0xE3, 0xF2, 0x8A, 0x99, 0xA8, 0xB7, 0xC6, 0xD5, 0xE4,
+	0xF3, 0x9A, 0xA9, 0xB8, 0xC7, 0xD6, 0xE5, 0xF4, 0xAA, 0xB9, 0xC8, 0xD7, 0xE6, 0xF5, 0xBA, 0xC9,
+	0xD8, 0xE7, 0xF6, 0xCA, 0xD9, 0xE8, 0xF7, 0xDA, 0xE9, 0xF8, 0xEA, 0xF9, 0xFA, 0xF0, 0xFF, 0xDA,
+	0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00, 0x3F, 0x00, 0xFC, 0xCC, 0xFF, 0x00,
+	0x94, 0x7F, 0xFF, 0x00, 0x7F, 0xFF, 0x00, 0x7F, 0xDE, 0x0F, 0xC6, 0xCF, 0xF8, 0x61, 0x1E, 0x58,
+	0xBF, 0xEE, 0x2F, 0xE0, 0xFF, 0x00, 0xFF, 0x00, 0xDF, 0x61, 0x3C, 0xE8, 0xE9, 0x3E, 0x3B, 0x08,
+	0x7F, 0xC8, 0x0F, 0xFF, 0x00, 0xFB, 0xFF, 0x00, 0xFB, 0xFF, 0x00, 0x3D, 0x3E, 0x39, 0xE1, 0x8C,
+	0xFF, 0x00, 0x2F, 0xF4, 0x47, 0x8D, 0x9F, 0xDA, 0xF1, 0xFA, 0x58, 0x7F, 0x43, 0xA7, 0xE2, 0x43,
+	0xFB, 0x46, 0xEB, 0xED, 0x5B, 0x4F, 0xA5, 0xFF, 0x00, 0xAD, 0xFF, 0x00, 0xB4, 0xFF, 0x00, 0xFE,
+	0xFF, 0x00, 0xFE, 0xFF, 0x00, 0x89, 0x8F, 0xCF, 0xCF, 0x07, 0x6B, 0xFD, 0xE7, 0xE3, 0xEC, 0xFE,
+	0x58, 0xFF, 0x00, 0x62, 0xFF, 0x00, 0xE6, 0xA9, 0xE3, 0x5F, 0x52, 0xB7, 0x5F, 0xF9, 0x24, 0x7F,
+	0xFF, 0xD9,
+};
+
+/**
+ * 17x9, full resolution chroma, partial MCUs at the right and the bottom, and
+ * a restart interval longer than a row of MCUs.
+ */
+static const byte testJPEGPartial[] = {
+	0xFF, 0xD8, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03,
+	0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01,
+	0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02,
+	0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0x02, 0x03,
+	0x01, 0x02, 0x03, 0x01, 0x02, 0x03, 0x01, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x09, 0x00, 0x11,
+	0x03, 0x01, 0x11, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00, 0xFF, 0xC4, 0x00, 0xD2, 0x00, 0x00,
+	0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x10, 0x00, 0x02, 0x01, 0x03,
+	0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7D, 0x00, 0x01, 0x02, 0x11,
+	0x03, 0x12, 0x21, 0x04, 0x13, 0x22, 0x31, 0x05, 0x14, 0x23, 0x32, 0x41, 0x06, 0x15, 0x24, 0x33,
+	0x42, 0x51, 0x07, 0x16, 0x25, 0x34, 0x43, 0x52, 0x61, 0x08, 0x17, 0x26, 0x35, 0x44, 0x53, 0x62,
+	0x71, 0x09, 0x18, 0x27, 0x36, 0x45, 0x54, 0x63, 0x72, 0x81, 0x0A, 0x19, 0x28, 0x37, 0x46, 0x55,
+	0x64, 0x73, 0x82, 0x91, 0x1A, 0x29, 0x38, 0x47, 0x56, 0x65, 0x74, 0x83, 0x92, 0xA1, 0x2A, 0x39,
+	0x48, 0x57, 0x66, 0x75, 0x84, 0x93, 0xA2, 0xB1, 0x3A, 0x49, 0x58, 0x67, 0x76, 0x85, 0x94, 0xA3,
+	0xB2, 0xC1, 0x4A, 0x59, 0x68, 0x77, 0x86, 0x95, 0xA4, 0xB3, 0xC2, 0xD1, 0x5A, 0x69, 0x78, 0x87,
+	0x96, 0xA5, 0xB4, 0xC3, 0xD2, 0xE1, 0x6A, 0x79, 0x88, 0x97, 0xA6, 0xB5, 0xC4, 0xD3, 0xE2, 0xF1,
+	0x7A, 0x89, 0x98, 0xA7, 0xB6, 0xC5, 0xD4, 0xE3, 0xF2, 0x8A, 0x99, 0xA8, 0xB7, 0xC6, 0xD5, 0xE4,
+	0xF3, 0x9A, 0xA9, 0xB8, 0xC7, 0xD6, 0xE5, 0xF4, 0xAA, 0xB9, 0xC8, 0xD7, 0xE6, 0xF5, 0xBA, 0xC9,
+	0xD8, 0xE7, 0xF6, 0xCA, 0xD9, 0xE8, 0xF7, 0xDA, 0xE9, 0xF8, 0xEA, 0xF9, 0xFA, 0xF0, 0xFF, 0xDD,
+	0x00, 0x04, 0x00, 0x04, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00,
+	0x3F, 0x00, 0xFD, 0x1B, 0xEB, 0xD2, 0x4B, 0xD6, 0x7E, 0x9F, 0xFF, 0x00, 0x39, 0x7A, 0x3F, 0xFF,
+	0x00, 0xBF, 0xE2, 0x73, 0xEE, 0x73, 0xDC, 0xCF, 0x88, 0x4F, 0xCE, 0x6F, 0xF9, 0x1D, 0xF5, 0x7C,
+	0xD7, 0xAF, 0xFF, 0x00, 0xFD, 0x7B, 0xF8, 0x13, 0xF4, 0x4F, 0xFD, 0x07, 0xFF, 0x00, 0x46, 0x41,
+	0xFA, 0x67, 0xFD, 0xEB, 0x69, 0xFF, 0x00, 0x4E, 0xEE, 0xCF, 0xD4, 0x0F, 0xD4, 0x7F, 0xAE, 0xFF,
+	0x00, 0x3F, 0xF9, 0xDF, 0xFF, 0x00, 0xDF, 0xF4, 0x54, 0xBF, 0xE9, 0x36, 0x79, 0x85, 0x3A, 0xBC,
+	0x12, 0xF7, 0xEE, 0x0F, 0xF8, 0xD2, 0xDF, 0xFF, 0x00, 0xEF, 0xF9, 0x11, 0xFF, 0x00, 0xA4, 0x41,
+	0xFC, 0xFE, 0x4F, 0xFF, 0x00, 0xFB, 0xFF, 0x00, 0xFB, 0xFE, 0x00, 0xFC, 0x1A, 0x3E, 0x39, 0x3F,
+	0xFF, 0xD0, 0xFB, 0xC7, 0x65, 0xFB, 0xEE, 0xD7, 0xFD, 0x25, 0x26, 0x7B, 0x97, 0xFF, 0x00, 0xF7,
+	0xFF, 0x00, 0xF7, 0xFD, 0xD6, 0x3C, 0x88, 0xFE, 0x62, 0x7F, 0xF3, 0x11, 0xD0, 0x7D, 0xCF, 0x7B,
+	0xF4, 0x3B, 0xF5, 0x73, 0x5F, 0x64, 0x7F, 0xE9, 0xB1, 0xFB, 0x5B, 0xE1, 0x7A, 0xFF, 0x00, 0xDE,
+	0xE0, 0x67, 0xFF, 0xD9,
+};
+
+// Non-interlaced PNG files of noise, with the scan lines filtered by all the
+// filter types in turn. The image data is stored and split over two IDAT
+// chunks, and the CRCs are left 0, as PNGDecoder doesn't check them.
+
+/** 5x5 RGBA. */
+static const byte testPNGRGBA[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x08, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x3A, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x69, 0x00, 0x96, 0xFF,
+	0x00, 0x0E, 0x30, 0x5C, 0x83, 0x0A, 0x37, 0x69, 0x89, 0x0A, 0x43, 0x68, 0x8A, 0x13, 0x39, 0x5E,
+	0x8C, 0x19, 0x35, 0x6E, 0x99, 0x01, 0x15, 0x39, 0x6C, 0x84, 0x04, 0xFB, 0xF2, 0x11, 0xFC, 0x05,
+	0x01, 0x00, 0x09, 0x13, 0x03, 0x05, 0x09, 0xFD, 0x0B, 0x04, 0x02, 0xF6, 0x08, 0xF4, 0x0F, 0x09,
+	0x01, 0x06, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3A, 0x49, 0x44, 0x41, 0x54, 0x09,
+	0x16, 0x0C, 0x01, 0xFD, 0xEF, 0x06, 0x07, 0xF5, 0xFB, 0xFB, 0xF2, 0x03, 0x1F, 0x25, 0x45, 0x43,
+	0xF8, 0x01, 0xFB, 0x03, 0x0E, 0x0B, 0xFE, 0x02, 0x05, 0x03, 0x0B, 0xFA, 0x03, 0x0D, 0xFF, 0x09,
+	0x04, 0xF0, 0x04, 0xF2, 0x0F, 0x1A, 0x0E, 0x0B, 0xF9, 0xFF, 0xEF, 0x0F, 0x13, 0xF3, 0x09, 0xFD,
+	0xF4, 0x05, 0x07, 0x07, 0x08, 0x8B, 0x3B, 0x21, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x49, 0x45, 0x4E, 0x44, 0x00, 0x00, 0x00, 0x00,
+};
+
+/** 5x5 RGB. */
+static const byte testPNGRGB[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x08, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x2D, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x50, 0x00, 0xAF, 0xFF,
+	0x00, 0x05, 0x33, 0x51, 0x15, 0x3A, 0x67, 0x0F, 0x3B, 0x61, 0x1D, 0x41, 0x6E, 0x11, 0x3B, 0x5F,
+	0x01, 0x1A, 0x36, 0x55, 0x04, 0x04, 0x15, 0xF1, 0xFE, 0xF2, 0x14, 0x0D, 0x05, 0xF1, 0x0A, 0x05,
+	0x02, 0xF6, 0x03, 0x05, 0xF8, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2E, 0x49, 0x44,
+	0x41, 0x54, 0x02, 0x02, 0x00, 0x11, 0xF8, 0xF9, 0x08, 0x0D, 0xFD, 0x03, 0x03, 0x16, 0x27, 0x37,
+	0x04, 0x00, 0x07, 0x06, 0x15, 0xF8, 0xFE, 0xFD, 0x06, 0x07, 0x11, 0x15, 0x04, 0xFA, 0x0E, 0x07,
+	0x0D, 0xFA, 0x08, 0x04, 0x06, 0xFE, 0x09, 0x13, 0x04, 0x01, 0xF0, 0xFE, 0x43, 0x4C, 0x16, 0x3E,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0x00, 0x00, 0x00, 0x00,
+};
+
+/** 5x5 gray scale with alpha. */
+static const byte testPNGGrayAlpha[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x21, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x37, 0x00, 0xC8, 0xFF,
+	0x00, 0x13, 0x35, 0x18, 0x2C, 0x1D, 0x32, 0x1D, 0x3D, 0x1E, 0x36, 0x01, 0x13, 0x3A, 0xFD, 0x0B,
+	0xFD, 0x05, 0x15, 0x03, 0x01, 0xEC, 0x02, 0x02, 0x0C, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x21, 0x49, 0x44, 0x41, 0x54, 0xF2, 0x0C, 0xF0, 0xFA, 0xF8, 0xFD, 0x18, 0x03, 0x0D, 0x27,
+	0x04, 0xFE, 0x06, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x04, 0x11, 0x07, 0xEF, 0x00, 0x07, 0x0E, 0x02,
+	0xF8, 0x01, 0x07, 0x76, 0x28, 0x0D, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49,
+	0x45, 0x4E, 0x44, 0x00, 0x00, 0x00, 0x00,
+};
+
+/** 5x5 gray scale. */
+static const byte testPNGGray[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x14, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x1E, 0x00, 0xE1, 0xFF,
+	0x00, 0x11, 0x0B, 0x10, 0x11, 0x13, 0x01, 0x11, 0x0E, 0xF7, 0xF9, 0x0B, 0x02, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x15, 0x49, 0x44, 0x41, 0x54, 0x0E, 0xF3, 0xFD, 0x17, 0x05, 0x03, 0x02,
+	0x11, 0x10, 0xFE, 0xFE, 0x04, 0x08, 0x02, 0x01, 0xFA, 0x16, 0x67, 0x22, 0x07, 0xC9, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0x00, 0x00, 0x00, 0x00,
+};
+
+/** 13x5 gray scale, 1 bit per pixel. */
+static const byte testPNGGray1[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x0F, 0x00, 0xF0, 0xFF,
+	0x00, 0x08, 0x0D, 0x01, 0x0C, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x44,
+	0x41, 0x54, 0x02, 0x0E, 0x02, 0x03, 0x0C, 0xFB, 0x04, 0x03, 0x0E, 0x07, 0x10, 0x01, 0x5F, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0x00, 0x00, 0x00, 0x00,
+};
+
+/** 13x5 gray scale, 2 bits per pixel. */
+static const byte testPNGGray2[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x05, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x12, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x19, 0x00, 0xE6, 0xFF,
+	0x00, 0x16, 0x0F, 0x1A, 0x1F, 0x01, 0x05, 0x17, 0xFC, 0xF7, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x12, 0x49, 0x44, 0x41, 0x54, 0x1C, 0x07, 0x09, 0x11, 0x03, 0xFF, 0x00, 0xFE, 0x09,
+	0x04, 0x14, 0x07, 0xF6, 0xF7, 0x41, 0x47, 0x06, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x49, 0x45, 0x4E, 0x44, 0x00, 0x00, 0x00, 0x00,
+};
+
+/** 13x5 gray scale, 4 bits per pixel. */
+static const byte testPNGGray4[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0D, 0x00, 0x00, 0x00, 0x05, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x19, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x28, 0x00, 0xD7, 0xFF,
+	0x00, 0x0D, 0x12, 0x16, 0x0E, 0x14, 0x13, 0x12, 0x01, 0x05, 0x09, 0x02, 0xFE, 0x19, 0xF0, 0x15,
+	0x02, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x49, 0x44, 0x41, 0x54, 0xFF, 0x0B,
+	0x16, 0xF1, 0x0F, 0xF9, 0x03, 0x15, 0x0A, 0x10, 0xF2, 0x0F, 0x06, 0xFC, 0x04, 0xFA, 0x0E, 0xFD,
+	0x08, 0x0D, 0xFE, 0x09, 0xAF, 0xC9, 0x0B, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x49, 0x45, 0x4E, 0x44, 0x00, 0x00, 0x00, 0x00,
+};
+
+/** 5x5 with an 8 color palette. */
+static const byte testPNGIndexed[] = {
+	0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x08, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x18, 0x50, 0x4C, 0x54, 0x45, 0xF8, 0xAD, 0xDA, 0xFF, 0x4B, 0xB1, 0x22,
+	0x86, 0xC3, 0xDB, 0xFD, 0x09, 0xEB, 0xC7, 0xD6, 0x84, 0x10, 0xD0, 0xDA, 0xB3, 0x3F, 0x13, 0xF5,
+	0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01,
+	0x1E, 0x00, 0xE1, 0xFF, 0x00, 0x03, 0x04, 0x03, 0x05, 0x04, 0x01, 0x01, 0x02, 0x00, 0x00, 0x01,
+	0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x49, 0x44, 0x41, 0x54, 0xFF, 0x00, 0x03,
+	0x03, 0xFD, 0x03, 0x02, 0xFF, 0x02, 0x01, 0x02, 0x04, 0x05, 0xFE, 0x00, 0x00, 0x02, 0x2F, 0x50,
+	0x04, 0x2F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0x00, 0x00,
+	0x00, 0x00,
+};
+
+} // End of anonymous namespace
+
+#endif
@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "graphics/decoders/jpeg.h"
+
+#include "test/graphics/helper.h"
+#include "test/common/system.h"
+
+class JPEGTestSuite : public CxxTest::TestSuite {
+public:
+	void test_subsampled() {
+		const char *const md5s[] = {
+			"d22b5f2c48ef490938d2b7fef5383488",
+			"bc74578a3e674c6518a075c3c78d50b9",
+			"24c99a2c2b0a0d8a70929dbbe3f50642"
+		};
+		checkDecoder(testJPEG420, sizeof(testJPEG420), 32, 16, md5s);
+	}
+
+	void test_full_resolution() {
+		const char *const md5s[] = {
+			"afed1ac1e248dfaaf3e6689ca028fc18",
+			"3b8462929d6693084b66d2ae420924e0",
+			"0e54c94cfd2ffff8304e634744c1234e"
+		};
+		checkDecoder(testJPEG444, sizeof(testJPEG444), 16, 16, md5s);
+	}
+
+	void test_partial_mcus() {
+		const char *const md5s[] = {
+			"36b04623c8baadfe8093add3207d8789",
+			"158bbf633ed77504026d51f24af5679d",
+			"892133b189223299be3b766b05577337"
+		};
+		checkDecoder(testJPEGPartial, sizeof(testJPEGPartial), 17, 9, md5s);
+	}
+
+	void test_output_pixel_format() {
+		// The YUV to RGB lookups are shared under a mutex
+		getTestSystem();
+
+		Common::MemoryReadStream stream(testJPEG420, sizeof(testJPEG420));
+		Graphics::JPEGDecoder decoder;
+		TS_ASSERT(decoder.loadStream(stream));
+
+		Graphics::Surface *converted = decoder.getSurface()->convertTo(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+
+		decoder.setOutputPixelFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		const Graphics::Surface *direct = decoder.getSurface();
+
+		TS_ASSERT_EQUALS(direct->format, converted->format);
+		for (int y = 0; y < 16; y++)
+			TS_ASSERT_EQUALS(memcmp(direct->getBasePtr(0, y), converted->getBasePtr(0, y), 32 * 2), 0);
+
+		converted->free();
+		delete converted;
+	}
+
+private:
+	/** Decodes a file, and checks the MD5s of its Y, Cb and Cr components. */
+	void checkDecoder(const byte *data, uint32 size, uint16 width, uint16 height, const char *const md5s[3]) {
+		Common::MemoryReadStream stream(data, size);
+		Graphics::JPEGDecoder decoder;
+		TS_ASSERT(decoder.loadStream(stream));
+		TS_ASSERT_EQUALS(decoder.getWidth(), width);
+		TS_ASSERT_EQUALS(decoder.getHeight(), height);
+
+		// The whole scan has been read, up to the end of image marker
+		TS_ASSERT_EQUALS(stream.pos(), (int32)size);
+
+		for (int c = 0; c < 3; c++) {
+			const Graphics::Surface *component = decoder.getComponent(c + 1);
+			TS_ASSERT_EQUALS(component->w, width);
+			TS_ASSERT_EQUALS(component->h, height);
+			TS_ASSERT_EQUALS(getSurfaceMD5(*component), md5s[c]);
+		}
+	}
+};
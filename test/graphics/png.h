@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "graphics/decoders/png.h"
+
+#include "test/graphics/helper.h"
+
+class PNGTestSuite : public CxxTest::TestSuite {
+public:
+	void test_true_color() {
+		static const uint32 rgba[] = {
+			0x0E305C83, 0x0A376989, 0x0A43688A, 0x13395E8C, 0x19356E99,
+			0x15396C84, 0x19345E95, 0x15395F95, 0x1E4C629A, 0x27496D9E,
+			0x0B416093, 0x2235649B, 0x1E4F6B96, 0x1B3B68A1, 0x1C446890,
+			0x2445758C, 0x1B3E6796, 0x2A516798, 0x27497296, 0x24536C9C,
+			0x1449679B, 0x2E537294, 0x2D4281A9, 0x1D4B7E9D, 0x225A85A5,
+		};
+		checkDecoder(testPNGRGBA, sizeof(testPNGRGBA), 5, 5, rgba);
+
+		static const uint32 rgb[] = {
+			0x053351FF, 0x153A67FF, 0x0F3B61FF, 0x1D416EFF, 0x113B5FFF,
+			0x1A3655FF, 0x1E3A6AFF, 0x0F385CFF, 0x234561FF, 0x144F66FF,
+			0x10395AFF, 0x163D6CFF, 0x11386DFF, 0x1B3E69FF, 0x214C69FF,
+			0x1E4364FF, 0x1E406FFF, 0x1D5166FF, 0x1A446DFF, 0x245980FF,
+			0x18516BFF, 0x254B77FF, 0x29576DFF, 0x325771FF, 0x33497EFF,
+		};
+		checkDecoder(testPNGRGB, sizeof(testPNGRGB), 5, 5, rgb);
+	}
+
+	void test_gray_scale() {
+		static const uint32 grayAlpha[] = {
+			0x13131335, 0x1818182C, 0x1D1D1D32, 0x1D1D1D3D, 0x1E1E1E36,
+			0x1313133A, 0x10101045, 0x0D0D0D4A, 0x2222224D, 0x23232339,
+			0x15151546, 0x18181837, 0x1919193A, 0x1C1C1C45, 0x20202051,
+			0x1717174A, 0x1B1B1B3E, 0x20202040, 0x24242449, 0x2A2A2A57,
+			0x28282851, 0x1717174A, 0x22222258, 0x26262650, 0x2B2B2B5E,
+		};
+		checkDecoder(testPNGGrayAlpha, sizeof(testPNGGrayAlpha), 5, 5, grayAlpha);
+
+		static const uint32 gray[] = {
+			0x111111FF, 0x0B0B0BFF, 0x101010FF, 0x111111FF, 0x131313FF,
+			0x111111FF, 0x1F1F1FFF, 0x161616FF, 0x0F0F0FFF, 0x1A1A1AFF,
+			0x1F1F1FFF, 0x121212FF, 0x131313FF, 0x262626FF, 0x1F1F1FFF,
+			0x111111FF, 0x222222FF, 0x2A2A2AFF, 0x262626FF, 0x202020FF,
+			0x191919FF, 0x242424FF, 0x2B2B2BFF, 0x202020FF, 0x363636FF,
+		};
+		checkDecoder(testPNGGray, sizeof(testPNGGray), 5, 5, gray);
+	}
+
+	void test_gray_scale_low_depth() {
+		static const uint32 gray1[] = {
+			0x000000FF, 0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0x000000FF, 0x000000FF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0xFFFFFFFF, 0x000000FF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0x000000FF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0xFFFFFFFF, 0x000000FF, 0xFFFFFFFF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0xFFFFFFFF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0xFFFFFFFF, 0x000000FF, 0x000000FF,
+			0xFFFFFFFF, 0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0x000000FF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x000000FF,
+			0x000000FF, 0x000000FF, 0x000000FF, 0xFFFFFFFF, 0x000000FF, 0x000000FF,
+		};
+		checkDecoder(testPNGGray1, sizeof(testPNGGray1), 13, 5, gray1);
+
+		static const uint32 gray2[] = {
+			0x000000FF, 0x555555FF, 0x555555FF, 0xAAAAAAFF, 0x000000FF, 0x000000FF, 0xFFFFFFFF,
+			0xFFFFFFFF, 0x000000FF, 0x555555FF, 0xAAAAAAFF, 0xAAAAAAFF, 0x000000FF,
+			0x000000FF, 0x000000FF, 0x555555FF, 0x555555FF, 0x000000FF, 0x555555FF, 0xFFFFFFFF,
+			0x000000FF, 0x000000FF, 0x555555FF, 0xAAAAAAFF, 0x000000FF, 0x000000FF,
+			0x000000FF, 0xAAAAAAFF, 0x000000FF, 0x555555FF, 0x000000FF, 0xAAAAAAFF, 0x000000FF,
+			0xFFFFFFFF, 0x000000FF, 0xAAAAAAFF, 0x000000FF, 0x555555FF, 0x000000FF,
+			0x000000FF, 0x000000FF, 0xFFFFFFFF, 0xFFFFFFFF, 0x000000FF, 0x555555FF, 0xAAAAAAFF,
+			0x555555FF, 0x000000FF, 0x555555FF, 0xAAAAAAFF, 0xFFFFFFFF, 0x000000FF,
+			0x000000FF, 0xAAAAAAFF, 0x000000FF, 0xFFFFFFFF, 0x000000FF, 0xAAAAAAFF, 0xAAAAAAFF,
+			0xAAAAAAFF, 0x000000FF, 0xAAAAAAFF, 0x000000FF, 0x000000FF, 0x000000FF,
+		};
+		checkDecoder(testPNGGray2, sizeof(testPNGGray2), 13, 5, gray2);
+
+		static const uint32 gray4[] = {
+			0x000000FF, 0xDDDDDDFF, 0x111111FF, 0x222222FF, 0x111111FF, 0x666666FF, 0x000000FF,
+			0xEEEEEEFF, 0x111111FF, 0x444444FF, 0x111111FF, 0x333333FF, 0x111111FF,
+			0x000000FF, 0x555555FF, 0x000000FF, 0xEEEEEEFF, 0x111111FF, 0x000000FF, 0x000000FF,
+			0xEEEEEEFF, 0x222222FF, 0x777777FF, 0x111111FF, 0x777777FF, 0x222222FF,
+			0x000000FF, 0xEEEEEEFF, 0x000000FF, 0xDDDDDDFF, 0x111111FF, 0xBBBBBBFF, 0x222222FF,
+			0x444444FF, 0x111111FF, 0x888888FF, 0x222222FF, 0x666666FF, 0x222222FF,
+			0x111111FF, 0xCCCCCCFF, 0x111111FF, 0xEEEEEEFF, 0x222222FF, 0xCCCCCCFF, 0x111111FF,
+			0xAAAAAAFF, 0x222222FF, 0x888888FF, 0x222222FF, 0xDDDDDDFF, 0x222222FF,
+			0x111111FF, 0x666666FF, 0x222222FF, 0x444444FF, 0x222222FF, 0x999999FF, 0x222222FF,
+			0x222222FF, 0x333333FF, 0x555555FF, 0x333333FF, 0x333333FF, 0x333333FF,
+		};
+		checkDecoder(testPNGGray4, sizeof(testPNGGray4), 13, 5, gray4);
+	}
+
+	void test_indexed() {
+		static const byte pixels[] = {
+			3, 4, 3, 5, 4,
+			1, 3, 3, 3, 4,
+			0, 3, 6, 6, 1,
+			2, 1, 5, 6, 5,
+			7, 5, 5, 6, 7
+		};
+		static const byte palette[] = {
+			0xF8, 0xAD, 0xDA, 0xFF, 0x4B, 0xB1, 0x22, 0x86, 0xC3, 0xDB, 0xFD, 0x09,
+			0xEB, 0xC7, 0xD6, 0x84, 0x10, 0xD0, 0xDA, 0xB3, 0x3F, 0x13, 0xF5, 0x11
+		};
+
+		Common::MemoryReadStream stream(testPNGIndexed, sizeof(testPNGIndexed));
+		Graphics::PNGDecoder decoder;
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->w, 5);
+		TS_ASSERT_EQUALS(surface->h, 5);
+		TS_ASSERT_EQUALS(surface->format.bytesPerPixel, 1);
+		TS_ASSERT_EQUALS(memcmp(decoder.getPalette(), palette, sizeof(palette)), 0);
+
+		for (int y = 0; y < 5; y++)
+			TS_ASSERT_EQUALS(memcmp(surface->getBasePtr(0, y), &pixels[y * 5], 5), 0);
+	}
+
+private:
+	/** Decodes a file, and checks its pixels, in RGBA8888. */
+	void checkDecoder(const byte *data, uint32 size, int width, int height, const uint32 *expected) {
+		Common::MemoryReadStream stream(data, size);
+		Graphics::PNGDecoder decoder;
+		TS_ASSERT(decoder.loadStream(stream));
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		TS_ASSERT_EQUALS(surface->w, width);
+		TS_ASSERT_EQUALS(surface->h, height);
+		TS_ASSERT_EQUALS(surface->format, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				TS_ASSERT_EQUALS(*(const uint32 *)surface->getBasePtr(x, y), expected[y * width + x]);
+	}
+};
@@ -0,0 +1,79 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/endian.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+
+#include "graphics/yuv_to_rgb.h"
+
+#include "test/common/system.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+public:
+	void test_convert_yuv444() {
+		checkConversion(false, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), "c5054cb8aca0e2cb4681ff4873aeec52");
+		checkConversion(false, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), "1c5d64940091f9dc8c3ae5b463795c78");
+		checkConversion(false, Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15), "03fb67471fa92682c1f219112b78c6ba");
+	}
+
+	void test_convert_yuv420() {
+		checkConversion(true, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), "092988979e3257ed5f9577c7fcda6e9f");
+		checkConversion(true, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), "c6d2a02cca19bad5327dcefff4a53b5f");
+		checkConversion(true, Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0), "4457d4a70ef2f29a6be3d1196406bbeb");
+	}
+
+private:
+	void checkConversion(bool subsampled, const Graphics::PixelFormat &format, const char *md5) {
+		// The lookups are shared under a mutex
+		getTestSystem();
+
+		// All the chroma pairs with noise for luma, including values that
+		// clip, converted into surfaces wider than the image
+		const int width = 256, height = 256;
+		const int yPitch = width + 3;
+		const int uvWidth = subsampled ? width / 2 : width;
+		const int uvPitch = uvWidth + 5;
+		const int uvHeight = subsampled ? height / 2 : height;
+
+		Common::Array<byte> ySrc, uSrc, vSrc;
+		ySrc.resize(yPitch * height);
+		uSrc.resize(uvPitch * uvHeight);
+		vSrc.resize(uvPitch * uvHeight);
+		uint32 state = 1;
+		for (uint i = 0; i < ySrc.size(); i++) {
+			state = state * 1103515245 + 12345;
+			ySrc[i] = state >> 16;
+		}
+		for (int y = 0; y < uvHeight; y++) {
+			for (int x = 0; x < uvWidth; x++) {
+				uSrc[y * uvPitch + x] = subsampled ? (x * 2) : x;
+				vSrc[y * uvPitch + x] = subsampled ? (y * 2 + (x & 1)) : y;
+			}
+		}
+
+		Graphics::Surface converted;
+		converted.create(width + 7, height, format);
+		memset(converted.pixels, 0, converted.pitch * height);
+
+		if (subsampled)
+			Graphics::convertYUV420ToRGB(&converted, ySrc.begin(), uSrc.begin(), vSrc.begin(), width, height, yPitch, uvPitch);
+		else
+			Graphics::convertYUV444ToRGB(&converted, ySrc.begin(), uSrc.begin(), vSrc.begin(), width, height, yPitch, uvPitch);
+
+		// The padding at the end of each row is left alone. The pixels are
+		// hashed in little endian order.
+		Common::Array<byte> pixels;
+		pixels.resize(converted.pitch * height);
+		for (uint i = 0; i < pixels.size(); i += format.bytesPerPixel) {
+			if (format.bytesPerPixel == 2)
+				WRITE_LE_UINT16(&pixels[i], *(const uint16 *)((const byte *)converted.pixels + i));
+			else
+				WRITE_LE_UINT32(&pixels[i], *(const uint32 *)((const byte *)converted.pixels + i));
+		}
+
+		Common::MemoryReadStream stream(pixels.begin(), pixels.size());
+		TS_ASSERT_EQUALS(Common::computeStreamMD5AsString(stream), md5);
+
+		converted.free();
+	}
+};
@@ -5,8 +5,8 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/video/*.h $(srcdir)/test/engines/*.h
+TEST_LIBS    := video/libvideo.a graphics/libgraphics.a audio/libaudio.a common/libcommon.a
 
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
@@ -35,8 +35,32 @@ test/runner.cpp: $(TESTS)
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
 
+######################################################################
+# Benchmarks, also based on CxxTest.
+# Use the 'benchmark' target to run them. Each benchmark checks an
+# optimized implementation against a reference one and prints the
+# time both took, or prints the time taken by code without a reference,
+# to compare between builds.
+######################################################################
+
+BENCHMARKS      := $(srcdir)/test/benchmark/*.h
+BENCHMARK_LIBS  := video/libvideo.a graphics/libgraphics.a audio/libaudio.a common/libcommon.a
+
+benchmark: test/benchmark_runner
+	./test/benchmark_runner
+test/benchmark_runner: test/benchmark_runner.cpp test/benchmark/benchmark.o $(BENCHMARK_LIBS)
+	$(QUIET_LINK)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+test/benchmark_runner.cpp: $(BENCHMARKS)
+	@mkdir -p test
+	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
+test/benchmark/benchmark.o: $(srcdir)/test/benchmark/benchmark.cpp
+	@mkdir -p test/benchmark
+	$(QUIET_CXX)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) -c -o $@ $<
+
+
 clean: clean-test
 clean-test:
 	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/benchmark_runner.cpp test/benchmark_runner test/benchmark/benchmark.o
 
-.PHONY: test clean-test
+.PHONY: test benchmark clean-test
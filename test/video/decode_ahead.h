@@ -0,0 +1,237 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/decode_ahead.h"
+
+#include "test/common/system.h"
+
+namespace {
+
+/**
+ * A video of 8x8 CLUT8 frames filled with their frame number, one every
+ * 10 ms, each taking decodeTime ms to decode.
+ */
+class TestVideoDecoder : public Video::SeekableVideoDecoder {
+public:
+	TestVideoDecoder(uint32 frameCount, uint32 decodeTime = 0) : _frameCount(frameCount), _decodeTime(decodeTime), _loaded(false), _decodedFrames(0) {
+		_surface.create(8, 8, Graphics::PixelFormat::createFormatCLUT8());
+	}
+
+	~TestVideoDecoder() {
+		_surface.free();
+	}
+
+	bool loadStream(Common::SeekableReadStream *stream) {
+		reset();
+		_startTime = g_system->getMillis();
+		_loaded = true;
+		return true;
+	}
+
+	void close() { _loaded = false; }
+	bool isVideoLoaded() const { return _loaded; }
+	uint16 getWidth() const { return 8; }
+	uint16 getHeight() const { return 8; }
+	Graphics::PixelFormat getPixelFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	uint32 getFrameCount() const { return _frameCount; }
+
+	uint32 getTimeToNextFrame() const {
+		uint32 nextFrameTime = (_curFrame + 1) * 10;
+		uint32 elapsedTime = getElapsedTime();
+		return (nextFrameTime > elapsedTime) ? nextFrameTime - elapsedTime : 0;
+	}
+
+	const Graphics::Surface *decodeNextFrame() {
+		g_system->delayMillis(_decodeTime);
+		_curFrame++;
+		_decodedFrames++;
+		memset(_surface.pixels, _curFrame, 8 * 8);
+		return &_surface;
+	}
+
+	void seekToTime(Audio::Timestamp time) {
+		_curFrame = time.msecs() / 10 - 1;
+		_startTime = g_system->getMillis() - time.msecs();
+	}
+
+	uint32 getDuration() const { return _frameCount * 10; }
+
+	uint32 getDecodedFrames() const { return _decodedFrames; }
+
+private:
+	uint32 _frameCount;
+	uint32 _decodeTime;
+	bool _loaded;
+	uint32 _decodedFrames;
+	Graphics::Surface _surface;
+};
+
+} // End of anonymous namespace
+
+class DecodeAheadVideoTestSuite : public CxxTest::TestSuite {
+public:
+	void test_decode_ahead() {
+		TestSystem *system = getTestSystem();
+		TestVideoDecoder *video = new TestVideoDecoder(10);
+		Video::DecodeAheadVideoDecoder decoder(video, 4);
+
+		TS_ASSERT(decoder.loadStream(0));
+		TS_ASSERT_EQUALS(system->getTestTimerManager()->getTimerCount(), 1u);
+
+		// One frame per tick, until the queue is full
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video->getDecodedFrames(), 1u);
+		for (int i = 0; i < 10; i++)
+			system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video->getDecodedFrames(), 4u);
+
+		const Graphics::Surface *frame = decoder.decodeNextFrame();
+		TS_ASSERT(frame);
+		TS_ASSERT_EQUALS(*(const byte *)frame->pixels, 0);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 0);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 10u);
+
+		// Frame 0 may still be in use, so only one more frame fits
+		system->getTestTimerManager()->handleTimers();
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video->getDecodedFrames(), 5u);
+
+		TS_ASSERT_EQUALS(decoder.getLateFrames(), 0u);
+		TS_ASSERT_EQUALS(decoder.getDroppedFrames(), 0u);
+
+		decoder.close();
+		TS_ASSERT_EQUALS(system->getTestTimerManager()->getTimerCount(), 0u);
+	}
+
+	void test_late_and_dropped_frames() {
+		TestSystem *system = getTestSystem();
+		TestVideoDecoder *video = new TestVideoDecoder(10);
+		Video::DecodeAheadVideoDecoder decoder(video, 4);
+		TS_ASSERT(decoder.loadStream(0));
+
+		// Nothing decoded ahead yet
+		const Graphics::Surface *frame = decoder.decodeNextFrame();
+		TS_ASSERT_EQUALS(*(const byte *)frame->pixels, 0);
+		TS_ASSERT_EQUALS(decoder.getLateFrames(), 1u);
+
+		for (int i = 0; i < 4; i++)
+			system->getTestTimerManager()->handleTimers();
+
+		// Frames 1 to 3 are due, frame 4 isn't
+		system->delayMillis(35);
+		frame = decoder.decodeNextFrame();
+		TS_ASSERT_EQUALS(*(const byte *)frame->pixels, 3);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 3);
+		TS_ASSERT_EQUALS(decoder.getDroppedFrames(), 2u);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 5u);
+	}
+
+	void test_seek() {
+		TestSystem *system = getTestSystem();
+		TestVideoDecoder *video = new TestVideoDecoder(10);
+		Video::DecodeAheadVideoDecoder decoder(video, 4);
+		TS_ASSERT(decoder.loadStream(0));
+
+		for (int i = 0; i < 4; i++)
+			system->getTestTimerManager()->handleTimers();
+
+		// The frames decoded ahead are thrown away
+		decoder.seekToTime(Audio::Timestamp(70, 1000));
+		system->getTestTimerManager()->handleTimers();
+
+		const Graphics::Surface *frame = decoder.decodeNextFrame();
+		TS_ASSERT_EQUALS(*(const byte *)frame->pixels, 7);
+		TS_ASSERT_EQUALS(decoder.getLateFrames(), 0u);
+
+		system->getTestTimerManager()->handleTimers();
+		system->getTestTimerManager()->handleTimers();
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(*(const byte *)decoder.decodeNextFrame()->pixels, 8);
+		TS_ASSERT_EQUALS(*(const byte *)decoder.decodeNextFrame()->pixels, 9);
+		TS_ASSERT(decoder.endOfVideo());
+	}
+
+	void test_shared_timer() {
+		TestSystem *system = getTestSystem();
+		TestVideoDecoder *video1 = new TestVideoDecoder(10);
+		TestVideoDecoder *video2 = new TestVideoDecoder(10);
+		Video::DecodeAheadVideoDecoder *decoder1 = new Video::DecodeAheadVideoDecoder(video1, 4);
+		Video::DecodeAheadVideoDecoder *decoder2 = new Video::DecodeAheadVideoDecoder(video2, 4);
+
+		TS_ASSERT(decoder1->loadStream(0));
+		system->delayMillis(5);
+		TS_ASSERT(decoder2->loadStream(0));
+		TS_ASSERT_EQUALS(system->getTestTimerManager()->getTimerCount(), 1u);
+
+		// A single frame is decoded per tick, the one due first
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video1->getDecodedFrames(), 1u);
+		TS_ASSERT_EQUALS(video2->getDecodedFrames(), 0u);
+
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video1->getDecodedFrames(), 1u);
+		TS_ASSERT_EQUALS(video2->getDecodedFrames(), 1u);
+
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video1->getDecodedFrames(), 2u);
+		TS_ASSERT_EQUALS(video2->getDecodedFrames(), 1u);
+
+		// Paused videos aren't decoded ahead
+		decoder1->pauseVideo(true);
+		system->getTestTimerManager()->handleTimers();
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video1->getDecodedFrames(), 2u);
+		TS_ASSERT_EQUALS(video2->getDecodedFrames(), 3u);
+
+		// The timer is removed with the last video, and installed again
+		// with the next one
+		delete decoder1;
+		TS_ASSERT_EQUALS(system->getTestTimerManager()->getTimerCount(), 1u);
+		delete decoder2;
+		TS_ASSERT_EQUALS(system->getTestTimerManager()->getTimerCount(), 0u);
+
+		Video::DecodeAheadVideoDecoder decoder(new TestVideoDecoder(10), 4);
+		TS_ASSERT(decoder.loadStream(0));
+		TS_ASSERT_EQUALS(system->getTestTimerManager()->getTimerCount(), 1u);
+	}
+
+	void test_decode_on_idle() {
+		TestSystem *system = getTestSystem();
+		TestVideoDecoder *video = new TestVideoDecoder(10, 3);
+		Video::DecodeAheadVideoDecoder decoder(video, 4, Video::DecodeAheadVideoDecoder::kDecodeOnIdle);
+
+		TS_ASSERT(decoder.loadStream(0));
+		TS_ASSERT_EQUALS(system->getTestTimerManager()->getTimerCount(), 0u);
+
+		// Frames are decoded until the time is up
+		const uint32 startTime = system->getMillis();
+		decoder.decodeAhead(5);
+		TS_ASSERT_EQUALS(video->getDecodedFrames(), 2u);
+		TS_ASSERT_EQUALS(system->getMillis() - startTime, 6u);
+
+		// And until the queue is full, sleeping for the rest of the time
+		decoder.decodeAhead(20);
+		TS_ASSERT_EQUALS(video->getDecodedFrames(), 4u);
+		TS_ASSERT_EQUALS(system->getMillis() - startTime, 26u);
+
+		// Frames 0 to 2 are due by now
+		TS_ASSERT_EQUALS(*(const byte *)decoder.decodeNextFrame()->pixels, 2);
+		TS_ASSERT_EQUALS(decoder.getDroppedFrames(), 2u);
+		TS_ASSERT_EQUALS(decoder.getLateFrames(), 0u);
+	}
+
+	void test_slow_frames_leave_the_timer() {
+		TestSystem *system = getTestSystem();
+		TestVideoDecoder *video = new TestVideoDecoder(10, 5);
+		Video::DecodeAheadVideoDecoder decoder(video, 4);
+		TS_ASSERT(decoder.loadStream(0));
+
+		// The first frame took longer than the timer allows, so no more
+		// are decoded there
+		system->getTestTimerManager()->handleTimers();
+		system->getTestTimerManager()->handleTimers();
+		TS_ASSERT_EQUALS(video->getDecodedFrames(), 1u);
+
+		decoder.decodeAhead(0);
+		TS_ASSERT_EQUALS(video->getDecodedFrames(), 2u);
+	}
+};
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/profiler.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -313,6 +314,8 @@ uint32 AviDecoder::getElapsedTime() const {
 }
 
 const Graphics::Surface *AviDecoder::decodeNextFrame() {
+	PROFILE_ZONE("AVI decodeNextFrame");
+
 	uint32 nextTag = _fileStream->readUint32BE();
 
 	if (_fileStream->eos())
@@ -26,13 +26,14 @@
 
 #include "audio/decoders/raw.h"
 
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 #include "common/math.h"
 #include "common/stream.h"
-#include "common/substream.h"
 #include "common/file.h"
 #include "common/str.h"
+#include "common/profiler.h"
 #include "common/bitstream.h"
 #include "common/huffman.h"
 #include "common/rdft.h"
@@ -113,6 +114,8 @@ BinkDecoder::BinkDecoder() {
 	}
 
 	_audioStream = 0;
+
+	memset(&_decodeStats, 0, sizeof(_decodeStats));
 }
 
 void BinkDecoder::startAudio() {
@@ -136,6 +139,13 @@ BinkDecoder::~BinkDecoder() {
 }
 
 void BinkDecoder::close() {
+	if (_decodeStats.frames > 0)
+		debug(2, "Bink: Decoded %d frames in %d ms, %d us per frame on average, %d us at most",
+				_decodeStats.frames, (uint32)(_decodeStats.totalTime / 1000),
+				(uint32)(_decodeStats.totalTime / _decodeStats.frames), _decodeStats.maxTime);
+
+	memset(&_decodeStats, 0, sizeof(_decodeStats));
+
 	reset();
 
 	// Stop audio
@@ -189,6 +199,8 @@ uint32 BinkDecoder::getElapsedTime() const {
 }
 
 const Graphics::Surface *BinkDecoder::decodeNextFrame() {
+	PROFILE_ZONE("Bink decodeNextFrame");
+
 	if (endOfVideo())
 		return 0;
 
@@ -210,8 +222,7 @@ const Graphics::Surface *BinkDecoder::decodeNextFrame() {
 			error("Audio packet too big for the frame");
 
 		if (audioPacketLength >= 4) {
-			uint32 audioPacketStart = _bink->pos();
-			uint32 audioPacketEnd   = _bink->pos() + audioPacketLength;
+			uint32 audioPacketEnd = _bink->pos() + audioPacketLength;
 
 			if (i == _audioTrack) {
 				// Only play one audio track
@@ -219,14 +230,19 @@ const Graphics::Surface *BinkDecoder::decodeNextFrame() {
 				//                  Number of samples in bytes
 				audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
 
-				audio.bits =
-					new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-					    audioPacketStart + 4, audioPacketEnd), true);
+				uint32 audioDataSize = audioPacketLength - 4;
+				byte *audioData = new byte[audioDataSize];
+				if (_bink->read(audioData, audioDataSize) != audioDataSize)
+					error("Failed to read the Bink audio packet");
+
+				audio.bits = new BitStream(audioData, audioDataSize);
 
 				audioPacket(audio);
 
 				delete audio.bits;
 				audio.bits = 0;
+
+				delete[] audioData;
 			}
 
 			_bink->seek(audioPacketEnd);
@@ -235,18 +251,27 @@ const Graphics::Surface *BinkDecoder::decodeNextFrame() {
 		}
 	}
 
-	uint32 videoPacketStart = _bink->pos();
-	uint32 videoPacketEnd   = _bink->pos() + frameSize;
+	byte *videoData = new byte[frameSize];
+	if (_bink->read(videoData, frameSize) != frameSize)
+		error("Failed to read the Bink video packet");
+
+	frame.bits = new BitStream(videoData, frameSize);
 
-	frame.bits =
-		new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-		    videoPacketStart, videoPacketEnd), true);
+	// Most frames take less than a millisecond to decode
+	uint32 decodeStart = g_system->getMicros();
 
 	videoPacket(frame);
 
+	_decodeStats.lastTime = g_system->getMicros() - decodeStart;
+	_decodeStats.maxTime = MAX(_decodeStats.maxTime, _decodeStats.lastTime);
+	_decodeStats.totalTime += _decodeStats.lastTime;
+	_decodeStats.frames++;
+
 	delete frame.bits;
 	frame.bits = 0;
 
+	delete[] videoData;
+
 	_curFrame++;
 	if (_curFrame == 0)
 		_startTime = g_system->getMillis();
@@ -1616,25 +1641,47 @@ static inline void IDCTCol(int16 *dest, const int16 *src)
 	}
 }
 
+// Most rows are left with only a DC value after the column pass, which
+// transforms to the same value in all of the row
+template<typename T>
+static inline void IDCTRow(T *dest, const int16 *src)
+{
+	if ((src[1] | src[2] | src[3] | src[4] | src[5] | src[6] | src[7]) == 0) {
+		const T v = MUNGE_ROW(src[0]);
+
+		dest[0] = dest[1] = dest[2] = dest[3] =
+		dest[4] = dest[5] = dest[6] = dest[7] = v;
+	} else {
+		IDCT_ROW(dest, src);
+	}
+}
+
 void BinkDecoder::IDCT(int16 *block) {
 	int i;
 	int16 temp[64];
 
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&block[8*i], &temp[8*i]);
 }
 
 void BinkDecoder::IDCTAdd(DecodeContext &ctx, int16 *block) {
 	int i, j;
+	int16 temp[64];
 
-	IDCT(block);
+	for (i = 0; i < 8; i++)
+		IDCTCol(&temp[i], &block[i]);
+
+	// Add each row to the destination as soon as it's transformed
 	byte *dest = ctx.dest;
-	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
+	for (i = 0; i < 8; i++, dest += ctx.pitch) {
+		int16 row[8];
+		IDCTRow(row, &temp[8*i]);
+
 		for (j = 0; j < 8; j++)
-			 dest[j] += block[j];
+			dest[j] += row[j];
+	}
 }
 
 void BinkDecoder::IDCTPut(DecodeContext &ctx, int16 *block) {
@@ -1642,9 +1689,8 @@ void BinkDecoder::IDCTPut(DecodeContext &ctx, int16 *block) {
 	int16 temp[64];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
-	}
+	for (i = 0; i < 8; i++)
+		IDCTRow(&ctx.dest[i*ctx.pitch], &temp[8*i]);
 }
 
 } // End of namespace Video
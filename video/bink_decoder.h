@@ -34,6 +34,7 @@
 #include "audio/audiostream.h"
 #include "audio/mixer.h"
 #include "common/array.h"
+#include "common/bitstream.h"
 #include "common/rational.h"
 
 #include "graphics/surface.h"
@@ -42,7 +43,6 @@
 
 namespace Common {
 	class SeekableReadStream;
-	class BitStream;
 	class Huffman;
 
 	class RDFT;
@@ -78,7 +78,21 @@ public:
 
 	// Bink specific
 	bool loadStream(Common::SeekableReadStream *stream, const Graphics::PixelFormat &format);
+
+	/** Video decoding time statistics of the loaded video, in microseconds. */
+	struct DecodeStatistics {
+		uint32 frames;    ///< Number of decoded frames.
+		uint32 lastTime;  ///< Decoding time of the last frame.
+		uint32 maxTime;   ///< Longest decoding time of a frame.
+		uint64 totalTime; ///< Decoding time of all frames.
+	};
+
+	const DecodeStatistics &getDecodeStatistics() const { return _decodeStats; }
+
 protected:
+	/** Bink packets are read into memory and then as 32-bit LE values, from LSB to MSB. */
+	typedef Common::BitStreamMemory32LELSB BitStream;
+
 	static const int kAudioChannelsMax  = 2;
 	static const int kAudioBlockSizeMax = (kAudioChannelsMax << 11);
 
@@ -150,7 +164,7 @@ protected:
 
 		uint32 sampleCount;
 
-		Common::BitStream *bits;
+		BitStream *bits;
 
 		bool first;
 
@@ -183,7 +197,7 @@ protected:
 		uint32 offset;
 		uint32 size;
 
-		Common::BitStream *bits;
+		BitStream *bits;
 
 		VideoFrame();
 		~VideoFrame();
@@ -230,6 +244,8 @@ protected:
 	bool _hasAlpha;   ///< Do video frames have alpha?
 	bool _swapPlanes; ///< Are the planes ordered (A)YVU instead of (A)YUV?
 
+	DecodeStatistics _decodeStats; ///< Video decoding times.
+
 	Common::Array<AudioTrack> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
 
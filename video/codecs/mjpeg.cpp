@@ -47,6 +47,7 @@ JPEGDecoder::~JPEGDecoder() {
 
 const Graphics::Surface *JPEGDecoder::decodeImage(Common::SeekableReadStream *stream) {
 	Graphics::JPEGDecoder jpeg;
+	jpeg.setOutputPixelFormat(_pixelFormat);
 
 	if (!jpeg.loadStream(*stream)) {
 		warning("Failed to decode JPEG frame");
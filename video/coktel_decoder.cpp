@@ -21,6 +21,7 @@
  */
 
 #include "common/scummsys.h"
+#include "common/profiler.h"
 #include "common/rect.h"
 #include "common/endian.h"
 #include "common/stream.h"
@@ -709,6 +710,8 @@ bool PreIMDDecoder::isVideoLoaded() const {
 }
 
 const Graphics::Surface *PreIMDDecoder::decodeNextFrame() {
+	PROFILE_ZONE("PreIMD decodeNextFrame");
+
 	if (!isVideoLoaded() || endOfVideo())
 		return 0;
 
@@ -1177,6 +1180,8 @@ bool IMDDecoder::isVideoLoaded() const {
 }
 
 const Graphics::Surface *IMDDecoder::decodeNextFrame() {
+	PROFILE_ZONE("IMD decodeNextFrame");
+
 	if (!isVideoLoaded() || endOfVideo())
 		return 0;
 
@@ -2022,6 +2027,8 @@ bool VMDDecoder::isVideoLoaded() const {
 }
 
 const Graphics::Surface *VMDDecoder::decodeNextFrame() {
+	PROFILE_ZONE("VMD decodeNextFrame");
+
 	if (!isVideoLoaded() || endOfVideo())
 		return 0;
 
@@ -0,0 +1,447 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "video/decode_ahead.h"
+
+#include "common/debug.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/timer.h"
+
+namespace Video {
+
+// How often the frames are decoded ahead, in microseconds
+static const int32 kDecodeAheadInterval = 10 * 1000;
+
+// The longest a frame may take to decode on the timer, in microseconds,
+// which is shared with the music drivers
+static const uint32 kMaxTimerDecodeTime = 2 * 1000;
+
+Common::Array<DecodeAheadVideoDecoder *> *DecodeAheadVideoDecoder::_activeDecoders = 0;
+Common::Mutex *DecodeAheadVideoDecoder::_activeDecodersMutex = 0;
+
+DecodeAheadVideoDecoder::DecodeAheadVideoDecoder(VideoDecoder *decoder, uint queueSize, DecodeMode mode, DisposeAfterUse::Flag disposeAfterUse) :
+		_decoder(decoder), _seekableDecoder(0), _disposeAfterUse(disposeAfterUse) {
+	init(queueSize, mode);
+}
+
+DecodeAheadVideoDecoder::DecodeAheadVideoDecoder(SeekableVideoDecoder *decoder, uint queueSize, DecodeMode mode, DisposeAfterUse::Flag disposeAfterUse) :
+		_decoder(decoder), _seekableDecoder(decoder), _disposeAfterUse(disposeAfterUse) {
+	init(queueSize, mode);
+}
+
+DecodeAheadVideoDecoder::~DecodeAheadVideoDecoder() {
+	close();
+
+	if (_disposeAfterUse == DisposeAfterUse::YES)
+		delete _decoder;
+}
+
+void DecodeAheadVideoDecoder::init(uint queueSize, DecodeMode mode) {
+	assert(_decoder);
+	assert(queueSize > 0);
+
+	// One more frame, for the one returned last
+	_frames.resize(queueSize + 1);
+
+	_readPos = 0;
+	_readyCount = 0;
+	_dirtyPalette = false;
+	_decoderDone = true;
+	_decodingPaused = false;
+	_mode = mode;
+	_nextFrameTime = 0;
+	_droppedFrames = 0;
+	_lateFrames = 0;
+
+	memset(_palette, 0, sizeof(_palette));
+}
+
+void DecodeAheadVideoDecoder::freeFrames() {
+	for (uint i = 0; i < _frames.size(); i++)
+		_frames[i].surface.free();
+}
+
+bool DecodeAheadVideoDecoder::loadStream(Common::SeekableReadStream *stream) {
+	close();
+
+	{
+		Common::StackLock lock(_decoderMutex);
+
+		if (!_decoder->loadStream(stream))
+			return false;
+
+		flush();
+	}
+
+	_dirtyPalette = false;
+	_droppedFrames = 0;
+	_lateFrames = 0;
+
+	startDecodingAhead();
+	return true;
+}
+
+void DecodeAheadVideoDecoder::close() {
+	stopDecodingAhead();
+
+	{
+		Common::StackLock lock(_decoderMutex);
+		_decoder->close();
+
+		Common::StackLock queueLock(_queueMutex);
+		_readyCount = 0;
+		_decoderDone = true;
+		_decodingPaused = false;
+	}
+
+	if (_droppedFrames || _lateFrames)
+		debug(2, "DecodeAheadVideoDecoder: %d frames dropped, %d frames late", _droppedFrames, _lateFrames);
+
+	freeFrames();
+	reset();
+}
+
+bool DecodeAheadVideoDecoder::isVideoLoaded() const {
+	return _decoder->isVideoLoaded();
+}
+
+uint16 DecodeAheadVideoDecoder::getWidth() const {
+	return _decoder->getWidth();
+}
+
+uint16 DecodeAheadVideoDecoder::getHeight() const {
+	return _decoder->getHeight();
+}
+
+Graphics::PixelFormat DecodeAheadVideoDecoder::getPixelFormat() const {
+	return _decoder->getPixelFormat();
+}
+
+const byte *DecodeAheadVideoDecoder::getPalette() {
+	_dirtyPalette = false;
+	return _palette;
+}
+
+bool DecodeAheadVideoDecoder::hasDirtyPalette() const {
+	return _dirtyPalette;
+}
+
+uint32 DecodeAheadVideoDecoder::getFrameCount() const {
+	return _decoder->getFrameCount();
+}
+
+uint32 DecodeAheadVideoDecoder::getElapsedTime() const {
+	return _decoder->getElapsedTime();
+}
+
+uint32 DecodeAheadVideoDecoder::getTimeToNextFrame() const {
+	Common::StackLock lock(_queueMutex);
+
+	uint32 nextFrameTime = _readyCount ? _frames[_readPos].displayTime : _nextFrameTime;
+	uint32 time = g_system->getMillis();
+
+	return (nextFrameTime > time) ? nextFrameTime - time : 0;
+}
+
+bool DecodeAheadVideoDecoder::endOfVideo() const {
+	if (!isVideoLoaded())
+		return true;
+
+	Common::StackLock lock(_queueMutex);
+	return _decoderDone && _readyCount == 0;
+}
+
+const Graphics::Surface *DecodeAheadVideoDecoder::decodeNextFrame() {
+	if (endOfVideo())
+		return 0;
+
+	{
+		Common::StackLock lock(_decoderMutex);
+
+		bool ready;
+		{
+			Common::StackLock queueLock(_queueMutex);
+			ready = _readyCount > 0;
+		}
+
+		// The queue ran empty, decode the frame right away
+		if (!ready && decodeFrame())
+			_lateFrames++;
+	}
+
+	Common::StackLock lock(_queueMutex);
+
+	if (_readyCount == 0)
+		return 0;
+
+	// When the caller fell behind, skip the frames whose successor is
+	// already due as well
+	uint32 time = g_system->getMillis();
+	while (_readyCount > 1 && _frames[(_readPos + 1) % _frames.size()].displayTime <= time) {
+		takeFrame();
+		_droppedFrames++;
+	}
+
+	Frame &frame = takeFrame();
+	_curFrame = frame.number;
+
+	return frame.hasSurface ? &frame.surface : 0;
+}
+
+void DecodeAheadVideoDecoder::decodeAhead(uint32 msecs) {
+	const uint32 endTime = g_system->getMillis() + msecs;
+
+	for (;;) {
+		bool decoded = false;
+		{
+			Common::StackLock lock(_decoderMutex);
+
+			bool paused;
+			{
+				Common::StackLock queueLock(_queueMutex);
+				paused = _decodingPaused;
+			}
+
+			if (!paused)
+				decoded = decodeFrame();
+		}
+
+		const uint32 time = g_system->getMillis();
+		if ((int32)(endTime - time) <= 0)
+			break;
+
+		// Nothing left to decode for now
+		if (!decoded) {
+			g_system->delayMillis(endTime - time);
+			break;
+		}
+	}
+}
+
+DecodeAheadVideoDecoder::Frame &DecodeAheadVideoDecoder::takeFrame() {
+	assert(_readyCount > 0);
+
+	Frame &frame = _frames[_readPos];
+	_readPos = (_readPos + 1) % _frames.size();
+	_readyCount--;
+
+	// Keep palette changes of skipped frames
+	if (frame.dirtyPalette) {
+		memcpy(_palette, frame.palette, sizeof(_palette));
+		_dirtyPalette = true;
+	}
+
+	return frame;
+}
+
+bool DecodeAheadVideoDecoder::decodeFrame() {
+	// Find a free frame. The one in front of the ready frames is the one
+	// returned last, which the caller may still be using.
+	Frame *frame;
+	uint32 displayTime;
+
+	{
+		Common::StackLock lock(_queueMutex);
+
+		if (_decoderDone || _readyCount >= _frames.size() - 1)
+			return false;
+
+		frame = &_frames[(_readPos + _readyCount) % _frames.size()];
+		displayTime = _nextFrameTime;
+	}
+
+	// The frame isn't visible to the caller until it's ready, so it can be
+	// filled without holding the queue lock
+	const Graphics::Surface *surface = _decoder->decodeNextFrame();
+
+	frame->hasSurface = (surface != 0);
+	if (surface) {
+		if (frame->surface.w != surface->w || frame->surface.h != surface->h || frame->surface.format != surface->format) {
+			frame->surface.free();
+			frame->surface.create(surface->w, surface->h, surface->format);
+		}
+
+		for (int y = 0; y < surface->h; y++)
+			memcpy(frame->surface.getBasePtr(0, y), surface->getBasePtr(0, y), surface->w * surface->format.bytesPerPixel);
+	}
+
+	frame->dirtyPalette = _decoder->hasDirtyPalette();
+	if (frame->dirtyPalette)
+		memcpy(frame->palette, _decoder->getPalette(), sizeof(frame->palette));
+
+	frame->number = _decoder->getCurFrame();
+	frame->displayTime = displayTime;
+
+	bool done = _decoder->endOfVideo();
+	uint32 nextFrameTime = g_system->getMillis() + _decoder->getTimeToNextFrame();
+
+	Common::StackLock lock(_queueMutex);
+	_readyCount++;
+	_decoderDone = done;
+	_nextFrameTime = nextFrameTime;
+
+	return true;
+}
+
+void DecodeAheadVideoDecoder::flush() {
+	Common::StackLock lock(_queueMutex);
+
+	_readyCount = 0;
+	_decoderDone = _decoder->endOfVideo();
+	_nextFrameTime = g_system->getMillis() + _decoder->getTimeToNextFrame();
+	_curFrame = _decoder->getCurFrame();
+}
+
+void DecodeAheadVideoDecoder::seekToTime(Audio::Timestamp time) {
+	if (!_seekableDecoder) {
+		warning("DecodeAheadVideoDecoder::seekToTime(): The wrapped decoder can't seek");
+		return;
+	}
+
+	Common::StackLock lock(_decoderMutex);
+
+	_seekableDecoder->seekToTime(time);
+	flush();
+	resetPauseStartTime();
+}
+
+uint32 DecodeAheadVideoDecoder::getDuration() const {
+	return _seekableDecoder ? _seekableDecoder->getDuration() : 0;
+}
+
+void DecodeAheadVideoDecoder::pauseVideoIntern(bool pause) {
+	Common::StackLock lock(_decoderMutex);
+
+	_decoder->pauseVideo(pause);
+
+	Common::StackLock queueLock(_queueMutex);
+	_decodingPaused = pause;
+}
+
+void DecodeAheadVideoDecoder::addPauseTime(uint32 ms) {
+	VideoDecoder::addPauseTime(ms);
+
+	// The wrapped decoder's clock was shifted as well
+	Common::StackLock lock(_queueMutex);
+
+	for (uint i = 0; i < _readyCount; i++)
+		_frames[(_readPos + i) % _frames.size()].displayTime += ms;
+
+	_nextFrameTime += ms;
+}
+
+void DecodeAheadVideoDecoder::startDecodingAhead() {
+	if (_mode != kDecodeOnTimer)
+		return;
+
+	// The mutex is created and deleted on the main thread, while the timer
+	// isn't installed
+	if (!_activeDecodersMutex)
+		_activeDecodersMutex = new Common::Mutex();
+
+	bool first;
+	{
+		Common::StackLock lock(*_activeDecodersMutex);
+
+		if (!_activeDecoders)
+			_activeDecoders = new Common::Array<DecodeAheadVideoDecoder *>();
+
+		first = _activeDecoders->empty();
+		_activeDecoders->push_back(this);
+	}
+
+	if (first)
+		g_system->getTimerManager()->installTimerProc(&timerProc, kDecodeAheadInterval, 0, "videoDecodeAhead");
+}
+
+void DecodeAheadVideoDecoder::stopDecodingAhead() {
+	if (!_activeDecoders)
+		return;
+
+	bool last = false;
+	{
+		Common::StackLock lock(*_activeDecodersMutex);
+
+		for (uint i = 0; i < _activeDecoders->size(); i++) {
+			if ((*_activeDecoders)[i] == this) {
+				_activeDecoders->remove_at(i);
+				last = _activeDecoders->empty();
+				break;
+			}
+		}
+	}
+
+	// Removing the timer proc waits for a running callback to finish, and
+	// must not happen with the list locked, as the callback locks it too
+	if (last) {
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+
+		delete _activeDecoders;
+		_activeDecoders = 0;
+		delete _activeDecodersMutex;
+		_activeDecodersMutex = 0;
+	}
+}
+
+void DecodeAheadVideoDecoder::timerProc(void *refCon) {
+	Common::StackLock lock(*_activeDecodersMutex);
+
+	// Decode a single frame per tick, for the decoder whose next frame is
+	// due first, so that the time spent in the shared timer stays bounded
+	// however many videos are playing
+	DecodeAheadVideoDecoder *next = 0;
+	uint32 nextFrameTime = 0;
+
+	for (uint i = 0; i < _activeDecoders->size(); i++) {
+		DecodeAheadVideoDecoder *decoder = (*_activeDecoders)[i];
+		Common::StackLock queueLock(decoder->_queueMutex);
+
+		if (decoder->_mode != kDecodeOnTimer || decoder->_decodingPaused || decoder->_decoderDone || decoder->_readyCount >= decoder->_frames.size() - 1)
+			continue;
+
+		if (!next || decoder->_nextFrameTime < nextFrameTime) {
+			next = decoder;
+			nextFrameTime = decoder->_nextFrameTime;
+		}
+	}
+
+	if (!next)
+		return;
+
+	Common::StackLock decoderLock(next->_decoderMutex);
+
+	const uint32 startTime = g_system->getMicros();
+	next->decodeFrame();
+	const uint32 decodeTime = g_system->getMicros() - startTime;
+
+	// A frame this slow delays the other timer procs, so leave the next
+	// ones to decodeAhead() and decodeNextFrame()
+	if (decodeTime > kMaxTimerDecodeTime) {
+		debug(2, "DecodeAheadVideoDecoder: A frame took %d us to decode, no longer decoding on the timer", decodeTime);
+
+		Common::StackLock queueLock(next->_queueMutex);
+		next->_mode = kDecodeOnIdle;
+	}
+}
+
+} // End of namespace Video
@@ -0,0 +1,170 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef VIDEO_DECODE_AHEAD_H
+#define VIDEO_DECODE_AHEAD_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/types.h"
+
+#include "graphics/surface.h"
+
+#include "video/video_decoder.h"
+
+namespace Video {
+
+/**
+ * A wrapper around another VideoDecoder, which decodes frames ahead of
+ * time into a bounded queue of surfaces.
+ *
+ * The frames are decoded from a timer callback, so on backends which run
+ * their timers on a separate thread a slow frame no longer stalls the
+ * caller's game loop. Each frame is stored with the time at which it is
+ * due, taken from the wrapped decoder's getTimeToNextFrame() when it was
+ * decoded. When the caller falls behind, frames whose successor is
+ * already due are dropped, and when the queue runs empty the next frame
+ * is decoded synchronously, which counts as a late frame.
+ *
+ * A single frame is decoded per timer tick, for the wrapper whose next
+ * frame is due first, as the timer is shared by all the wrappers and
+ * with other users such as the music drivers. That only suits videos
+ * whose frames decode in a small part of the timer interval, so a wrapper
+ * stops decoding on the timer after a frame took too long. Videos known to
+ * be slow to decode use kDecodeOnIdle instead, and are decoded ahead in
+ * decodeAhead(), which the caller's loop calls instead of sleeping.
+ *
+ * Once handed to the wrapper, the wrapped decoder must not be used
+ * directly anymore.
+ */
+class DecodeAheadVideoDecoder : public SeekableVideoDecoder {
+public:
+	enum DecodeMode {
+		kDecodeOnTimer, ///< Decode on the shared timer, and in decodeAhead().
+		kDecodeOnIdle   ///< Decode only in decodeAhead().
+	};
+
+	/**
+	 * Wrap a decoder which can't seek. Seeking the wrapper does nothing
+	 * then.
+	 */
+	DecodeAheadVideoDecoder(VideoDecoder *decoder, uint queueSize = 4, DecodeMode mode = kDecodeOnTimer, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+	DecodeAheadVideoDecoder(SeekableVideoDecoder *decoder, uint queueSize = 4, DecodeMode mode = kDecodeOnTimer, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+	~DecodeAheadVideoDecoder();
+
+	/**
+	 * Decode frames ahead for about the given number of milliseconds, and
+	 * sleep for the rest of that time once the queue is full. This is
+	 * meant to be called from the caller's loop instead of
+	 * OSystem::delayMillis().
+	 */
+	void decodeAhead(uint32 msecs);
+
+	// VideoDecoder API
+	bool loadStream(Common::SeekableReadStream *stream);
+	void close();
+	bool isVideoLoaded() const;
+	uint16 getWidth() const;
+	uint16 getHeight() const;
+	Graphics::PixelFormat getPixelFormat() const;
+	const byte *getPalette();
+	bool hasDirtyPalette() const;
+	uint32 getFrameCount() const;
+	uint32 getElapsedTime() const;
+	uint32 getTimeToNextFrame() const;
+	const Graphics::Surface *decodeNextFrame();
+	bool endOfVideo() const;
+
+	// SeekableVideoDecoder API
+	void seekToTime(Audio::Timestamp time);
+	uint32 getDuration() const;
+
+	/** Return the number of frames skipped because the caller fell behind. */
+	uint32 getDroppedFrames() const { return _droppedFrames; }
+
+	/** Return the number of frames that weren't decoded ahead in time. */
+	uint32 getLateFrames() const { return _lateFrames; }
+
+protected:
+	void pauseVideoIntern(bool pause);
+	void addPauseTime(uint32 ms);
+
+private:
+	struct Frame {
+		Graphics::Surface surface;
+		bool hasSurface;        ///< Did the decoder return a surface for this frame?
+		byte palette[256 * 3];
+		bool dirtyPalette;      ///< Did the palette change with this frame?
+		int32 number;
+		uint32 displayTime;     ///< When the frame is due, in OSystem::getMillis() time.
+	};
+
+	VideoDecoder *_decoder;
+	SeekableVideoDecoder *_seekableDecoder;
+	DisposeAfterUse::Flag _disposeAfterUse;
+
+	/**
+	 * The frames. _readyCount frames starting at _readPos are waiting to be
+	 * shown, and the one in front of them was returned last.
+	 */
+	Common::Array<Frame> _frames;
+	uint _readPos;
+	uint _readyCount;
+
+	byte _palette[256 * 3];  ///< The palette of the frames returned so far.
+	bool _dirtyPalette;
+
+	bool _decoderDone;      ///< Has the wrapped decoder decoded its last frame?
+	bool _decodingPaused;   ///< Is the video paused?
+	DecodeMode _mode;       ///< Where the frames are decoded ahead.
+	uint32 _nextFrameTime;  ///< When the next frame to be decoded is due.
+
+	uint32 _droppedFrames;
+	uint32 _lateFrames;
+
+	// Lock _decoderMutex before _queueMutex when both are needed
+	Common::Mutex _decoderMutex; ///< Guards _decoder.
+	Common::Mutex _queueMutex;   ///< Guards the frame queue and the decoding state.
+
+	void init(uint queueSize, DecodeMode mode);
+	void freeFrames();
+
+	/** Take the next ready frame. Needs _queueMutex to be locked. */
+	Frame &takeFrame();
+
+	/** Decode the next frame into the queue. Needs _decoderMutex to be locked. */
+	bool decodeFrame();
+	/** Restart decoding ahead from the wrapped decoder's current position. */
+	void flush();
+
+	void startDecodingAhead();
+	void stopDecodingAhead();
+
+	/** The decoders with a loaded video, which all share one timer. */
+	static Common::Array<DecodeAheadVideoDecoder *> *_activeDecoders;
+	static Common::Mutex *_activeDecodersMutex;
+	static void timerProc(void *refCon);
+};
+
+} // End of namespace Video
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "common/debug.h"
 #include "common/endian.h"
+#include "common/profiler.h"
 #include "common/system.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
@@ -476,6 +477,8 @@ void DXADecoder::decode13(int size) {
 }
 
 const Graphics::Surface *DXADecoder::decodeNextFrame() {
+	PROFILE_ZONE("DXA decodeNextFrame");
+
 	uint32 tag = _fileStream->readUint32BE();
 	if (tag == MKTAG('C','M','A','P')) {
 		_fileStream->read(_palette, 256 * 3);
@@ -23,6 +23,7 @@
 #include "video/flic_decoder.h"
 #include "common/endian.h"
 #include "common/rect.h"
+#include "common/profiler.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -193,6 +194,8 @@ void FlicDecoder::decodeDeltaFLC(uint8 *data) {
 #define FRAME_TYPE 0xF1FA
 
 const Graphics::Surface *FlicDecoder::decodeNextFrame() {
+	PROFILE_ZONE("FLIC decodeNextFrame");
+
 	// Read chunk
 	uint32 frameSize = _fileStream->readUint32LE();
 	uint16 frameType = _fileStream->readUint16LE();
@@ -3,6 +3,7 @@ MODULE := video
 MODULE_OBJS := \
 	avi_decoder.o \
 	coktel_decoder.o \
+	decode_ahead.o \
 	dxa_decoder.o \
 	flic_decoder.o \
 	psx_decoder.o \
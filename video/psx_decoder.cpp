@@ -28,7 +28,7 @@
 #include "audio/decoders/raw.h"
 #include "common/bitstream.h"
 #include "common/huffman.h"
-#include "common/memstream.h"
+#include "common/profiler.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -262,6 +262,8 @@ uint32 PSXStreamDecoder::getTimeToNextFrame() const {
 #define VIDEO_DATA_HEADER_SIZE  56
 
 const Graphics::Surface *PSXStreamDecoder::decodeNextFrame() {
+	PROFILE_ZONE("PSX decodeNextFrame");
+
 	Common::SeekableReadStream *sector = 0;
 	byte *partialFrame = 0;
 	int sectorsRead = 0;
@@ -301,11 +303,9 @@ const Graphics::Surface *PSXStreamDecoder::decodeNextFrame() {
 
 				if (curSector == sectorCount - 1) {
 					// Done assembling the frame
-					Common::SeekableReadStream *frame = new Common::MemoryReadStream(partialFrame, frameSize, DisposeAfterUse::YES);
+					decodeFrame(partialFrame, frameSize);
 
-					decodeFrame(frame);
-					
-					delete frame;
+					free(partialFrame);
 					delete sector;
 
 					_curFrame++;
@@ -472,10 +472,10 @@ void PSXStreamDecoder::queueAudioFromSector(Common::SeekableReadStream *sector)
 	delete[] buf;
 }
 
-void PSXStreamDecoder::decodeFrame(Common::SeekableReadStream *frame) {
+void PSXStreamDecoder::decodeFrame(const byte *frame, uint32 size) {
 	// A frame is essentially an MPEG-1 intra frame
 
-	Common::BitStream16LEMSB bits(frame);
+	BitStream bits(frame, size);
 
 	bits.skip(16); // unknown
 	bits.skip(16); // 0x3800
@@ -496,7 +496,7 @@ void PSXStreamDecoder::decodeFrame(Common::SeekableReadStream *frame) {
 	Graphics::convertYUV420ToRGB(_surface, _yBuffer, _cbBuffer, _crBuffer, _surface->w, _surface->h, _macroBlocksW * 16, _macroBlocksW * 8);
 }
 
-void PSXStreamDecoder::decodeMacroBlock(Common::BitStream *bits, int mbX, int mbY, uint16 scale, uint16 version) {
+void PSXStreamDecoder::decodeMacroBlock(BitStream *bits, int mbX, int mbY, uint16 scale, uint16 version) {
 	int pitchY = _macroBlocksW * 16;
 	int pitchC = _macroBlocksW * 8;
 
@@ -543,7 +543,7 @@ void PSXStreamDecoder::dequantizeBlock(int *coefficients, float *block, uint16 s
 	}
 }
 
-int PSXStreamDecoder::readDC(Common::BitStream *bits, uint16 version, PlaneType plane) {
+int PSXStreamDecoder::readDC(BitStream *bits, uint16 version, PlaneType plane) {
 	// Version 2 just has its coefficient as 10-bits
 	if (version == 2)
 		return readSignedCoefficient(bits);
@@ -573,7 +573,7 @@ int PSXStreamDecoder::readDC(Common::BitStream *bits, uint16 version, PlaneType
 	if (count > 63) \
 		error("PSXStreamDecoder::readAC(): Too many coefficients")
 
-void PSXStreamDecoder::readAC(Common::BitStream *bits, int *block) {
+void PSXStreamDecoder::readAC(BitStream *bits, int *block) {
 	// Clear the block first
 	for (int i = 0; i < 63; i++)
 		block[i] = 0;
@@ -608,7 +608,7 @@ void PSXStreamDecoder::readAC(Common::BitStream *bits, int *block) {
 	}
 }
 
-int PSXStreamDecoder::readSignedCoefficient(Common::BitStream *bits) {
+int PSXStreamDecoder::readSignedCoefficient(BitStream *bits) {
 	uint val = bits->getBits(10);
 
 	// extend the sign
@@ -669,7 +669,7 @@ void PSXStreamDecoder::idct(float *dequantData, float *result) {
 	}
 }
 
-void PSXStreamDecoder::decodeBlock(Common::BitStream *bits, byte *block, int pitch, uint16 scale, uint16 version, PlaneType plane) {
+void PSXStreamDecoder::decodeBlock(BitStream *bits, byte *block, int pitch, uint16 scale, uint16 version, PlaneType plane) {
 	// Version 2 just has signed 10 bits for DC
 	// Version 3 has them huffman coded
 	int coefficients[8 * 8];
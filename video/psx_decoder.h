@@ -23,6 +23,7 @@
 #ifndef VIDEO_PSX_DECODER_H
 #define VIDEO_PSX_DECODER_H
 
+#include "common/bitstream.h"
 #include "common/endian.h"
 #include "common/rational.h"
 #include "common/rect.h"
@@ -35,7 +36,6 @@ class QueuingAudioStream;
 }
 
 namespace Common {
-class BitStream;
 class Huffman;
 class SeekableReadStream;
 }
@@ -99,22 +99,25 @@ private:
 		kPlaneV = 2
 	};
 
+	/** Frames are read from memory as 16-bit LE values, from MSB to LSB. */
+	typedef Common::BitStreamMemory16LEMSB BitStream;
+
 	uint16 _macroBlocksW, _macroBlocksH;
 	byte *_yBuffer, *_cbBuffer, *_crBuffer;
-	void decodeFrame(Common::SeekableReadStream *frame);
-	void decodeMacroBlock(Common::BitStream *bits, int mbX, int mbY, uint16 scale, uint16 version);
-	void decodeBlock(Common::BitStream *bits, byte *block, int pitch, uint16 scale, uint16 version, PlaneType plane);
+	void decodeFrame(const byte *frame, uint32 size);
+	void decodeMacroBlock(BitStream *bits, int mbX, int mbY, uint16 scale, uint16 version);
+	void decodeBlock(BitStream *bits, byte *block, int pitch, uint16 scale, uint16 version, PlaneType plane);
 
-	void readAC(Common::BitStream *bits, int *block);
+	void readAC(BitStream *bits, int *block);
 	Common::Huffman *_acHuffman;
 
-	int readDC(Common::BitStream *bits, uint16 version, PlaneType plane);
+	int readDC(BitStream *bits, uint16 version, PlaneType plane);
 	Common::Huffman *_dcHuffmanLuma, *_dcHuffmanChroma;
 	int _lastDC[3];
 
 	void dequantizeBlock(int *coefficients, float *block, uint16 scale);
 	void idct(float *dequantData, float *result);
-	int readSignedCoefficient(Common::BitStream *bits);
+	int readSignedCoefficient(BitStream *bits);
 
 	struct ADPCMStatus {
 		int16 sample[2];
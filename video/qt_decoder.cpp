@@ -35,6 +35,7 @@
 #include "common/debug.h"
 #include "common/endian.h"
 #include "common/memstream.h"
+#include "common/profiler.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
@@ -135,6 +136,8 @@ QuickTimeDecoder::VideoTrackHandler *QuickTimeDecoder::findNextVideoTrack() cons
 }
 
 const Graphics::Surface *QuickTimeDecoder::decodeNextFrame() {
+	PROFILE_ZONE("QuickTime decodeNextFrame");
+
 	if (!_nextVideoTrack)
 		return 0;
 
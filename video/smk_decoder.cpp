@@ -29,8 +29,8 @@
 #include "common/endian.h"
 #include "common/util.h"
 #include "common/stream.h"
-#include "common/memstream.h"
 #include "common/bitstream.h"
+#include "common/profiler.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -47,6 +47,9 @@ enum SmkBlockTypes {
 	SMK_BLOCK_FILL = 3
 };
 
+/** All Smacker data is read as 8-bit values, from LSB to MSB. */
+typedef Common::BitStreamMemory8LSB SmackerBitStream;
+
 /*
  * class SmallHuffmanTree
  * A Huffman-tree to hold 8-bit values.
@@ -54,9 +57,9 @@ enum SmkBlockTypes {
 
 class SmallHuffmanTree {
 public:
-	SmallHuffmanTree(Common::BitStream &bs);
+	SmallHuffmanTree(SmackerBitStream &bs);
 
-	uint16 getCode(Common::BitStream &bs);
+	uint16 getCode(SmackerBitStream &bs);
 private:
 	enum {
 		SMK_NODE = 0x8000
@@ -70,10 +73,10 @@ private:
 	uint16 _prefixtree[256];
 	byte _prefixlength[256];
 
-	Common::BitStream &_bs;
+	SmackerBitStream &_bs;
 };
 
-SmallHuffmanTree::SmallHuffmanTree(Common::BitStream &bs)
+SmallHuffmanTree::SmallHuffmanTree(SmackerBitStream &bs)
 	: _treeSize(0), _bs(bs) {
 	uint32 bit = _bs.getBit();
 	assert(bit);
@@ -118,7 +121,7 @@ uint16 SmallHuffmanTree::decodeTree(uint32 prefix, int length) {
 	return r1+r2+1;
 }
 
-uint16 SmallHuffmanTree::getCode(Common::BitStream &bs) {
+uint16 SmallHuffmanTree::getCode(SmackerBitStream &bs) {
 	byte peek = bs.peekBits(8);
 	uint16 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
@@ -139,11 +142,11 @@ uint16 SmallHuffmanTree::getCode(Common::BitStream &bs) {
 
 class BigHuffmanTree {
 public:
-	BigHuffmanTree(Common::BitStream &bs, int allocSize);
+	BigHuffmanTree(SmackerBitStream &bs, int allocSize);
 	~BigHuffmanTree();
 
 	void reset();
-	uint32 getCode(Common::BitStream &bs);
+	uint32 getCode(SmackerBitStream &bs);
 private:
 	enum {
 		SMK_NODE = 0x80000000
@@ -159,13 +162,13 @@ private:
 	byte _prefixlength[256];
 
 	/* Used during construction */
-	Common::BitStream &_bs;
+	SmackerBitStream &_bs;
 	uint32 _markers[3];
 	SmallHuffmanTree *_loBytes;
 	SmallHuffmanTree *_hiBytes;
 };
 
-BigHuffmanTree::BigHuffmanTree(Common::BitStream &bs, int allocSize)
+BigHuffmanTree::BigHuffmanTree(SmackerBitStream &bs, int allocSize)
 	: _bs(bs) {
 	uint32 bit = _bs.getBit();
 	if (!bit) {
@@ -257,7 +260,7 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 	return r1+r2+1;
 }
 
-uint32 BigHuffmanTree::getCode(Common::BitStream &bs) {
+uint32 BigHuffmanTree::getCode(SmackerBitStream &bs) {
 	byte peek = bs.peekBits(8);
 	uint32 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
@@ -391,13 +394,15 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 	byte *huffmanTrees = (byte *) malloc(_header.treesSize);
 	_fileStream->read(huffmanTrees, _header.treesSize);
 
-	Common::BitStream8LSB bs(new Common::MemoryReadStream(huffmanTrees, _header.treesSize, DisposeAfterUse::YES), true);
+	SmackerBitStream bs(huffmanTrees, _header.treesSize);
 
 	_MMapTree = new BigHuffmanTree(bs, _header.mMapSize);
 	_MClrTree = new BigHuffmanTree(bs, _header.mClrSize);
 	_FullTree = new BigHuffmanTree(bs, _header.fullSize);
 	_TypeTree = new BigHuffmanTree(bs, _header.typeSize);
 
+	free(huffmanTrees);
+
 	_surface = new Graphics::Surface();
 
 	// Height needs to be doubled if we have flags (Y-interlaced or Y-doubled)
@@ -441,6 +446,8 @@ void SmackerDecoder::close() {
 }
 
 const Graphics::Surface *SmackerDecoder::decodeNextFrame() {
+	PROFILE_ZONE("Smacker decodeNextFrame");
+
 	uint i;
 	uint32 chunkSize = 0;
 	uint32 dataSizeUnpacked = 0;
@@ -489,7 +496,7 @@ const Graphics::Surface *SmackerDecoder::decodeNextFrame() {
 
 	_fileStream->read(_frameData, frameDataSize);
 
-	Common::BitStream8LSB bs(new Common::MemoryReadStream(_frameData, frameDataSize + 1, DisposeAfterUse::YES), true);
+	SmackerBitStream bs(_frameData, frameDataSize + 1);
 
 	_MMapTree->reset();
 	_MClrTree->reset();
@@ -629,6 +636,9 @@ const Graphics::Surface *SmackerDecoder::decodeNextFrame() {
 		}
 	}
 
+	free(_frameData);
+	_frameData = 0;
+
 	_fileStream->seek(startPos + frameSize);
 
 	if (_curFrame == 0)
@@ -682,7 +692,7 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 void SmackerDecoder::queueCompressedBuffer(byte *buffer, uint32 bufferSize,
 		uint32 unpackedSize, int streamNum) {
 
-	Common::BitStream8LSB audioBS(new Common::MemoryReadStream(buffer, bufferSize), true);
+	SmackerBitStream audioBS(buffer, bufferSize);
 	bool dataPresent = audioBS.getBit();
 
 	if (!dataPresent)